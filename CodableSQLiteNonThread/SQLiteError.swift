@@ -30,6 +30,7 @@ import SQLite3
 public enum SQLiteError: Error {
 
     case backupFailed
+    case columnNotFound(String)
     case dataNotFound
     case decodeFailure
     case failedToOpen
@@ -44,6 +45,9 @@ public enum SQLiteError: Error {
 
     var localizedDescription: String {
         switch self {
+        case let .columnNotFound(name):
+            "Column not found: \(name)"
+
         case .dataNotFound:
             "Data not found"
 
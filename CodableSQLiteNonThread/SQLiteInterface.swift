@@ -36,13 +36,26 @@ let SQLITE_TRANSIENT = unsafeBitCast(-1, to: sqlite3_destructor_type.self)
 /// The Codeable (Non-threaded) interface for Sqlite
 public struct SQLiteInterface {
     private let columnProcessor = SQLiteColumnProcessor()
-    /// Simple init
-    public init() {}
+    private let statementCache: SQLiteStatementCache?
+
+    /// Create an interface
+    /// - Parameters:
+    /// - statementCache: Cache for the statements prepared by the query functions. Pass nil to prepare
+    ///   and finalize a statement on every call.
+    public init(statementCache: SQLiteStatementCache? = .shared) {
+        self.statementCache = statementCache
+    }
+
+    /// Hit and miss counters for the statement cache, or nil when caching is disabled
+    public var statementCacheStatistics: SQLiteStatementCache.Statistics? {
+        statementCache?.statistics
+    }
 
     /// document the createInMemoryStore function
     /// Create an in memory store
     /// When using an in-memory store, the user must hold on to the pointer to the store.
     /// Allowing the pointer to go nil may delete he store and could lead to a memory leak
+    /// The connection is serialized, so a statement may be run on it from another thread.
     /// - Parameters:
     /// - Identifier: Specify an identifier for the store. One will be set automatically if not specified
     /// - Returns:OpaquePointer, the pointer to the SQLite in-memory store
@@ -52,7 +65,7 @@ public struct SQLiteInterface {
         try SQLiteError.checkSqliteStatus(sqlite3_open_v2(
             identifier,
             &sqliteStore,
-            SQLITE_OPEN_MEMORY | SQLITE_OPEN_READWRITE,
+            SQLITE_OPEN_MEMORY | SQLITE_OPEN_READWRITE | SQLITE_OPEN_FULLMUTEX,
             nil
         ))
         guard let store = sqliteStore else {
@@ -81,6 +94,25 @@ public struct SQLiteInterface {
         return store
     }
 
+    /// Open an existing sqlite database on disk for reading only
+    ///
+    /// Each connection may be used from its own thread, so several can read one file at once.
+    /// - Parameters:
+    /// - Path: String representing the file location on disk
+    ///
+    /// - Returns: Pointer representing the sqlite file
+    /// - Throws: SQLite error if the file cannot be opened
+    public func openReadOnlyDatabase(path: String) throws -> OpaquePointer {
+        var sqliteStore: OpaquePointer?
+        let status = sqlite3_open_v2(path, &sqliteStore, SQLITE_OPEN_READONLY, nil)
+        guard status == SQLITE_OK, let store = sqliteStore else {
+            sqlite3_close(sqliteStore)
+            try SQLiteError.checkSqliteStatus(status)
+            throw SQLiteError.unknownSqliteError("Failed to open database at \(path)")
+        }
+        return store
+    }
+
     /// Copies SQLite contents from inmemory to disk or vice versa
     ///
     /// - Parameters:
@@ -110,9 +142,18 @@ public struct SQLiteInterface {
     /// - store: The SQLite OpagePointer to a file or in-memory store
     /// - throws:on failure, throws  with a SQLiteError
     public func close(store: OpaquePointer) throws {
+        statementCache?.remove(sqlite: store)
         try SQLiteError.checkSqliteStatus(sqlite3_close(store))
     }
 
+    /// Drops the cached statements for a database.
+    /// Call after changing the schema, such as renaming, dropping or altering a table.
+    /// - Parameters:
+    /// - sqlite: The SQLite OpagePointer to a file or in-memory store
+    public func invalidateStatements(sqlite: OpaquePointer) {
+        statementCache?.invalidate(sqlite: sqlite)
+    }
+
     /// Executes a query on a database with the expectation of returning items of type T
     /// - Parameters:
     /// - sqlite: The SQLite OpagePointer to a file or in-memory store
@@ -121,8 +162,14 @@ public struct SQLiteInterface {
     /// - throws:on failure, throws  with a SQLiteError
     public func executeCodableQuery<T: Codable>(sqlite: OpaquePointer, query: QueryProtocol) throws -> [T] {
         do {
-            let result = try executeDataQuery(sqlite: sqlite, query: query)
-            return try JSONDecoder().decode([T].self, from: result)
+            return try withStatement(sqlite: sqlite, query: query) { statement in
+                let decoder = SQLiteRowDecoder(statement: statement)
+                var rows = [T]()
+                try forEachRow(sqlite: sqlite, statement: statement, query: query) {
+                    try rows.append(T(from: decoder))
+                }
+                return rows
+            }
         } catch {
             if #available(macOS 11.0, *) {
                 Logger.codableLog.debug("\(error.localizedDescription, privacy: .private)")
@@ -150,23 +197,85 @@ public struct SQLiteInterface {
     /// - throws:on failure, throws  with a SQLiteError
     @discardableResult
     public func executeQuery(sqlite: OpaquePointer, query: QueryProtocol) throws -> [[String: Codable]] {
-        let statement = try buildStatement(sqlite: sqlite, query: query)
+        try withStatement(sqlite: sqlite, query: query) { statement in
+            var rowData = [[String: Codable]]()
+            try forEachRow(sqlite: sqlite, statement: statement, query: query) {
+                rowData.append(processRow(theStmt: statement))
+            }
+            return rowData
+        }
+    }
 
-        var rowData = [[String: Codable]]()
+    /// Reads one numeric column of a query result into a contiguous array
+    ///
+    /// Values are read with `sqlite3_column_double` as each row is stepped, so no row records are built.
+    /// Text values are parsed as numbers. NULL, blob and unparsable values are skipped.
+    /// - Parameters:
+    /// - column: Name of the result column to read
+    /// - type: The floating point type to return
+    /// - sqlite: The SQLite OpagePointer to a file or in-memory store
+    /// - query: The QueryProtocol for the query to execute
+    /// - returns: The column values in row order
+    /// - throws: SQLiteError.columnNotFound if the query does not return the column, otherwise a SQLiteError
+    public func readColumn<T: BinaryFloatingPoint & LosslessStringConvertible>(
+        _ column: String,
+        as type: T.Type,
+        sqlite: OpaquePointer,
+        query: QueryProtocol
+    ) throws -> [T] {
+        try withStatement(sqlite: sqlite, query: query) { statement in
+            guard let index = SQLiteRowDecoder(statement: statement).columnIndices[column] else {
+                throw SQLiteError.columnNotFound(column)
+            }
 
-        let subqueries = query.subqueries()
+            var values = [T]()
+            try forEachRow(sqlite: sqlite, statement: statement, query: query) {
+                switch sqlite3_column_type(statement, index) {
+                case SQLITE_INTEGER, SQLITE_FLOAT:
+                    values.append(T(sqlite3_column_double(statement, index)))
 
-        for subquery in subqueries {
-            sqlite3_reset(statement)
-            try bind(bindings: subquery.bindables, statement: statement)
-            while sqlite3_step(statement) == SQLITE_ROW {
-                rowData.append(processRow(theStmt: statement))
+                case SQLITE_TEXT:
+                    if let text = sqlite3_column_text(statement, index), let value = T(String(cString: text)) {
+                        values.append(value)
+                    }
+
+                default:
+                    break
+                }
             }
-            try SQLiteError.checkSqliteStatus(sqlite3_errcode(sqlite))
+            return values
         }
+    }
 
-        sqlite3_finalize(statement)
-        return rowData
+    /// Execute one statement per row supplied by nextRow, reusing a single prepared statement
+    ///
+    /// Rows are pulled on demand, so callers can stream input of any size without holding it in memory.
+    /// - Parameters:
+    /// - sqlite: The SQLite OpagePointer to a file or in-memory store
+    /// - sql: The SQL to execute for each row
+    /// - nextRow: Returns the bindings for the next row, or nil when there are no more rows
+    /// - returns: The number of rows executed
+    /// - throws: A SQLiteError, or any error thrown by nextRow
+    @discardableResult
+    public func executeEach(
+        sqlite: OpaquePointer,
+        sql: String,
+        nextRow: () throws -> [Bindable?]?
+    ) throws -> Int {
+        try withStatement(sqlite: sqlite, query: Query(sql: sql)) { statement in
+            var count = 0
+            while let bindings = try nextRow() {
+                sqlite3_reset(statement)
+                sqlite3_clear_bindings(statement)
+                try bind(bindings: bindings, statement: statement)
+                let result = sqlite3_step(statement)
+                guard result == SQLITE_DONE else {
+                    throw SQLiteError.sqliteError(result: result, message: String(cString: sqlite3_errmsg(sqlite)))
+                }
+                count += 1
+            }
+            return count
+        }
     }
 
     /// Create a statement for a database using a query
@@ -217,6 +326,19 @@ public struct SQLiteInterface {
         return columns
     }
 
+    /// Number of database pages the connection has written to disk since the counter was last reset.
+    /// Includes pages of attached databases.
+    /// - Parameters:
+    /// - sqlite: The SQLite OpagePointer to a file or in-memory store
+    /// - reset: Reset the counter after reading it
+    /// - returns: The page count. Multiply by the page size for bytes.
+    public func pagesWritten(sqlite: OpaquePointer, reset: Bool = false) -> Int {
+        var current: Int32 = 0
+        var highwater: Int32 = 0
+        sqlite3_db_status(sqlite, SQLITE_DBSTATUS_CACHE_WRITE, &current, &highwater, reset ? 1 : 0)
+        return Int(current)
+    }
+
     // MARK: Private API
 
     private func bind(bindings: [Bindable?], statement: OpaquePointer) throws {
@@ -228,6 +350,45 @@ public struct SQLiteInterface {
         }
     }
 
+    /// Runs body with a prepared statement for the query, from the statement cache when one is set
+    private func withStatement<R>(
+        sqlite: OpaquePointer,
+        query: QueryProtocol,
+        _ body: (OpaquePointer) throws -> R
+    ) throws -> R {
+        guard let statementCache else {
+            let statement = try buildStatement(sqlite: sqlite, query: query)
+            defer {
+                sqlite3_finalize(statement)
+            }
+            return try body(statement)
+        }
+        let lease = try statementCache.checkout(sqlite: sqlite, sql: query.sql)
+        defer {
+            statementCache.checkin(lease)
+        }
+        return try body(lease.statement)
+    }
+
+    /// Binds and steps each subquery, calling body once per returned row
+    private func forEachRow(
+        sqlite: OpaquePointer,
+        statement: OpaquePointer,
+        query: QueryProtocol,
+        _ body: () throws -> Void
+    ) throws {
+        for subquery in query.subqueries() {
+            sqlite3_reset(statement)
+            // nil bindings are skipped, so clear the previous row's values first
+            sqlite3_clear_bindings(statement)
+            try bind(bindings: subquery.bindables, statement: statement)
+            while sqlite3_step(statement) == SQLITE_ROW {
+                try body()
+            }
+            try SQLiteError.checkSqliteStatus(sqlite3_errcode(sqlite))
+        }
+    }
+
     @discardableResult
     private func processRow(theStmt: OpaquePointer) -> [String: Codable] {
         var aRecord = [String: Codable]()
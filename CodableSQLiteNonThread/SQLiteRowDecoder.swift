@@ -0,0 +1,348 @@
+//
+// SQLiteRowDecoder.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import Foundation
+import SQLite3
+
+/// A `Decoder` over the current row of a prepared statement.
+///
+/// Values are read straight from `sqlite3_column_*`, without building a row dictionary
+/// or round-tripping through JSON. Column names are resolved once per statement, so one
+/// decoder can be reused for every row returned by `sqlite3_step`.
+struct SQLiteRowDecoder: Decoder {
+    let statement: OpaquePointer
+    let columnIndices: [String: Int32]
+    let codingPath: [any CodingKey] = []
+    let userInfo: [CodingUserInfoKey: Any] = [:]
+
+    init(statement: OpaquePointer) {
+        self.statement = statement
+        var indices = [String: Int32]()
+        for column in 0 ..< sqlite3_column_count(statement) {
+            if let name = sqlite3_column_name(statement, column) {
+                // Matches processRow: with duplicate names the last column wins
+                indices[String(cString: name)] = column
+            }
+        }
+        columnIndices = indices
+    }
+
+    func container<Key: CodingKey>(keyedBy _: Key.Type) throws -> KeyedDecodingContainer<Key> {
+        KeyedDecodingContainer(SQLiteRowKeyedContainer<Key>(decoder: self))
+    }
+
+    func unkeyedContainer() throws -> any UnkeyedDecodingContainer {
+        throw DecodingError.typeMismatch(
+            [Any].self,
+            DecodingError.Context(codingPath: codingPath, debugDescription: "A SQLite row cannot be decoded as an array")
+        )
+    }
+
+    /// Single column results, such as `SELECT COUNT(*)`, may be decoded as a single value
+    func singleValueContainer() throws -> any SingleValueDecodingContainer {
+        guard sqlite3_column_count(statement) == 1 else {
+            throw DecodingError.typeMismatch(
+                Any.self,
+                DecodingError.Context(
+                    codingPath: codingPath,
+                    debugDescription: "Only single column rows can be decoded as a single value"
+                )
+            )
+        }
+        return SQLiteColumnValueContainer(statement: statement, index: 0, codingPath: codingPath)
+    }
+}
+
+// MARK: - Keyed Container
+
+private struct SQLiteRowKeyedContainer<Key: CodingKey>: KeyedDecodingContainerProtocol {
+    let decoder: SQLiteRowDecoder
+
+    var codingPath: [any CodingKey] { decoder.codingPath }
+
+    var allKeys: [Key] {
+        decoder.columnIndices.keys.compactMap { Key(stringValue: $0) }
+    }
+
+    func contains(_ key: Key) -> Bool {
+        decoder.columnIndices[key.stringValue] != nil
+    }
+
+    func decodeNil(forKey key: Key) throws -> Bool {
+        try column(for: key).decodeNil()
+    }
+
+    func decode(_ type: Bool.Type, forKey key: Key) throws -> Bool { try column(for: key).decode(type) }
+    func decode(_ type: String.Type, forKey key: Key) throws -> String { try column(for: key).decode(type) }
+    func decode(_ type: Double.Type, forKey key: Key) throws -> Double { try column(for: key).decode(type) }
+    func decode(_ type: Float.Type, forKey key: Key) throws -> Float { try column(for: key).decode(type) }
+    func decode(_ type: Int.Type, forKey key: Key) throws -> Int { try column(for: key).decode(type) }
+    func decode(_ type: Int8.Type, forKey key: Key) throws -> Int8 { try column(for: key).decode(type) }
+    func decode(_ type: Int16.Type, forKey key: Key) throws -> Int16 { try column(for: key).decode(type) }
+    func decode(_ type: Int32.Type, forKey key: Key) throws -> Int32 { try column(for: key).decode(type) }
+    func decode(_ type: Int64.Type, forKey key: Key) throws -> Int64 { try column(for: key).decode(type) }
+    func decode(_ type: UInt.Type, forKey key: Key) throws -> UInt { try column(for: key).decode(type) }
+    func decode(_ type: UInt8.Type, forKey key: Key) throws -> UInt8 { try column(for: key).decode(type) }
+    func decode(_ type: UInt16.Type, forKey key: Key) throws -> UInt16 { try column(for: key).decode(type) }
+    func decode(_ type: UInt32.Type, forKey key: Key) throws -> UInt32 { try column(for: key).decode(type) }
+    func decode(_ type: UInt64.Type, forKey key: Key) throws -> UInt64 { try column(for: key).decode(type) }
+
+    func decode<T: Decodable>(_ type: T.Type, forKey key: Key) throws -> T {
+        try column(for: key).decode(type)
+    }
+
+    func nestedContainer<NestedKey: CodingKey>(
+        keyedBy _: NestedKey.Type,
+        forKey key: Key
+    ) throws -> KeyedDecodingContainer<NestedKey> {
+        throw DecodingError.typeMismatch(
+            [String: Any].self,
+            DecodingError.Context(codingPath: codingPath + [key], debugDescription: "SQLite columns cannot be nested")
+        )
+    }
+
+    func nestedUnkeyedContainer(forKey key: Key) throws -> any UnkeyedDecodingContainer {
+        throw DecodingError.typeMismatch(
+            [Any].self,
+            DecodingError.Context(codingPath: codingPath + [key], debugDescription: "SQLite columns cannot be nested")
+        )
+    }
+
+    func superDecoder() throws -> any Decoder {
+        decoder
+    }
+
+    func superDecoder(forKey key: Key) throws -> any Decoder {
+        try column(for: key)
+    }
+
+    private func column(for key: Key) throws -> SQLiteColumnValueContainer {
+        guard let index = decoder.columnIndices[key.stringValue] else {
+            throw DecodingError.keyNotFound(
+                key,
+                DecodingError.Context(codingPath: codingPath, debugDescription: "No column named \(key.stringValue)")
+            )
+        }
+        return SQLiteColumnValueContainer(statement: decoder.statement, index: index, codingPath: codingPath + [key])
+    }
+}
+
+// MARK: - Column Value
+
+/// Decodes a single column of the current row.
+///
+/// Conversions follow what the JSON path accepted: numbers decode from INTEGER or REAL
+/// storage, blobs decode as `Data` (or as base64 text), and booleans use the same rules
+/// as `SQLiteBoolColumn`: NULL and blobs are `false`, and a NULL in a column declared
+/// BOOL, BOOLEAN or BIT is `false` rather than nil. Text holding a number is also accepted
+/// for numeric types.
+private struct SQLiteColumnValueContainer: SingleValueDecodingContainer, Decoder {
+    let statement: OpaquePointer
+    let index: Int32
+    let codingPath: [any CodingKey]
+
+    var userInfo: [CodingUserInfoKey: Any] { [:] }
+
+    private var storageType: Int32 {
+        sqlite3_column_type(statement, index)
+    }
+
+    /// Declared types that the JSON path always read through `SQLiteBoolColumn`
+    private static let booleanDeclaredTypes: Set<String> = ["bool", "boolean", "bit"]
+
+    private var isDeclaredBoolean: Bool {
+        guard let declaredType = sqlite3_column_decltype(statement, index) else {
+            return false
+        }
+        return Self.booleanDeclaredTypes.contains(String(cString: declaredType).lowercased())
+    }
+
+    // MARK: Decoder
+
+    func container<Key: CodingKey>(keyedBy _: Key.Type) throws -> KeyedDecodingContainer<Key> {
+        throw mismatch([String: Any].self, "A SQLite column cannot be decoded as a keyed container")
+    }
+
+    func unkeyedContainer() throws -> any UnkeyedDecodingContainer {
+        throw mismatch([Any].self, "A SQLite column cannot be decoded as an unkeyed container")
+    }
+
+    func singleValueContainer() throws -> any SingleValueDecodingContainer {
+        self
+    }
+
+    // MARK: SingleValueDecodingContainer
+
+    func decodeNil() -> Bool {
+        storageType == SQLITE_NULL && !isDeclaredBoolean
+    }
+
+    func decode(_ type: Bool.Type) throws -> Bool {
+        let bools = SQLiteBoolColumn()
+        switch storageType {
+        case SQLITE_INTEGER:
+            return bools.boolAsInt(stmt: statement, index: index)
+
+        case SQLITE_FLOAT:
+            return bools.boolAsFloat(stmt: statement, index: index)
+
+        case SQLITE_TEXT:
+            return bools.boolAsString(stmt: statement, index: index)
+
+        default:
+            return false
+        }
+    }
+
+    func decode(_ type: String.Type) throws -> String {
+        switch storageType {
+        case SQLITE_NULL:
+            throw missing(type)
+
+        case SQLITE_BLOB:
+            return blob().base64EncodedString()
+
+        default:
+            return text() ?? ""
+        }
+    }
+
+    func decode(_ type: Double.Type) throws -> Double { try decodeFloatingPoint(type) }
+    func decode(_ type: Float.Type) throws -> Float { try decodeFloatingPoint(type) }
+    func decode(_ type: Int.Type) throws -> Int { try decodeInteger(type) }
+    func decode(_ type: Int8.Type) throws -> Int8 { try decodeInteger(type) }
+    func decode(_ type: Int16.Type) throws -> Int16 { try decodeInteger(type) }
+    func decode(_ type: Int32.Type) throws -> Int32 { try decodeInteger(type) }
+    func decode(_ type: Int64.Type) throws -> Int64 { try decodeInteger(type) }
+    func decode(_ type: UInt.Type) throws -> UInt { try decodeInteger(type) }
+    func decode(_ type: UInt8.Type) throws -> UInt8 { try decodeInteger(type) }
+    func decode(_ type: UInt16.Type) throws -> UInt16 { try decodeInteger(type) }
+    func decode(_ type: UInt32.Type) throws -> UInt32 { try decodeInteger(type) }
+    func decode(_ type: UInt64.Type) throws -> UInt64 { try decodeInteger(type) }
+
+    func decode<T: Decodable>(_ type: T.Type) throws -> T {
+        if type == Data.self {
+            return try decodeData() as! T // swiftlint:disable:this force_cast
+        }
+        return try T(from: self)
+    }
+
+    // MARK: Conversions
+
+    private func decodeFloatingPoint<T: BinaryFloatingPoint & LosslessStringConvertible>(_ type: T.Type) throws -> T {
+        switch storageType {
+        case SQLITE_INTEGER, SQLITE_FLOAT:
+            return T(sqlite3_column_double(statement, index))
+
+        case SQLITE_TEXT:
+            guard let text = text(), let value = T(text) else {
+                throw corrupted("Text is not a \(type)")
+            }
+            return value
+
+        case SQLITE_NULL:
+            throw missing(type)
+
+        default:
+            throw mismatch(type, "Expected a number")
+        }
+    }
+
+    private func decodeInteger<T: FixedWidthInteger>(_ type: T.Type) throws -> T {
+        let value: T?
+        switch storageType {
+        case SQLITE_INTEGER:
+            value = T(exactly: sqlite3_column_int64(statement, index))
+
+        case SQLITE_FLOAT:
+            value = T(exactly: sqlite3_column_double(statement, index))
+
+        case SQLITE_TEXT:
+            value = text().flatMap { T($0) }
+
+        case SQLITE_NULL:
+            throw missing(type)
+
+        default:
+            throw mismatch(type, "Expected a number")
+        }
+        guard let value else {
+            throw corrupted("Stored value does not fit in \(type)")
+        }
+        return value
+    }
+
+    private func decodeData() throws -> Data {
+        switch storageType {
+        case SQLITE_BLOB:
+            return blob()
+
+        case SQLITE_TEXT:
+            guard let text = text(), let data = Data(base64Encoded: text) else {
+                throw corrupted("Text is not base64 encoded data")
+            }
+            return data
+
+        case SQLITE_NULL:
+            throw missing(Data.self)
+
+        default:
+            throw mismatch(Data.self, "Expected a blob")
+        }
+    }
+
+    private func text() -> String? {
+        guard let pointer = sqlite3_column_text(statement, index) else {
+            return nil
+        }
+        return String(cString: pointer)
+    }
+
+    private func blob() -> Data {
+        let length = Int(sqlite3_column_bytes(statement, index))
+        guard let pointer = sqlite3_column_blob(statement, index), length > 0 else {
+            return Data()
+        }
+        return Data(bytes: pointer, count: length)
+    }
+
+    // MARK: Errors
+
+    private func missing(_ type: Any.Type) -> DecodingError {
+        DecodingError.valueNotFound(
+            type,
+            DecodingError.Context(codingPath: codingPath, debugDescription: "Column is NULL")
+        )
+    }
+
+    private func mismatch(_ type: Any.Type, _ description: String) -> DecodingError {
+        DecodingError.typeMismatch(type, DecodingError.Context(codingPath: codingPath, debugDescription: description))
+    }
+
+    private func corrupted(_ description: String) -> DecodingError {
+        DecodingError.dataCorrupted(DecodingError.Context(codingPath: codingPath, debugDescription: description))
+    }
+}
@@ -0,0 +1,188 @@
+//
+// SQLiteStatementCache.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import Foundation
+import SQLite3
+
+/// A per-connection LRU cache of prepared statements keyed by SQL text.
+///
+/// Statements are checked out for exclusive use while a query runs and returned afterwards,
+/// reset with their bindings cleared. Returning a statement makes it the most recently used
+/// entry for its connection; once a connection holds more than `capacity` idle statements the
+/// least recently used one is finalized.
+///
+/// Cached statements must be dropped with `invalidate(sqlite:)` after schema changes and
+/// before the connection is closed. `SQLiteInterface` does the latter in `close(store:)`.
+public final class SQLiteStatementCache {
+    /// Counters describing how well the cache is serving queries
+    public struct Statistics: Equatable {
+        public var hits = 0
+        public var misses = 0
+        public var evictions = 0
+        public var invalidations = 0
+
+        public init(hits: Int = 0, misses: Int = 0, evictions: Int = 0, invalidations: Int = 0) {
+            self.hits = hits
+            self.misses = misses
+            self.evictions = evictions
+            self.invalidations = invalidations
+        }
+    }
+
+    /// Checked-out statement. Returned to the cache with `checkin(_:)`.
+    struct Lease {
+        let sqlite: OpaquePointer
+        let sql: String
+        let statement: OpaquePointer
+        let generation: Int
+    }
+
+    private struct Connection {
+        /// Idle statements, least recently used first
+        var entries: [(sql: String, statement: OpaquePointer)] = []
+        var generation = 0
+    }
+
+    /// The cache used by `SQLiteInterface()` unless another is supplied
+    public static let shared = SQLiteStatementCache()
+
+    /// Maximum number of idle statements kept for each connection
+    public let capacity: Int
+
+    private var connections: [OpaquePointer: Connection] = [:]
+    private var counters = Statistics()
+    private let lock = NSLock()
+
+    public init(capacity: Int = 32) {
+        self.capacity = max(capacity, 1)
+    }
+
+    public var statistics: Statistics {
+        locked { counters }
+    }
+
+    public func resetStatistics() {
+        locked { counters = Statistics() }
+    }
+
+    /// Number of idle statements cached for a connection
+    public func cachedStatementCount(sqlite: OpaquePointer) -> Int {
+        locked { connections[sqlite]?.entries.count ?? 0 }
+    }
+
+    /// Finalizes every cached statement for a connection.
+    ///
+    /// Statements checked out at the time are finalized when they are returned instead of
+    /// being cached again.
+    public func invalidate(sqlite: OpaquePointer) {
+        let statements: [OpaquePointer] = locked {
+            guard var connection = connections[sqlite] else {
+                return []
+            }
+            let statements = connection.entries.map(\.statement)
+            connection.entries.removeAll()
+            connection.generation += 1
+            connections[sqlite] = connection
+            counters.invalidations += 1
+            return statements
+        }
+        statements.forEach { sqlite3_finalize($0) }
+    }
+
+    func checkout(sqlite: OpaquePointer, sql: String) throws -> Lease {
+        let cached: Lease? = locked {
+            var connection = connections[sqlite, default: Connection()]
+            defer {
+                connections[sqlite] = connection
+            }
+            guard let index = connection.entries.lastIndex(where: { $0.sql == sql }) else {
+                counters.misses += 1
+                return nil
+            }
+            counters.hits += 1
+            let entry = connection.entries.remove(at: index)
+            return Lease(sqlite: sqlite, sql: sql, statement: entry.statement, generation: connection.generation)
+        }
+        if let cached {
+            return cached
+        }
+
+        let generation = locked { connections[sqlite]?.generation ?? 0 }
+        var theStmt: OpaquePointer?
+        try SQLiteError.checkSqliteStatus(
+            sqlite3_prepare_v3(sqlite, sql, -1, UInt32(SQLITE_PREPARE_PERSISTENT), &theStmt, nil)
+        )
+        guard let statement = theStmt else {
+            throw SQLiteError.unknownSqliteError("Failed to prepare statement")
+        }
+        return Lease(sqlite: sqlite, sql: sql, statement: statement, generation: generation)
+    }
+
+    func checkin(_ lease: Lease) {
+        sqlite3_reset(lease.statement)
+        sqlite3_clear_bindings(lease.statement)
+
+        let finalize: [OpaquePointer] = locked {
+            guard
+                var connection = connections[lease.sqlite],
+                connection.generation == lease.generation
+            else {
+                return [lease.statement]
+            }
+            var finalize: [OpaquePointer] = []
+            if connection.entries.contains(where: { $0.sql == lease.sql }) {
+                // Another checkout of the same SQL was returned first; keep one copy
+                finalize.append(lease.statement)
+            } else {
+                connection.entries.append((lease.sql, lease.statement))
+            }
+            while connection.entries.count > capacity {
+                finalize.append(connection.entries.removeFirst().statement)
+                counters.evictions += 1
+            }
+            connections[lease.sqlite] = connection
+            return finalize
+        }
+        finalize.forEach { sqlite3_finalize($0) }
+    }
+
+    private func locked<T>(_ body: () throws -> T) rethrows -> T {
+        lock.lock()
+        defer {
+            lock.unlock()
+        }
+        return try body()
+    }
+
+    /// Finalizes cached statements and forgets the connection before it is closed
+    func remove(sqlite: OpaquePointer) {
+        let statements: [OpaquePointer] = locked {
+            connections.removeValue(forKey: sqlite)?.entries.map(\.statement) ?? []
+        }
+        statements.forEach { sqlite3_finalize($0) }
+    }
+}
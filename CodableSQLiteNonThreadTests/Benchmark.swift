@@ -0,0 +1,60 @@
+//
+// Benchmark.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import Foundation
+import Testing
+
+/// Timing helpers for the `.benchmark` tagged tests.
+///
+/// Benchmarks are skipped unless `PALEOROSE_BENCHMARKS` is set in the test scheme's
+/// environment, so the regular test run stays fast.
+enum Benchmark {
+    static var isEnabled: Bool {
+        ProcessInfo.processInfo.environment["PALEOROSE_BENCHMARKS"] != nil
+    }
+
+    /// Runs `body` `iterations` times and returns the fastest run.
+    @discardableResult
+    static func measure(
+        _ label: String,
+        iterations: Int = 3,
+        _ body: () throws -> Void
+    ) rethrows -> Duration {
+        let clock = ContinuousClock()
+        var best = Duration.seconds(Int64.max)
+        for _ in 0 ..< max(iterations, 1) {
+            let elapsed = try clock.measure(body)
+            best = min(best, elapsed)
+        }
+        print("[benchmark] \(label): \(best.formatted(.units(allowed: [.seconds, .milliseconds, .microseconds], fractionalPart: .show(length: 3))))")
+        return best
+    }
+
+    static func seconds(_ duration: Duration) -> Double {
+        let components = duration.components
+        return Double(components.seconds) + Double(components.attoseconds) * 1e-18
+    }
+}
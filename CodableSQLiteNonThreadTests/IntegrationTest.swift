@@ -220,6 +220,35 @@ struct IntegrationTest {
         try sut.close(store: store)
     }
 
+    @Test("Given a read-only connection, then reads succeed and writes throw")
+    func readOnlyConnection() throws {
+        let path = try #require(Bundle(identifier: "paleoterra.CodableSQLiteNonThreadTests")?.path(forResource: "testfile", ofType: "sqlite"))
+        let file = try sut.openReadOnlyDatabase(path: path)
+        defer {
+            do {
+                try sut.close(store: file)
+            } catch {
+                Issue.record("Failed to close database file: \(error)")
+            }
+        }
+
+        let tables: [TableSchema] = try sut.executeCodableQuery(sqlite: file, query: TableSchema.storedValues())
+        #expect(!tables.isEmpty)
+        #expect(throws: SQLiteError.self) {
+            try sut.executeQuery(sqlite: file, query: Query(sql: "CREATE TABLE readOnlyCheck (value INTEGER)"))
+        }
+    }
+
+    @Test("Given a missing file, then a read-only open throws rather than creating it")
+    func readOnlyMissingFile() throws {
+        let path = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString).path
+
+        #expect(throws: SQLiteError.self) {
+            try sut.openReadOnlyDatabase(path: path)
+        }
+        #expect(!FileManager.default.fileExists(atPath: path))
+    }
+
 //    @Test("Given database on disk, open file and read testable table, then verify records")
 //    func readDataFromDisk() throws {
 //        let file = try openTestFile())
@@ -0,0 +1,263 @@
+//
+// SQLiteRowDecoderTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import CodableSQLiteNonThread
+import Foundation
+import Testing
+
+@Suite("SQLiteRowDecoder")
+struct SQLiteRowDecoderTests {
+    let sut = SQLiteInterface()
+
+    private struct Conversions: Codable, Equatable {
+        let intFromReal: Int
+        let floatFromInteger: Float
+        let doubleFromText: Double
+        let boolFromText: Bool
+        let boolFromInteger: Bool
+        let blob: Data
+        let blobAsText: Data
+        let missing: String?
+    }
+
+    private struct Flags: Codable, Equatable {
+        let visible: Bool
+        let active: Bool
+        let optional: Bool?
+    }
+
+    private struct Measurement: Codable {
+        let value: Float
+    }
+
+    private func withStore(_ body: (OpaquePointer) throws -> Void) throws {
+        let store = try sut.createInMemoryStore(identifier: UUID().uuidString)
+        defer {
+            do {
+                try sut.close(store: store)
+            } catch {
+                Issue.record("Failed to close database: \(error)")
+            }
+        }
+        try body(store)
+    }
+
+    private func createMeasurements(_ values: [Float], store: OpaquePointer) throws {
+        try sut.executeQuery(sqlite: store, query: Query(sql: "CREATE TABLE measures (_id INTEGER PRIMARY KEY, value REAL);"))
+        try sut.executeQuery(sqlite: store, query: Query(sql: "BEGIN TRANSACTION;"))
+        try sut.executeQuery(
+            sqlite: store,
+            query: Query(sql: "INSERT INTO measures (value) VALUES (?);", bindings: values.map { [$0] as [Bindable?] })
+        )
+        try sut.executeQuery(sqlite: store, query: Query(sql: "COMMIT;"))
+    }
+
+    // MARK: - Codable Rows
+
+    @Test("Given a stored record, when decoding it, then every column converts to its property type")
+    func decodeRecord() throws {
+        try withStore { store in
+            try sut.executeQuery(sqlite: store, query: TestableTable.createTableQuery())
+            try sut.executeQuery(
+                sqlite: store,
+                query: Query(sql: """
+                INSERT INTO TestableTable VALUES
+                (1, 1, 2, 3, 4, 5, 6, 17.5, 342.25, 23.25, 'dream', NULL, x'0001ff');
+                """)
+            )
+            let expected = TestableTable(
+                boolValue: true,
+                intValue: 1,
+                int32Value: 2,
+                uintValue: 3,
+                uint32Value: 4,
+                int16Value: 5,
+                uint16Value: 6,
+                floatValue: 17.5,
+                doubleValue: 342.25,
+                cgFloatValue: 23.25,
+                stringValue: "dream",
+                optionalString: nil,
+                dataStore: Data([0x00, 0x01, 0xFF])
+            )
+
+            let decoded: [TestableTable] = try sut.executeCodableQuery(sqlite: store, query: TestableTable.storedValues())
+
+            #expect(decoded == [expected])
+        }
+    }
+
+    @Test("Given columns of mixed storage classes, when decoding, then values convert like the JSON path")
+    func convertStorageClasses() throws {
+        try withStore { store in
+            let select = """
+            SELECT 3.0 AS intFromReal, 7 AS floatFromInteger, '2.5' AS doubleFromText,
+            'Yes' AS boolFromText, 1 AS boolFromInteger, x'00ff10' AS blob,
+            'AP8Q' AS blobAsText, NULL AS missing;
+            """
+            let decoded: [Conversions] = try sut.executeCodableQuery(sqlite: store, query: Query(sql: select))
+
+            #expect(decoded == [Conversions(
+                intFromReal: 3,
+                floatFromInteger: 7,
+                doubleFromText: 2.5,
+                boolFromText: true,
+                boolFromInteger: true,
+                blob: Data([0x00, 0xFF, 0x10]),
+                blobAsText: Data([0x00, 0xFF, 0x10]),
+                missing: nil
+            )])
+        }
+    }
+
+    @Test("Given NULL or blob booleans, when decoding, then they are false as SQLiteBoolColumn made them")
+    func nullAndBlobBooleansAreFalse() throws {
+        try withStore { store in
+            try sut.executeQuery(
+                sqlite: store,
+                query: Query(sql: "CREATE TABLE flags (visible BOOL, active BOOLEAN, optional BOOL);")
+            )
+            try sut.executeQuery(
+                sqlite: store,
+                query: Query(sql: "INSERT INTO flags VALUES (NULL, x'01', NULL), (x'', NULL, 1);")
+            )
+
+            let decoded: [Flags] = try sut.executeCodableQuery(
+                sqlite: store,
+                query: Query(sql: "SELECT * FROM flags;")
+            )
+
+            #expect(decoded == [
+                Flags(visible: false, active: false, optional: false),
+                Flags(visible: false, active: false, optional: true)
+            ])
+        }
+    }
+
+    @Test("Given a query without the decoded column, when decoding, then throw a decoding error")
+    func missingColumnThrows() throws {
+        try withStore { store in
+            #expect(throws: DecodingError.self) {
+                let _: [Measurement] = try sut.executeCodableQuery(sqlite: store, query: Query(sql: "SELECT 1 AS other;"))
+            }
+        }
+    }
+
+    @Test("Given a fractional real, when decoding an integer, then throw rather than truncate")
+    func fractionalIntegerThrows() throws {
+        try withStore { store in
+            #expect(throws: DecodingError.self) {
+                let _: [Int] = try sut.executeCodableQuery(sqlite: store, query: Query(sql: "SELECT 2.5;"))
+            }
+        }
+    }
+
+    @Test("Given a single column result, when decoding a scalar, then return the column value")
+    func decodeSingleColumn() throws {
+        try withStore { store in
+            try createMeasurements([1, 2, 3, 4], store: store)
+            let counts: [Int] = try sut.executeCodableQuery(sqlite: store, query: Query(sql: "SELECT COUNT(*) FROM measures;"))
+            #expect(counts == [4])
+        }
+    }
+
+    // MARK: - Column Reads
+
+    @Test("Given mixed column values, when reading the column, then numbers and numeric text are returned in order")
+    func readColumnSkipsNonNumbers() throws {
+        try withStore { store in
+            try sut.executeQuery(sqlite: store, query: Query(sql: "CREATE TABLE mixed (value);"))
+            try sut.executeQuery(
+                sqlite: store,
+                query: Query(sql: "INSERT INTO mixed VALUES (12), (45.5), ('270.25'), (NULL), ('north'), (x'01');")
+            )
+
+            let values = try sut.readColumn("value", as: Float.self, sqlite: store, query: Query(sql: "SELECT * FROM mixed;"))
+
+            #expect(values == [12, 45.5, 270.25])
+        }
+    }
+
+    @Test("Given a query with bindings, when reading the column, then each subquery contributes its rows")
+    func readColumnWithBindings() throws {
+        try withStore { store in
+            try createMeasurements([10, 20, 30, 40], store: store)
+            let query = Query(sql: "SELECT value FROM measures WHERE _id = ?;", bindings: [[Int32(4)], [Int32(2)]])
+
+            let values = try sut.readColumn("value", as: Double.self, sqlite: store, query: query)
+
+            #expect(values == [40, 20])
+        }
+    }
+
+    @Test("Given a column the query does not return, when reading it, then throw columnNotFound")
+    func readMissingColumnThrows() throws {
+        try withStore { store in
+            try createMeasurements([1], store: store)
+            #expect(throws: SQLiteError.columnNotFound("azimuth")) {
+                try sut.readColumn("azimuth", as: Float.self, sqlite: store, query: Query(sql: "SELECT * FROM measures;"))
+            }
+        }
+    }
+
+    // MARK: - Benchmark
+
+    @Test(
+        "Benchmark reading a 1M row column",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkColumnRead() throws {
+        try withStore { store in
+            let rowCount = 1_000_000
+            let values = (0 ..< rowCount).map { Float($0 % 36000) / 100 }
+            try createMeasurements(values, store: store)
+            let query = Query(sql: "SELECT * FROM measures;")
+
+            let dictionaries = Benchmark.measure("executeQuery dictionaries, \(rowCount) rows", iterations: 1) {
+                _ = try? sut.executeQuery(sqlite: store, query: query)
+            }
+            let json = Benchmark.measure("JSON round trip, \(rowCount) rows", iterations: 1) {
+                let data = try? sut.executeDataQuery(sqlite: store, query: query)
+                _ = data.flatMap { try? JSONDecoder().decode([Measurement].self, from: $0) }
+            }
+            var decoded: [Measurement] = []
+            let rows = Benchmark.measure("row decoder, \(rowCount) rows") {
+                decoded = (try? sut.executeCodableQuery(sqlite: store, query: query)) ?? []
+            }
+            var column: [Float] = []
+            let bulk = Benchmark.measure("readColumn, \(rowCount) rows") {
+                column = (try? sut.readColumn("value", as: Float.self, sqlite: store, query: query)) ?? []
+            }
+
+            #expect(decoded.map(\.value) == values)
+            #expect(column == values)
+            print("[benchmark] readColumn speedup over dictionaries: \(Benchmark.seconds(dictionaries) / Benchmark.seconds(bulk))x")
+            print("[benchmark] row decoder speedup over JSON: \(Benchmark.seconds(json) / Benchmark.seconds(rows))x")
+        }
+    }
+}
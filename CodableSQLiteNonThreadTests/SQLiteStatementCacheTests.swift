@@ -0,0 +1,214 @@
+//
+// SQLiteStatementCacheTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import CodableSQLiteNonThread
+import Foundation
+import SQLite3
+import Testing
+
+@Suite("SQLiteStatementCache")
+struct SQLiteStatementCacheTests {
+    private struct Row: Codable, Equatable {
+        let id: Int
+        let name: String?
+    }
+
+    private func withStore(
+        cache: SQLiteStatementCache?,
+        _ body: (SQLiteInterface, OpaquePointer) throws -> Void
+    ) throws {
+        let sut = SQLiteInterface(statementCache: cache)
+        let store = try sut.createInMemoryStore(identifier: UUID().uuidString)
+        defer {
+            do {
+                try sut.close(store: store)
+            } catch {
+                Issue.record("Failed to close database: \(error)")
+            }
+        }
+        try sut.executeQuery(sqlite: store, query: Query(sql: "CREATE TABLE rows (id INTEGER PRIMARY KEY, name TEXT);"))
+        try body(sut, store)
+    }
+
+    private func insert(_ rows: [[Bindable?]], sut: SQLiteInterface, store: OpaquePointer) throws {
+        try sut.executeQuery(sqlite: store, query: Query(sql: "INSERT INTO rows VALUES (?, ?);", bindings: rows))
+    }
+
+    @Test("Given the same SQL run repeatedly, then the statement is prepared once")
+    func repeatedQueriesHit() throws {
+        let cache = SQLiteStatementCache()
+        try withStore(cache: cache) { sut, store in
+            cache.resetStatistics()
+            for index in 0 ..< 10 {
+                try insert([[index, "row \(index)"]], sut: sut, store: store)
+            }
+
+            #expect(cache.statistics.misses == 1)
+            #expect(cache.statistics.hits == 9)
+            #expect(sut.statementCacheStatistics == cache.statistics)
+        }
+    }
+
+    @Test("Given more distinct statements than the capacity, then the least recently used are finalized")
+    func evictsLeastRecentlyUsed() throws {
+        let cache = SQLiteStatementCache(capacity: 2)
+        try withStore(cache: cache) { sut, store in
+            sut.invalidateStatements(sqlite: store)
+            cache.resetStatistics()
+            let first = Query(sql: "SELECT 1;")
+            let second = Query(sql: "SELECT 2;")
+            let third = Query(sql: "SELECT 3;")
+            for query in [first, second, first, third, first, second] {
+                try sut.executeQuery(sqlite: store, query: query)
+            }
+
+            // second is evicted by third, then third by second
+            #expect(cache.statistics == .init(hits: 2, misses: 4, evictions: 2, invalidations: 0))
+            #expect(cache.cachedStatementCount(sqlite: store) == 2)
+        }
+    }
+
+    @Test("Given a cached statement, when a later call binds nil, then the earlier value is not reused")
+    func clearsBindingsBetweenCalls() throws {
+        try withStore(cache: SQLiteStatementCache()) { sut, store in
+            try insert([[1, "first"]], sut: sut, store: store)
+            try insert([[2, nil]], sut: sut, store: store)
+            try insert([[3, "third"], [4, nil]], sut: sut, store: store)
+
+            let rows: [Row] = try sut.executeCodableQuery(sqlite: store, query: Query(sql: "SELECT * FROM rows;"))
+
+            #expect(rows == [
+                Row(id: 1, name: "first"),
+                Row(id: 2, name: nil),
+                Row(id: 3, name: "third"),
+                Row(id: 4, name: nil)
+            ])
+        }
+    }
+
+    @Test("Given a schema change, when invalidating, then cached statements are dropped and queries see the change")
+    func invalidateAfterSchemaChange() throws {
+        let cache = SQLiteStatementCache()
+        try withStore(cache: cache) { sut, store in
+            try insert([[1, "first"]], sut: sut, store: store)
+            let select = Query(sql: "SELECT * FROM rows;")
+            #expect(try sut.executeQuery(sqlite: store, query: select).first?.count == 2)
+
+            try sut.executeQuery(sqlite: store, query: Query(sql: "ALTER TABLE rows ADD COLUMN azimuth REAL;"))
+            sut.invalidateStatements(sqlite: store)
+
+            #expect(cache.cachedStatementCount(sqlite: store) == 0)
+            #expect(cache.statistics.invalidations == 1)
+            try sut.executeQuery(sqlite: store, query: Query(sql: "UPDATE rows SET azimuth = 12.5;"))
+            #expect(try sut.executeQuery(sqlite: store, query: select).first?.count == 3)
+        }
+    }
+
+    @Test("Given cached statements, when closing the database, then the close succeeds")
+    func closeFinalizesCachedStatements() throws {
+        let cache = SQLiteStatementCache()
+        let sut = SQLiteInterface(statementCache: cache)
+        let store = try sut.createInMemoryStore(identifier: UUID().uuidString)
+        try sut.executeQuery(sqlite: store, query: Query(sql: "SELECT 1;"))
+        #expect(cache.cachedStatementCount(sqlite: store) == 1)
+
+        try sut.close(store: store)
+
+        #expect(cache.cachedStatementCount(sqlite: store) == 0)
+    }
+
+    @Test("Given streamed rows, when executing each, then one statement is prepared and every row is inserted")
+    func executeEachStreamsRows() throws {
+        let cache = SQLiteStatementCache()
+        try withStore(cache: cache) { sut, store in
+            cache.resetStatistics()
+            var next = 0
+            let count = try sut.executeEach(sqlite: store, sql: "INSERT INTO rows VALUES (?, ?);") {
+                guard next < 3 else {
+                    return nil
+                }
+                next += 1
+                return [next, next == 2 ? nil : "row \(next)"]
+            }
+
+            let rows: [Row] = try sut.executeCodableQuery(sqlite: store, query: Query(sql: "SELECT * FROM rows;"))
+            #expect(count == 3)
+            #expect(rows == [Row(id: 1, name: "row 1"), Row(id: 2, name: nil), Row(id: 3, name: "row 3")])
+            #expect(cache.statistics.misses == 2)
+        }
+    }
+
+    @Test("Given a failing row, when executing each, then the error is thrown and later rows are not pulled")
+    func executeEachStopsOnError() throws {
+        try withStore(cache: SQLiteStatementCache()) { sut, store in
+            var pulled = 0
+            #expect(throws: SQLiteError.self) {
+                try sut.executeEach(sqlite: store, sql: "INSERT INTO rows VALUES (?, ?);") {
+                    pulled += 1
+                    return [1, "duplicate key"]
+                }
+            }
+            #expect(pulled == 2)
+        }
+    }
+
+    @Test("Given caching is disabled, then no statistics are reported")
+    func disabledCache() throws {
+        try withStore(cache: nil) { sut, store in
+            try insert([[1, "first"]], sut: sut, store: store)
+            #expect(sut.statementCacheStatistics == nil)
+        }
+    }
+
+    @Test(
+        "Benchmark repeated single row inserts",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkRepeatedInserts() throws {
+        let rowCount = 20000
+        func run(cache: SQLiteStatementCache?, label: String) throws -> Duration {
+            var elapsed = Duration.zero
+            try withStore(cache: cache) { sut, store in
+                elapsed = Benchmark.measure(label, iterations: 1) {
+                    for index in 0 ..< rowCount {
+                        // A new query per row, as InMemoryStore.store(layers:) builds them
+                        _ = try? sut.executeQuery(
+                            sqlite: store,
+                            query: Query(sql: "INSERT INTO rows VALUES (?, ?);", bindings: [[index, "row"]])
+                        )
+                    }
+                }
+            }
+            return elapsed
+        }
+        let cache = SQLiteStatementCache()
+        let uncached = try run(cache: nil, label: "prepare per insert, \(rowCount) rows")
+        let cached = try run(cache: cache, label: "cached statement, \(rowCount) rows")
+        print("[benchmark] statement cache \(cache.statistics), speedup \(Benchmark.seconds(uncached) / Benchmark.seconds(cached))x")
+    }
+}
@@ -27,5 +27,6 @@
 import Testing
 
 extension Tag {
+    @Tag static var benchmark: Self
     @Tag static var integration: Self
 }
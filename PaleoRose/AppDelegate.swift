@@ -53,6 +53,14 @@ class AppDelegate: NSObject, NSApplicationDelegate {
 
     // MARK: - Application Lifecycle
 
+    /// Runs a headless batch render when launched with `--render-batch`, otherwise the application.
+    static func main() {
+        if let status = BatchRenderCommand.main(arguments: Array(CommandLine.arguments.dropFirst())) {
+            exit(status)
+        }
+        _ = NSApplicationMain(CommandLine.argc, CommandLine.unsafeArgv)
+    }
+
     func applicationDidFinishLaunching(_: Notification) {
         NSColorPanel.shared.showsAlpha = true
     }
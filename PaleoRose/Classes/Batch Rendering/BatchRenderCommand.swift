@@ -0,0 +1,206 @@
+//
+// BatchRenderCommand.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import Foundation
+
+/// Renders every `.XRose` document in a directory from the command line.
+///
+///     PaleoRose --render-batch <input directory> --output <directory> [--format pdf|svg] [--size <points>] [--jobs <n>]
+///
+/// `AppDelegate.main()` runs this instead of the application when the first argument is
+/// `--render-batch`. Documents are spread across a pool of `jobs` workers, defaulting to one per
+/// core; a document that fails is reported and skipped.
+struct BatchRenderCommand {
+    static let flag = "--render-batch"
+    static let documentExtension = "XRose"
+
+    enum ArgumentError: Error, Equatable, CustomStringConvertible {
+        case missingValue(String)
+        case unknownArgument(String)
+        case invalidValue(String, String)
+
+        var description: String {
+            switch self {
+            case let .missingValue(option):
+                return "\(option) needs a value"
+
+            case let .unknownArgument(argument):
+                return "unknown argument \(argument)"
+
+            case let .invalidValue(option, value):
+                return "\(value) is not a valid value for \(option)"
+            }
+        }
+    }
+
+    struct Summary {
+        let rendered: Int
+        let failures: [(url: URL, error: Error)]
+        let duration: Duration
+
+        var documentsPerSecond: Double {
+            let components = duration.components
+            let seconds = Double(components.seconds) + Double(components.attoseconds) * 1e-18
+            return seconds > 0 ? Double(rendered) / seconds : 0
+        }
+    }
+
+    let inputDirectory: URL
+    let outputDirectory: URL
+    var format: RoseDocumentRenderer.Format = .pdf
+    var size: CGSize?
+    var jobs = ProcessInfo.processInfo.activeProcessorCount
+
+    init(inputDirectory: URL, outputDirectory: URL) {
+        self.inputDirectory = inputDirectory
+        self.outputDirectory = outputDirectory
+    }
+
+    /// Parses `arguments`, not including the executable. Returns `nil` when they do not start
+    /// with `--render-batch`.
+    init?(arguments: [String]) throws {
+        guard arguments.first == Self.flag else {
+            return nil
+        }
+        guard arguments.count > 1 else {
+            throw ArgumentError.missingValue(Self.flag)
+        }
+        let input = URL(fileURLWithPath: arguments[1], isDirectory: true)
+        var output = input
+        var options: (format: RoseDocumentRenderer.Format, size: CGSize?, jobs: Int?) = (.pdf, nil, nil)
+        var remaining = arguments.dropFirst(2).makeIterator()
+        while let option = remaining.next() {
+            guard let value = remaining.next() else {
+                throw ArgumentError.missingValue(option)
+            }
+            switch option {
+            case "--output":
+                output = URL(fileURLWithPath: value, isDirectory: true)
+
+            case "--format":
+                guard let format = RoseDocumentRenderer.Format(rawValue: value.lowercased()) else {
+                    throw ArgumentError.invalidValue(option, value)
+                }
+                options.format = format
+
+            case "--size":
+                guard let points = Double(value), points > 0 else {
+                    throw ArgumentError.invalidValue(option, value)
+                }
+                options.size = CGSize(width: points, height: points)
+
+            case "--jobs":
+                guard let jobs = Int(value), jobs > 0 else {
+                    throw ArgumentError.invalidValue(option, value)
+                }
+                options.jobs = jobs
+
+            default:
+                throw ArgumentError.unknownArgument(option)
+            }
+        }
+        self.init(inputDirectory: input, outputDirectory: output)
+        format = options.format
+        size = options.size
+        if let jobs = options.jobs {
+            self.jobs = jobs
+        }
+    }
+
+    func documents() throws -> [URL] {
+        try FileManager.default
+            .contentsOfDirectory(at: inputDirectory, includingPropertiesForKeys: nil, options: .skipsHiddenFiles)
+            .filter { $0.pathExtension.caseInsensitiveCompare(Self.documentExtension) == .orderedSame }
+            .sorted { $0.lastPathComponent < $1.lastPathComponent }
+    }
+
+    func outputURL(for document: URL) -> URL {
+        outputDirectory
+            .appendingPathComponent(document.deletingPathExtension().lastPathComponent)
+            .appendingPathExtension(format.rawValue)
+    }
+
+    func run() throws -> Summary {
+        let documents = try documents()
+        try FileManager.default.createDirectory(at: outputDirectory, withIntermediateDirectories: true)
+        let renderer = RoseDocumentRenderer(format: format, size: size)
+        let failures = FailureList()
+        let queue = OperationQueue()
+        queue.name = "BatchRenderCommand"
+        queue.maxConcurrentOperationCount = jobs
+        let start = ContinuousClock.now
+        for document in documents {
+            queue.addOperation {
+                autoreleasepool {
+                    do {
+                        try renderer.render(documentAt: document, to: outputURL(for: document))
+                    } catch {
+                        failures.append(document, error)
+                    }
+                }
+            }
+        }
+        queue.waitUntilAllOperationsAreFinished()
+        let failed = failures.items
+        return Summary(rendered: documents.count - failed.count, failures: failed, duration: ContinuousClock.now - start)
+    }
+
+    /// Runs the command and prints a report; returns the process exit status.
+    static func main(arguments: [String]) -> Int32? {
+        do {
+            guard let command = try BatchRenderCommand(arguments: arguments) else {
+                return nil
+            }
+            let summary = try command.run()
+            for failure in summary.failures {
+                FileHandle.standardError.write(Data("\(failure.url.lastPathComponent): \(failure.error)\n".utf8))
+            }
+            print("Rendered \(summary.rendered) documents in \(summary.duration) (\(String(format: "%.1f", summary.documentsPerSecond)) documents/s)")
+            return summary.failures.isEmpty ? EXIT_SUCCESS : EXIT_FAILURE
+        } catch {
+            FileHandle.standardError.write(Data("\(error)\n".utf8))
+            return EXIT_FAILURE
+        }
+    }
+
+    private final class FailureList: @unchecked Sendable {
+        private let lock = NSLock()
+        private var failures: [(url: URL, error: Error)] = []
+
+        var items: [(url: URL, error: Error)] {
+            lock.lock()
+            defer { lock.unlock() }
+            return failures
+        }
+
+        func append(_ url: URL, _ error: Error) {
+            lock.lock()
+            defer { lock.unlock() }
+            failures.append((url, error))
+        }
+    }
+}
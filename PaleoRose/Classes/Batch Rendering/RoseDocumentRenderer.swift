@@ -0,0 +1,110 @@
+//
+// RoseDocumentRenderer.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import AppKit
+import CodableSQLiteNonThread
+
+/// Draws a saved rose diagram document to PDF or SVG without a window.
+///
+/// The document is read with `InMemoryStore.readSnapshot()`, its layers are rebuilt by
+/// `StorageModelFactory` and attached to a private geometry controller, and the plot is laid out
+/// the way `XRoseView` lays it out: a square drawing rect centred on the origin. Each call uses its
+/// own store and controller, so documents can be rendered on several threads at once.
+struct RoseDocumentRenderer {
+    enum Format: String, CaseIterable {
+        case pdf
+        case svg
+    }
+
+    enum RenderError: Error {
+        case couldNotCreatePDFContext
+    }
+
+    /// Used when neither `size` nor the document gives a window size
+    static let defaultSize = CGSize(width: 600, height: 600)
+
+    let format: Format
+    /// Output size in points; `nil` uses the document's saved window size
+    var size: CGSize?
+
+    init(format: Format, size: CGSize? = nil) {
+        self.format = format
+        self.size = size
+    }
+
+    func render(documentAt url: URL) throws -> Data {
+        let store = try InMemoryStore(interface: SQLiteInterface())
+        try store.load(from: url.path)
+        let snapshot = try store.readSnapshot()
+        let canvas = size ?? snapshot.windowSize ?? Self.defaultSize
+
+        let geometryController = XRGeometryController()
+        if let geometry = snapshot.geometry {
+            StorageModelFactory().configure(geometryController, from: geometry)
+        }
+        // Lay out before attaching, so each layer generates its graphics once
+        let side = min(canvas.width, canvas.height)
+        geometryController.resetGeometry(withBoundsRect: CGRect(x: -side / 2, y: -side / 2, width: side, height: side))
+        DocumentModel.attach(snapshot.layers, to: geometryController, dataSets: snapshot.dataSets)
+
+        switch format {
+        case .pdf:
+            return try pdf(layers: snapshot.layers, size: canvas)
+
+        case .svg:
+            return Data(RoseSVGWriter(size: canvas).svg(for: snapshot.layers).utf8)
+        }
+    }
+
+    func render(documentAt url: URL, to outputURL: URL) throws {
+        try render(documentAt: url).write(to: outputURL, options: .atomic)
+    }
+
+    private func pdf(layers: [XRLayer], size: CGSize) throws -> Data {
+        let data = NSMutableData()
+        var mediaBox = CGRect(origin: .zero, size: size)
+        guard
+            let consumer = CGDataConsumer(data: data as CFMutableData),
+            let context = CGContext(consumer: consumer, mediaBox: &mediaBox, nil)
+        else {
+            throw RenderError.couldNotCreatePDFContext
+        }
+        context.beginPDFPage(nil)
+        NSGraphicsContext.saveGraphicsState()
+        NSGraphicsContext.current = NSGraphicsContext(cgContext: context, flipped: false)
+        context.translateBy(x: size.width / 2, y: size.height / 2)
+        let bounds = CGRect(x: -size.width / 2, y: -size.height / 2, width: size.width, height: size.height)
+        // Back to front, as LayersTableController draws them
+        for layer in layers.reversed() {
+            layer.draw(bounds)
+        }
+        NSGraphicsContext.restoreGraphicsState()
+        context.endPDFPage()
+        context.closePDF()
+        return data as Data
+    }
+}
@@ -0,0 +1,175 @@
+//
+// RoseDocumentRendererTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import CodableSQLiteNonThread
+import Foundation
+@testable import PaleoRose
+import Testing
+
+@Suite(
+    "Rose Document Renderer",
+    .tags(.integration)
+)
+struct RoseDocumentRendererTests {
+
+    // MARK: - Test Setup
+
+    private func sampleFileURL() throws -> URL {
+        guard
+            let bundle = Bundle(identifier: "PaleoTerra.Unit-Tests"),
+            let path = bundle.path(forResource: "rtest1", ofType: "XRose")
+        else {
+            Issue.record("Could not find test file")
+            throw SQLiteError.failedToOpen
+        }
+        return URL(fileURLWithPath: path)
+    }
+
+    /// A temporary directory holding `count` copies of the sample document
+    private func batchDirectory(count: Int) throws -> URL {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        let sample = try sampleFileURL()
+        for index in 0 ..< count {
+            try FileManager.default.copyItem(
+                at: sample,
+                to: directory.appendingPathComponent("rose\(index)").appendingPathExtension("XRose")
+            )
+        }
+        return directory
+    }
+
+    // MARK: - Rendering
+
+    @Test("PDF output is a single page document")
+    func renderPDF() throws {
+        let data = try RoseDocumentRenderer(format: .pdf, size: CGSize(width: 300, height: 300))
+            .render(documentAt: sampleFileURL())
+
+        #expect(data.starts(with: Data("%PDF".utf8)))
+        let provider = try #require(CGDataProvider(data: data as CFData))
+        let document = try #require(CGPDFDocument(provider))
+        #expect(document.numberOfPages == 1)
+        #expect(document.page(at: 1)?.getBoxRect(.mediaBox).size == CGSize(width: 300, height: 300))
+    }
+
+    @Test("SVG output draws the grid, data and vector layers")
+    func renderSVG() throws {
+        let data = try RoseDocumentRenderer(format: .svg, size: CGSize(width: 400, height: 400))
+            .render(documentAt: sampleFileURL())
+        let svg = try #require(String(data: data, encoding: .utf8))
+
+        #expect(svg.hasPrefix("<?xml"))
+        #expect(svg.contains("width=\"400\""))
+        #expect(svg.components(separatedBy: "<path").count > 3)
+    }
+
+    @Test("Rendering the same document twice gives the same SVG")
+    func renderIsRepeatable() throws {
+        let renderer = RoseDocumentRenderer(format: .svg)
+        let url = try sampleFileURL()
+
+        #expect(try renderer.render(documentAt: url) == renderer.render(documentAt: url))
+    }
+
+    // MARK: - Batch Command
+
+    @Test("Arguments other than --render-batch launch the application")
+    func ignoresOtherArguments() throws {
+        #expect(try BatchRenderCommand(arguments: []) == nil)
+        #expect(try BatchRenderCommand(arguments: ["-NSDocumentRevisionsDebugMode", "YES"]) == nil)
+    }
+
+    @Test("Batch options are parsed")
+    func parsesArguments() throws {
+        let command = try #require(try BatchRenderCommand(arguments: [
+            "--render-batch", "/tmp/in", "--output", "/tmp/out", "--format", "SVG", "--size", "512", "--jobs", "3"
+        ]))
+
+        #expect(command.inputDirectory.path == "/tmp/in")
+        #expect(command.outputDirectory.path == "/tmp/out")
+        #expect(command.format == .svg)
+        #expect(command.size == CGSize(width: 512, height: 512))
+        #expect(command.jobs == 3)
+        #expect(command.outputURL(for: URL(fileURLWithPath: "/tmp/in/a.XRose")).path == "/tmp/out/a.svg")
+    }
+
+    @Test(
+        "Bad batch options are rejected",
+        arguments: [
+            (["--render-batch"], BatchRenderCommand.ArgumentError.missingValue("--render-batch")),
+            (["--render-batch", "in", "--size"], .missingValue("--size")),
+            (["--render-batch", "in", "--format", "png"], .invalidValue("--format", "png")),
+            (["--render-batch", "in", "--jobs", "0"], .invalidValue("--jobs", "0")),
+            (["--render-batch", "in", "--colour", "red"], .unknownArgument("--colour"))
+        ]
+    )
+    func rejectsArguments(arguments: [String], expected: BatchRenderCommand.ArgumentError) {
+        #expect(throws: expected) {
+            try BatchRenderCommand(arguments: arguments)
+        }
+    }
+
+    @Test("A batch renders every document in the directory")
+    func runBatch() throws {
+        let input = try batchDirectory(count: 4)
+        defer { try? FileManager.default.removeItem(at: input) }
+        var command = BatchRenderCommand(inputDirectory: input, outputDirectory: input.appendingPathComponent("out"))
+        command.format = .svg
+        command.jobs = 2
+
+        let summary = try command.run()
+
+        #expect(summary.rendered == 4)
+        #expect(summary.failures.isEmpty)
+        let outputs = try FileManager.default.contentsOfDirectory(atPath: command.outputDirectory.path)
+        #expect(outputs.sorted() == ["rose0.svg", "rose1.svg", "rose2.svg", "rose3.svg"])
+    }
+
+    // MARK: - Benchmark
+
+    @Test(
+        "Benchmark: batch rendering throughput",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled),
+        arguments: RoseDocumentRenderer.Format.allCases
+    )
+    func benchmarkBatch(format: RoseDocumentRenderer.Format) throws {
+        let input = try batchDirectory(count: 64)
+        defer { try? FileManager.default.removeItem(at: input) }
+        for jobs in [1, ProcessInfo.processInfo.activeProcessorCount] {
+            var command = BatchRenderCommand(inputDirectory: input, outputDirectory: input.appendingPathComponent("out\(jobs)"))
+            command.format = format
+            command.jobs = jobs
+
+            let summary = try command.run()
+
+            #expect(summary.rendered == 64)
+            print("[benchmark] \(format.rawValue), \(jobs) job(s): \(String(format: "%.1f", summary.documentsPerSecond)) documents/s")
+        }
+    }
+}
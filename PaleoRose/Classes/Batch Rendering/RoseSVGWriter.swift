@@ -0,0 +1,184 @@
+//
+// RoseSVGWriter.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import AppKit
+
+/// Writes a rose diagram's layers as SVG by walking their graphics rather than drawing them.
+///
+/// Each layer type is emitted with the same visibility rules as its `drawRect:`. The plot is centred
+/// on the origin, as it is in `XRoseView`, and y points up, so the document flips it into SVG's
+/// y-down viewport. Text layers and ring labels are not written; use PDF output where they matter.
+struct RoseSVGWriter {
+    let size: CGSize
+
+    func svg(for layers: [XRLayer]) -> String {
+        var body: [String] = []
+        // Layers draw back to front, the reverse of their table order
+        for layer in layers.reversed() where layer.isVisible() {
+            body.append(contentsOf: elements(for: layer))
+        }
+        let width = Self.number(size.width)
+        let height = Self.number(size.height)
+        return """
+        <?xml version="1.0" encoding="UTF-8"?>
+        <svg xmlns="http://www.w3.org/2000/svg" width="\(width)" height="\(height)" viewBox="0 0 \(width) \(height)">
+        <g transform="translate(\(Self.number(size.width / 2)) \(Self.number(size.height / 2))) scale(1 -1)">
+        \(body.joined(separator: "\n"))
+        </g>
+        </svg>
+
+        """
+    }
+
+    // MARK: - Layers
+
+    private func elements(for layer: XRLayer) -> [String] {
+        let objects = layer.graphicalObjects() ?? []
+        switch layer {
+        case let grid as XRLayerGrid:
+            return objects.compactMap { object in
+                guard let graphic = object as? Graphic else {
+                    return nil
+                }
+                let visible = (graphic is GraphicCircleLabel && grid.ringsVisible()) || (graphic is GraphicLine && grid.spokesVisible())
+                return visible ? element(for: graphic) : nil
+            }
+
+        case let arrow as XRLayerLineArrow:
+            return elements(forLineArrow: arrow, objects: objects)
+
+        case is XRLayerCore:
+            return objects.compactMap { ($0 as? Graphic).flatMap { element(for: $0, lineWidth: CGFloat(layer.lineWeight())) } }
+
+        case is XRLayerData:
+            return objects.compactMap { ($0 as? Graphic).flatMap { element(for: $0) } }
+
+        default:
+            return []
+        }
+    }
+
+    private func elements(forLineArrow layer: XRLayerLineArrow, objects: [Any]) -> [String] {
+        var elements: [String] = []
+        let stroke = layer.strokeColor()
+        let lineWidth = CGFloat(layer.lineWeight())
+        if layer.showVector(), let parts = objects.first as? [String: Any], let vector = parts["vector"] as? NSBezierPath {
+            elements.append(Self.path(vector, stroke: stroke, fill: nil, lineWidth: lineWidth))
+            if let head = parts["arrow"] as? ArrowHead, let outline = head.path.copy() as? NSBezierPath {
+                // ArrowHead draws with the position transform concatenated before the scale
+                let placed = head.scaleTransform.concatenating(head.positionTransform)
+                outline.transform(using: AffineTransform(m11: placed.a, m12: placed.b, m21: placed.c, m22: placed.d, tX: placed.tx, tY: placed.ty))
+                elements.append(Self.path(outline, stroke: head.arrowColor, fill: head.arrowColor, lineWidth: outline.lineWidth))
+            }
+        }
+        if layer.showError(), objects.count > 1, let error = objects[1] as? NSBezierPath {
+            elements.append(Self.path(error, stroke: stroke, fill: nil, lineWidth: lineWidth))
+        }
+        return elements
+    }
+
+    private func element(for graphic: Graphic, lineWidth: CGFloat? = nil) -> String? {
+        guard let path = graphic.drawingPath, !path.isEmpty else {
+            return nil
+        }
+        return Self.path(
+            path,
+            stroke: graphic.strokeColor,
+            fill: graphic.drawsFill ? graphic.fillColor : nil,
+            lineWidth: lineWidth ?? path.lineWidth
+        )
+    }
+
+    // MARK: - SVG
+
+    static func path(_ path: NSBezierPath, stroke: NSColor?, fill: NSColor?, lineWidth: CGFloat) -> String {
+        var attributes = ["d=\"\(pathData(path))\""]
+        attributes.append(contentsOf: paint("fill", fill))
+        attributes.append(contentsOf: paint("stroke", stroke))
+        if stroke != nil {
+            attributes.append("stroke-width=\"\(number(lineWidth))\"")
+        }
+        return "<path \(attributes.joined(separator: " "))/>"
+    }
+
+    /// The `d` attribute for `path`, in the path's own coordinates.
+    static func pathData(_ path: NSBezierPath) -> String {
+        var commands: [String] = []
+        commands.reserveCapacity(path.elementCount)
+        var points = [NSPoint](repeating: .zero, count: 3)
+        for index in 0 ..< path.elementCount {
+            switch path.element(at: index, associatedPoints: &points) {
+            case .moveTo:
+                commands.append("M\(pair(points[0]))")
+
+            case .lineTo:
+                commands.append("L\(pair(points[0]))")
+
+            case .curveTo, .cubicCurveTo:
+                commands.append("C\(pair(points[0])) \(pair(points[1])) \(pair(points[2]))")
+
+            case .quadraticCurveTo:
+                commands.append("Q\(pair(points[0])) \(pair(points[1]))")
+
+            case .closePath:
+                commands.append("Z")
+
+            @unknown default:
+                continue
+            }
+        }
+        return commands.joined()
+    }
+
+    private static func paint(_ attribute: String, _ color: NSColor?) -> [String] {
+        guard let color, let rgb = color.usingColorSpace(.deviceRGB) else {
+            return ["\(attribute)=\"none\""]
+        }
+        let components = [rgb.redComponent, rgb.greenComponent, rgb.blueComponent].map { Int(($0 * 255).rounded()) }
+        var result = ["\(attribute)=\"rgb(\(components[0]),\(components[1]),\(components[2]))\""]
+        if rgb.alphaComponent < 1 {
+            result.append("\(attribute)-opacity=\"\(number(rgb.alphaComponent))\"")
+        }
+        return result
+    }
+
+    private static func pair(_ point: NSPoint) -> String {
+        "\(number(point.x)),\(number(point.y))"
+    }
+
+    /// Fixed point with trailing zeros removed; keeps files small and output stable across runs.
+    static func number(_ value: CGFloat) -> String {
+        var text = String(format: "%.3f", Double(value))
+        while text.hasSuffix("0") {
+            text.removeLast()
+        }
+        if text.hasSuffix(".") {
+            text.removeLast()
+        }
+        return text == "-0" ? "0" : text
+    }
+}
@@ -0,0 +1,81 @@
+//
+// RoseSVGWriterTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import AppKit
+@testable import PaleoRose
+import Testing
+
+struct RoseSVGWriterTests {
+
+    @Test(
+        "Numbers use at most three decimals without trailing zeros",
+        arguments: [
+            (CGFloat(1), "1"),
+            (CGFloat(-2.5), "-2.5"),
+            (CGFloat(0.1234), "0.123"),
+            (CGFloat(-0.0001), "0"),
+            (CGFloat(100.100), "100.1")
+        ]
+    )
+    func number(value: CGFloat, expected: String) {
+        #expect(RoseSVGWriter.number(value) == expected)
+    }
+
+    @Test("Path data follows the path elements")
+    func pathData() {
+        let path = NSBezierPath()
+        path.move(to: NSPoint(x: 0, y: 0))
+        path.line(to: NSPoint(x: 10, y: 0))
+        path.curve(to: NSPoint(x: 10, y: 10), controlPoint1: NSPoint(x: 12, y: 2), controlPoint2: NSPoint(x: 12, y: 8))
+        path.close()
+
+        #expect(RoseSVGWriter.pathData(path) == "M0,0L10,0C12,2 12,8 10,10Z")
+    }
+
+    @Test("Paths without a fill or stroke say so")
+    func pathPaint() {
+        let path = NSBezierPath(rect: NSRect(x: 0, y: 0, width: 1, height: 1))
+
+        let element = RoseSVGWriter.path(path, stroke: .black, fill: nil, lineWidth: 2)
+
+        #expect(element.hasPrefix("<path d=\"M0,0"))
+        #expect(element.contains("fill=\"none\""))
+        #expect(element.contains("stroke=\"rgb(0,0,0)\""))
+        #expect(element.contains("stroke-width=\"2\""))
+    }
+
+    @Test("Hidden layers are left out")
+    func hiddenLayers() {
+        let layer = XRLayerCore.stub(isVisible: false)
+
+        let svg = RoseSVGWriter(size: CGSize(width: 200, height: 100)).svg(for: [layer])
+
+        #expect(svg.contains("width=\"200\""))
+        #expect(svg.contains("translate(100 50)"))
+        #expect(!svg.contains("<path"))
+    }
+}
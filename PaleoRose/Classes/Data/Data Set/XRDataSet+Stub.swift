@@ -0,0 +1,63 @@
+//
+// XRDataSet+Stub.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import Foundation
+@testable import PaleoRose
+import Testing
+
+extension XRDataSet {
+    /// Equal sectors around the circle, as a test argument
+    struct SectorGeometry: CustomTestStringConvertible {
+        let sectorCount: Int32
+        let startAngle: Float
+        let biDir: Bool
+
+        var sectorSize: Float { 360.0 / Float(sectorCount) }
+        var testDescription: String { "\(sectorCount) sectors from \(startAngle)°\(biDir ? " bi-dir" : "")" }
+    }
+
+    static func stub(values: [Float], name: String = "XRDataSet") throws -> XRDataSet {
+        let data = values.withUnsafeBufferPointer { Data(buffer: $0) }
+        return try #require(XRDataSet(data: data, withName: name))
+    }
+
+    /// `count` angles spread over the circle; each seed gives them in a different order
+    static func stub(count: Int, seed: Int = 0, name: String = "XRDataSet") throws -> XRDataSet {
+        try stub(values: (0 ..< count).map { Float((($0 &+ seed) &* 7919) % 36000) / 100.0 }, name: name)
+    }
+
+    /// Per-sector counts from the exact per-sector counter, the way XRLayerData computed them before
+    /// the sector histogram
+    func legacySectorCounts(_ geometry: SectorGeometry) -> [Int32] {
+        (0 ..< Int(geometry.sectorCount)).map { index in
+            var angle1 = Float(index) * geometry.sectorSize + geometry.startAngle
+            var angle2 = angle1 + geometry.sectorSize
+            if angle1 >= 360.0 { angle1 -= 360.0 }
+            if angle2 >= 360.0 { angle2 -= 360.0 }
+            return valueCount(fromAngle: angle1, toAngle2: angle2, biDir: geometry.biDir)
+        }
+    }
+}
@@ -28,19 +28,71 @@
 
 #import <Foundation/Foundation.h>
 #import "XRoseDocument.h"
+#import "XRCircularResultant.h"
+#import "XRCircularSummary.h"
 #define XRDataSetChangedStatisticsNotification @"XRDataSetChangedStatisticsNotification"
+#define XRDataSetDidAppendValuesNotification @"XRDataSetDidAppendValuesNotification" //posted after appendData:; cached sums and histograms are already up to date
+
+// Read-only view of a data set's values, borrowed without copying. It is only valid until
+// the data set is next mutated (appendData: or appendDataFromFile:encoding:); check with
+// -isValidValueBuffer: before using a buffer that has been held across calls.
+typedef struct {
+	const float *values;
+	NSUInteger count;
+	NSUInteger generation;
+} XRDataSetValueBuffer;
+
+// How a data set holds its values. Hundredths take half the memory of floats; the statistics
+// read them directly, and anything asking for floats gets them decoded.
+typedef NS_ENUM(int, XRDataSetAngleStorage) {
+	XRDataSetAngleStorageFloat = 0, //32-bit floats, as read
+	XRDataSetAngleStorageHundredths = 1, //UInt16 hundredths of a degree, each decoding to the float it was read as
+	XRDataSetAngleStorageRoundedHundredths = 2 //UInt16 hundredths, each value rounded to the nearest hundredth
+};
 
 @class XRStatistic;
+@class XRSectorHistogram;
+@class XRFineAngleHistogram;
+@class XRDataSet;
+
+// Supplies the values of a data set created with a value source. Called on whichever thread first
+// needs them, with the data set's lock held; returns nil if they cannot be read.
+@protocol XRDataSetValueSource <NSObject>
+-(NSData *)valuesForDataSet:(XRDataSet *)dataSet NS_SWIFT_NAME(values(for:));
+@optional
+//counts the values where they are stored, for a set whose values have not been read; nil to read them instead
+-(XRSectorHistogram *)sectorHistogramForDataSet:(XRDataSet *)dataSet startAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDirectional:(BOOL)isBiDir NS_SWIFT_NAME(sectorHistogram(for:startAngle:sectorSize:sectorCount:biDirectional:));
+@end
+
 @interface XRDataSet : NSObject {
-	NSMutableData *_theValues;
+	NSData *_theValues; //an NSMutableData when _ownsValues, otherwise borrowed until the first append; nil until a deferred set is loaded
+	NSData *_angleHundredths; //XRAngleHundredths in the compact storages, when _theValues is only decoded from them
+	XRDataSetAngleStorage _angleStorage;
+	XRDataSetAngleStorage _storageWhenLoaded; //recorded for a deferred set, and applied once its values are read
+	BOOL _ownsValues;
+	id<XRDataSetValueSource> _valueSource; //set while the values can be read again, so they may be evicted
 	NSString *_name;
 	NSMutableAttributedString *_comments;
 	//statistics
-	NSMutableArray *_circularStatistics;
+	XRCircularSummary _summary; //zeroed until statistics are first calculated
+	BOOL _hasSummary;
+	//a sector summary that waits for the statistics to be asked for, because its values are unread
+	BOOL _summaryPending;
+	BOOL _pendingBiDir;
+	float _pendingStartAngle;
+	float _pendingSectorSize;
+	NSMutableArray *_circularStatistics; //view of _summary, built on demand
+	NSDictionary *_statisticsByName;
 	NSString *predicate;
 	NSString *tableName;
 	NSString *columnName;
     int _setId;
+	NSMutableArray *_sectorHistograms; //counts for recently requested geometries, most recent last; kept current on append
+	XRFineAngleHistogram *_fineHistogram; //0.01 degree counts that answer sectors on bin edges; built on first use, kept current on append
+	NSUInteger _generation; //incremented on every mutation of _theValues
+	//running unidirectional sums for the standard [0] and doubled-angle [1] methods, kept current on append
+	XRCircularResultant _runningResultant[2];
+	BOOL _hasRunningResultant[2];
 
 }
 
@@ -48,9 +100,46 @@
 
 -(id)initWithData:(NSData *)theData withName:(NSString *)name;
 -(id)initWithId:(int)setId name:(NSString *)name tableName:(NSString *)table column:(NSString *)column predicate:(NSString *)aPredicate comments:(NSAttributedString *)comments data:(NSData *)data;
+//keeps valueData, for example a memory-mapped column, instead of copying it; it is copied on the first append
+-(id)initWithId:(int)setId name:(NSString *)name tableName:(NSString *)table column:(NSString *)column predicate:(NSString *)aPredicate comments:(NSAttributedString *)comments valuesNoCopy:(NSData *)valueData;
+//deferred: holds only the query until statistics, a histogram or the values are first asked for
+-(id)initWithId:(int)setId name:(NSString *)name tableName:(NSString *)table column:(NSString *)column predicate:(NSString *)aPredicate comments:(NSAttributedString *)comments valueSource:(id<XRDataSetValueSource>)source;
 #pragma mark accessors
 
 -(NSData *)theData;
+-(XRDataSetValueBuffer)valueBuffer;
+-(BOOL)isValidValueBuffer:(XRDataSetValueBuffer)buffer;
+-(NSUInteger)valueCount;
+-(BOOL)ownsValues;
+
+#pragma mark Deferred values
+//NO for a deferred set until its values are read, and again after they are evicted
+-(BOOL)hasLoadedValues;
+-(void)loadValues;
+//releases values the value source can read again, keeping cached histograms and vector sums;
+//NO once the set has been appended to or has no source. Floats decoded from hundredths can always
+//be released. Call on the main thread.
+-(BOOL)evictValues;
+//loads the values and keeps them, for when the source is about to stop matching the set
+-(void)detachValueSource;
+-(id<XRDataSetValueSource>)valueSource;
+
+#pragma mark Angle storage
+-(XRDataSetAngleStorage)angleStorage;
+//stores the values as hundredths of a degree. Losslessly succeeds only if every value decodes back
+//to the same float; otherwise each value is rounded, which discards the cached counts and sums.
+//NO, with the values left as they were, when they cannot be stored that way.
+-(BOOL)storeAnglesAsHundredthsLosslessly:(BOOL)lossless NS_SWIFT_NAME(storeAnglesAsHundredths(losslessly:));
+//for a deferred set: stores the values that way as soon as they are read
+-(void)setAngleStorageWhenLoaded:(XRDataSetAngleStorage)storage;
+//decodes the values back to owned floats; appending does this only for values that cannot be stored as hundredths
+-(void)storeAnglesAsFloats;
+//bytes held for the values, counting floats decoded from hundredths until they are evicted
+-(NSUInteger)valueStorageBytes;
+
+//number of times, and total bytes, that this data set copied a value buffer
+-(NSUInteger)valueCopyCount;
+-(NSUInteger)valueCopyBytes;
 
 -(NSString *)name;
 -(void)setName:(NSString *)name;
@@ -75,12 +164,27 @@
 
 #pragma mark Statistics
 
+//the most recently calculated statistics; read fields here rather than looking up names
+-(XRCircularSummary)circularSummary;
+-(XRCircularSummary)calculateCircularSummaryForBiDir:(BOOL)isBiDir;
+//does not replace the current statistics or post a notification; safe off the main thread
+-(XRCircularSummary)circularSummaryForBiDir:(BOOL)isBiDir;
++(int)vectorCalculationMethod;
+-(XRCircularSummary)calculateCircularSummaryForBiDir:(BOOL)isBiDir startAngle:(float)startAngle sectorSize:(float)sectorSize;
+//calculated by the next call to circularSummary or currentStatistics, so it reads the values only when shown
+-(void)deferCircularSummaryForBiDir:(BOOL)isBiDir startAngle:(float)startAngle sectorSize:(float)sectorSize;
+
+//XRStatistic objects for display, built from the summary when first asked for
 -(NSArray *)currentStatistics;
 -(XRStatistic *)currentStatisticWithName:(NSString *)name;
 
 -(int)valueCountFromAngle:(float)angle1 toAngle2:(float)angle2;
 -(int)valueCountFromAngle:(float)angle1 toAngle2:(float)angle2 biDir:(BOOL)biDir;
 
+//the histogram and resultant caches are locked, so these two may be called off the main thread
+-(XRSectorHistogram *)sectorHistogramWithStartAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDir:(BOOL)biDir;
+-(XRSectorHistogram *)sectorHistogramWithStartAngle:(float)startAngle sectorSize:(float)sectorSize biDir:(BOOL)biDir;
+
 -(NSDictionary *)meanCountWithIncrement:(float)angleIncrement startingAngle:(float)startAngle isBiDirectional:(BOOL)isBiDir;
 
 -(float)standardDeviation:(NSArray *)anArray mean:(float)mean;
@@ -91,6 +195,7 @@
 
 -(void)calculateNonSectorStatisticsForBiDirection:(BOOL)isBiDir;
 
+-(XRCircularResultant)circularResultant:(BOOL)isBiDir;
 -(void)computeXVector:(BOOL)isBiDir;
 -(void)computeYVector:(BOOL)isBiDir;
 
@@ -112,6 +217,7 @@
 -(float)standardDeviationForIntArray:(int *)array count:(int)count expected:(float)expected;
 
 -(NSString *)statisticsDescription;
++(NSString *)statisticsDescriptionForSummary:(XRCircularSummary)summary;
 
 #pragma mark Mutability
 -(void)appendData:(NSData *)data;
@@ -29,9 +29,49 @@
 #import "XRDataSet.h"
 #import <math.h>
 #import "XRStatistic.h"
+#import "XRSectorHistogram.h"
+#import "XRFineAngleHistogram.h"
+#import <stdatomic.h>
+
+#define XRDataSetMaxCachedHistograms 8
+#define XRDataSetDecodeBlockSize 4096
+
+@interface XRDataSet() {
+	//copies of this set's value buffers, counted per set so concurrent tests do not see each other's
+	atomic_ulong _valueCopyCount;
+	atomic_ulong _valueCopyBytes;
+}
+-(void)recordValueCopy:(NSUInteger)length;
+-(void)calculatePendingSummary;
+-(NSData *)loadedValues;
+-(void)valuesWillChange;
+-(NSMutableData *)mutableValues;
+-(void)appendValues:(const float *)values count:(NSUInteger)count;
+-(XRSectorHistogram *)cachedSectorHistogramWithStartAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDir:(BOOL)biDir;
+-(XRSectorHistogram *)hundredthsSectorHistogramWithStartAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDir:(BOOL)biDir;
+-(NSMutableData *)hundredthsForValues:(const float *)values count:(NSUInteger)count losslessly:(BOOL)lossless rounded:(BOOL *)rounded;
+-(void)appendHundredths:(NSData *)encoded;
+-(void)discardCachedCounts;
+@end
 
 @implementation XRDataSet
 
+-(NSUInteger)valueCopyCount
+{
+	return atomic_load(&_valueCopyCount);
+}
+
+-(NSUInteger)valueCopyBytes
+{
+	return atomic_load(&_valueCopyBytes);
+}
+
+-(void)recordValueCopy:(NSUInteger)length
+{
+	atomic_fetch_add(&_valueCopyCount, 1);
+	atomic_fetch_add(&_valueCopyBytes, length);
+}
+
 #pragma mark Initers
 
 -(id)initWithData:(NSData *)data withName:(NSString *)name
@@ -39,35 +79,256 @@
     if (!(self = [super init])) return nil;
     if(self)
     {
-        _theValues = [[NSMutableData alloc] init];
+        _theValues = [[NSMutableData alloc] initWithData:data];
+        _ownsValues = YES;
         _name = name;
-        [_theValues appendData:data];
+        [self recordValueCopy:[data length]];
     }
     return self;
 }
 
 -(id)initWithId:(int)setId name:(NSString *)name tableName:(NSString *)table column:(NSString *)column predicate:(NSString *)aPredicate comments:(NSAttributedString *)comments data:(NSData *)data {
+    if (!(self = [self initWithId:setId name:name tableName:table column:column predicate:aPredicate comments:comments valuesNoCopy:[[NSMutableData alloc] initWithData:data]])) return nil;
+    _ownsValues = YES;
+    [self recordValueCopy:[data length]];
+    return self;
+}
+
+-(id)initWithId:(int)setId name:(NSString *)name tableName:(NSString *)table column:(NSString *)column predicate:(NSString *)aPredicate comments:(NSAttributedString *)comments valuesNoCopy:(NSData *)valueData {
     if (!(self = [super init])) return nil;
     if(self)
     {
-        _theValues = [[NSMutableData alloc] init];
+        _theValues = valueData;
+        _ownsValues = NO;
         _name = name;
         _setId = setId;
         tableName = table;
         columnName = column;
         predicate = aPredicate;
         _comments = [[NSMutableAttributedString alloc] initWithAttributedString:comments];
-
-        [_theValues appendData:data];
     }
     return self;
 }
 
+-(id)initWithId:(int)setId name:(NSString *)name tableName:(NSString *)table column:(NSString *)column predicate:(NSString *)aPredicate comments:(NSAttributedString *)comments valueSource:(id<XRDataSetValueSource>)source {
+    if (!(self = [self initWithId:setId name:name tableName:table column:column predicate:aPredicate comments:comments valuesNoCopy:nil])) return nil;
+    _valueSource = source;
+    return self;
+}
+
 #pragma mark Accessors
 
 -(NSData *)theData
 {
-	return [NSData dataWithData:_theValues];
+	NSData *values = [self loadedValues];
+	[self recordValueCopy:[values length]];
+	return [NSData dataWithData:values];
+}
+
+-(XRDataSetValueBuffer)valueBuffer
+{
+	XRDataSetValueBuffer buffer;
+	@synchronized(self)
+	{
+		NSData *values = [self loadedValues];
+		buffer.values = (const float *)[values bytes];
+		buffer.count = [values length]/sizeof(float);
+		buffer.generation = _generation;
+	}
+	return buffer;
+}
+
+-(BOOL)isValidValueBuffer:(XRDataSetValueBuffer)buffer
+{
+	@synchronized(self)
+	{
+		return (buffer.generation == _generation) && (buffer.values == (const float *)[_theValues bytes]);
+	}
+}
+
+-(NSUInteger)valueCount
+{
+	@synchronized(self)
+	{
+		if(_angleHundredths)
+			return [_angleHundredths length]/sizeof(XRAngleHundredths);
+	}
+	return [[self loadedValues] length]/sizeof(float);
+}
+
+-(BOOL)ownsValues
+{
+	return _ownsValues;
+}
+
+#pragma mark Deferred values
+
+-(NSData *)loadedValues
+{
+	@synchronized(self)
+	{
+		if(!_theValues && !_angleHundredths)
+		{
+			_theValues = [_valueSource valuesForDataSet:self];
+			if(!_theValues)
+			{
+				NSLog(@"XRDataSet %@ could not read its values from %@.%@", _name, tableName, columnName);
+				_theValues = [NSData data];
+			}
+			else if(_storageWhenLoaded != XRDataSetAngleStorageFloat)
+				[self storeAnglesAsHundredthsLosslessly:_storageWhenLoaded == XRDataSetAngleStorageHundredths];
+		}
+		if(!_theValues && _angleHundredths)
+		{
+			const XRAngleHundredths *hundredths = (const XRAngleHundredths *)[_angleHundredths bytes];
+			NSUInteger count = [_angleHundredths length]/sizeof(XRAngleHundredths);
+			NSMutableData *decoded = [NSMutableData dataWithLength:count * sizeof(float)];
+			float *values = (float *)[decoded mutableBytes];
+			for(NSUInteger n=0;n<count;n++)
+				values[n] = XRAngleHundredthsToDegrees(hundredths[n]);
+			_theValues = decoded;
+		}
+		return _theValues;
+	}
+}
+
+-(BOOL)hasLoadedValues
+{
+	@synchronized(self)
+	{
+		return _theValues != nil || _angleHundredths != nil;
+	}
+}
+
+-(void)loadValues
+{
+	[self loadedValues];
+}
+
+-(BOOL)evictValues
+{
+	@synchronized(self)
+	{
+		if(_angleHundredths && _theValues)
+		{
+			[self valuesWillChange];
+			_theValues = nil;
+			return YES;
+		}
+		if(!_valueSource || _ownsValues || !_theValues)
+			return NO;
+		[self valuesWillChange];
+		_theValues = nil;
+		return YES;
+	}
+}
+
+-(void)detachValueSource
+{
+	@synchronized(self)
+	{
+		[self loadedValues];
+		_valueSource = nil;
+	}
+}
+
+-(id<XRDataSetValueSource>)valueSource
+{
+	@synchronized(self)
+	{
+		return _valueSource;
+	}
+}
+
+#pragma mark Angle storage
+
+-(XRDataSetAngleStorage)angleStorage
+{
+	@synchronized(self)
+	{
+		return _angleStorage;
+	}
+}
+
+-(void)setAngleStorageWhenLoaded:(XRDataSetAngleStorage)storage
+{
+	@synchronized(self)
+	{
+		_storageWhenLoaded = storage;
+	}
+}
+
+-(BOOL)storeAnglesAsHundredthsLosslessly:(BOOL)lossless
+{
+	@synchronized(self)
+	{
+		NSData *values = [self loadedValues];
+		BOOL rounded = NO;
+		NSMutableData *hundredthsData = [self hundredthsForValues:(const float *)[values bytes]
+															count:[values length]/sizeof(float)
+													   losslessly:lossless
+														  rounded:&rounded];
+		if(!hundredthsData)
+			return NO;
+		//counts and sums of exactly encoded values still hold
+		if(rounded)
+			[self discardCachedCounts];
+		[self valuesWillChange];
+		_angleHundredths = hundredthsData;
+		_angleStorage = lossless ? XRDataSetAngleStorageHundredths : XRDataSetAngleStorageRoundedHundredths;
+		_theValues = nil;
+		_ownsValues = NO;
+		_valueSource = nil;
+		return YES;
+	}
+}
+
+//nil if a value cannot be stored as hundredths; rounded is set if any value had to be rounded
+-(NSMutableData *)hundredthsForValues:(const float *)values count:(NSUInteger)count losslessly:(BOOL)lossless rounded:(BOOL *)rounded
+{
+	NSMutableData *hundredthsData = [NSMutableData dataWithLength:count * sizeof(XRAngleHundredths)];
+	XRAngleHundredths *hundredths = (XRAngleHundredths *)[hundredthsData mutableBytes];
+	for(NSUInteger n=0;n<count;n++)
+	{
+		if(XRAngleHundredthsFromDegreesExactly(values[n], &hundredths[n]))
+			continue;
+		if(lossless || !XRAngleHundredthsFromDegreesRounded(values[n], &hundredths[n]))
+			return nil;
+		*rounded = YES;
+	}
+	return hundredthsData;
+}
+
+-(void)storeAnglesAsFloats
+{
+	@synchronized(self)
+	{
+		_storageWhenLoaded = XRDataSetAngleStorageFloat;
+		if(!_angleHundredths)
+			return;
+		//decoded into an NSMutableData, which the set now owns
+		[self loadedValues];
+		_angleHundredths = nil;
+		_angleStorage = XRDataSetAngleStorageFloat;
+		_ownsValues = YES;
+	}
+}
+
+-(NSUInteger)valueStorageBytes
+{
+	@synchronized(self)
+	{
+		return [_theValues length] + [_angleHundredths length];
+	}
+}
+
+//called with the lock held when the values themselves change
+-(void)discardCachedCounts
+{
+	[_sectorHistograms removeAllObjects];
+	_fineHistogram = nil;
+	_hasRunningResultant[0] = NO;
+	_hasRunningResultant[1] = NO;
 }
 
 -(NSString *)name
@@ -133,7 +394,7 @@
 {
     NSMutableDictionary *theDict = [[NSMutableDictionary alloc] init];
     //NSLog(@"creating dataSetDictionary");
-    [theDict setObject:_theValues forKey:@"values"];
+    [theDict setObject:[self loadedValues] forKey:@"values"];
     //NSLog(@"1");
     [theDict setObject:_name forKey:@"name"];
     //NSLog(@"2");
@@ -145,34 +406,91 @@
 
 #pragma mark Statistics
 
+-(XRCircularSummary)circularSummary
+{
+	[self calculatePendingSummary];
+	return _summary;
+}
+
+-(void)deferCircularSummaryForBiDir:(BOOL)isBiDir startAngle:(float)startAngle sectorSize:(float)sectorSize
+{
+	_summaryPending = YES;
+	_pendingBiDir = isBiDir;
+	_pendingStartAngle = startAngle;
+	_pendingSectorSize = sectorSize;
+	[self statisticsDidChange];
+}
+
+-(void)calculatePendingSummary
+{
+	if(_summaryPending)
+		[self calculateCircularSummaryForBiDir:_pendingBiDir startAngle:_pendingStartAngle sectorSize:_pendingSectorSize];
+}
+
+-(void)statisticsDidChange
+{
+	_circularStatistics = nil;
+	_statisticsByName = nil;
+	[[NSNotificationCenter defaultCenter] postNotificationName:XRDataSetChangedStatisticsNotification object:self];
+}
+
 -(NSArray *)currentStatistics
 {
-    return _circularStatistics;
+	[self calculatePendingSummary];
+	if(!_circularStatistics && _hasSummary)
+		_circularStatistics = [XRDataSet statisticsForSummary:_summary];
+	return _circularStatistics;
 }
 
 -(XRStatistic *)currentStatisticWithName:(NSString *)name
 {
-    NSEnumerator *anEnum =  [_circularStatistics objectEnumerator];
-    XRStatistic *aStat;
-    while(aStat = [anEnum nextObject])
-    {
-        if([aStat.statisticName isEqualToString:name])
-        {
-            return aStat;
-        }
-    }
-    return nil;
+	if(!_statisticsByName)
+	{
+		NSMutableDictionary *index = [[NSMutableDictionary alloc] init];
+		//first occurrence wins, as the old linear search did
+		for(XRStatistic *aStat in [[self currentStatistics] reverseObjectEnumerator])
+			[index setObject:aStat forKey:aStat.statisticName];
+		_statisticsByName = index;
+	}
+	return [_statisticsByName objectForKey:name];
+}
+
+//the same names, order and float values the statistics were always reported with
++(NSMutableArray *)statisticsForSummary:(XRCircularSummary)summary
+{
+	NSMutableArray *statistics = [[NSMutableArray alloc] init];
+	XRStatistic *aStat;
+	[statistics addObject:[XRStatistic statisticWithName:@"N" withIntValue:summary.count]];
+	if(summary.biDirectional)
+		[statistics addObject:[XRStatistic statisticWithName:@"N (Bi-Dir)" withIntValue:summary.count * 2]];
+	[statistics addObjectsFromArray:[XRDataSet xVectorStatisticsForResultant:summary.resultant]];
+	[statistics addObjectsFromArray:[XRDataSet yVectorStatisticsForResultant:summary.resultant]];
+	aStat = [XRStatistic statisticWithName:[NSString stringWithUTF8String:"θ̅"] withFloatValue:summary.meanDirection];
+	[aStat setASCIIName:@"Mean Direction"];
+	[statistics addObject:aStat];
+	aStat = [XRStatistic statisticWithName:[NSString stringWithUTF8String:"R"] withFloatValue:summary.resultantLength];
+	[aStat setASCIIName:@"Resultant Length (R)"];
+	[statistics addObject:aStat];
+	[statistics addObject:[XRStatistic statisticWithName:@"Circular Varience" withFloatValue:summary.circularVariance]];
+	aStat = [XRStatistic statisticWithName:[NSString stringWithUTF8String:"R̅"] withFloatValue:summary.meanResultantLength];
+	[aStat setASCIIName:@"Mean Resultant Length (R-Bar)"];
+	[statistics addObject:aStat];
+	[statistics addObject:[XRStatistic statisticWithName:@"Rayleigh Probability" withFloatValue:summary.rayleighProbability]];
+	[statistics addObject:[XRDataSet kappaStatistic:summary.kappa]];
+	[statistics addObject:[XRDataSet standardErrorStatistic:summary.standardError]];
+	[statistics addObject:[XRDataSet angleIntervalStatistic:summary.confidenceInterval]];
+	if(summary.hasChiSquared)
+		[statistics addObject:[XRDataSet chiSquaredStatisticWithSectorCount:summary.chiSquaredSectorCount expectedFrequency:summary.chiSquaredExpectedFrequency]];
+	return statistics;
 }
 
 -(int)valueCountFromAngle:(float)angle1 toAngle2:(float)angle2
 {
 	float aValue;
-	//NSLog(@"valueCountFromAngle1");
-	float *valueArray = (float *)malloc([_theValues length]);
+	XRDataSetValueBuffer buffer = [self valueBuffer];
+	const float *valueArray = buffer.values;
 	int count;
-	//NSLog(@"valueCountFromAngle2");
-	int values = (int)([_theValues length]/sizeof(float));
-    [_theValues getBytes:valueArray length:[_theValues length]];
+	int values = (int)buffer.count;
 	count = 0;
 
 	for(int i=0;i<values;i++)
@@ -192,7 +510,6 @@
 		}
 	}
 
-	free(valueArray);
 	return count;
 }
 
@@ -214,31 +531,119 @@
 	return count;
 }
 
+//may be called from SectorRecomputeScheduler's queue; the cache is guarded by the data set's lock
+-(XRSectorHistogram *)sectorHistogramWithStartAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDir:(BOOL)biDir
+{
+	id<XRDataSetValueSource> source = nil;
+	@synchronized(self)
+	{
+		XRSectorHistogram *histogram = [self cachedSectorHistogramWithStartAngle:startAngle sectorSize:sectorSize sectorCount:sectorCount biDir:biDir];
+		if(histogram)
+			return histogram;
+		//the source counts the stored floats, which rounded storage would have changed
+		if(!_theValues && _storageWhenLoaded != XRDataSetAngleStorageRoundedHundredths
+		   && [_valueSource respondsToSelector:@selector(sectorHistogramForDataSet:startAngle:sectorSize:sectorCount:biDirectional:)])
+			source = _valueSource;
+	}
+	//counting in the source scans the whole table, so it runs without the lock
+	XRSectorHistogram *counted = [source sectorHistogramForDataSet:self startAngle:startAngle sectorSize:sectorSize sectorCount:sectorCount biDirectional:biDir];
+	@synchronized(self)
+	{
+		XRSectorHistogram *histogram = [self cachedSectorHistogramWithStartAngle:startAngle sectorSize:sectorSize sectorCount:sectorCount biDir:biDir];
+		if(histogram)
+			return histogram;
+		//an append while counting detaches the source, and the counts are then out of date
+		if(counted && _valueSource == source)
+			histogram = counted;
+		if(!histogram && !_fineHistogram && [XRFineAngleHistogram isBinEdge:startAngle] && [XRFineAngleHistogram isBinEdge:sectorSize])
+		{
+			//one pass that later geometries on bin edges, such as those of a dragged start angle, are read from
+			if(_angleHundredths)
+				_fineHistogram = [XRFineAngleHistogram histogramWithHundredths:(const XRAngleHundredths *)[_angleHundredths bytes]
+																		 count:[_angleHundredths length]/sizeof(XRAngleHundredths)];
+			else
+			{
+				XRDataSetValueBuffer buffer = [self valueBuffer];
+				_fineHistogram = [XRFineAngleHistogram histogramWithValues:buffer.values count:buffer.count];
+			}
+			histogram = [_fineHistogram sectorHistogramWithStartAngle:startAngle sectorSize:sectorSize sectorCount:sectorCount biDirectional:biDir];
+		}
+		if(!histogram && _angleHundredths && !_theValues)
+			histogram = [self hundredthsSectorHistogramWithStartAngle:startAngle sectorSize:sectorSize sectorCount:sectorCount biDir:biDir];
+		if(!histogram)
+		{
+			XRDataSetValueBuffer buffer = [self valueBuffer];
+			histogram = [XRSectorHistogram histogramWithValues:buffer.values
+														 count:buffer.count
+													startAngle:startAngle
+													sectorSize:sectorSize
+												   sectorCount:sectorCount
+												 biDirectional:biDir];
+		}
+		if([_sectorHistograms count] >= XRDataSetMaxCachedHistograms)
+			[_sectorHistograms removeObjectAtIndex:0];
+		[_sectorHistograms addObject:histogram];
+		return histogram;
+	}
+}
+
+//a cached histogram, or one read from the fine counts, made most recent; called with the lock held
+-(XRSectorHistogram *)cachedSectorHistogramWithStartAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDir:(BOOL)biDir
+{
+	if(!_sectorHistograms)
+		_sectorHistograms = [[NSMutableArray alloc] init];
+	for(XRSectorHistogram *histogram in _sectorHistograms)
+	{
+		if([histogram matchesStartAngle:startAngle sectorSize:sectorSize sectorCount:sectorCount biDirectional:biDir])
+		{
+			[_sectorHistograms removeObjectIdenticalTo:histogram];
+			[_sectorHistograms addObject:histogram];
+			return histogram;
+		}
+	}
+	XRSectorHistogram *histogram = [_fineHistogram sectorHistogramWithStartAngle:startAngle sectorSize:sectorSize sectorCount:sectorCount biDirectional:biDir];
+	if(histogram)
+	{
+		if([_sectorHistograms count] >= XRDataSetMaxCachedHistograms)
+			[_sectorHistograms removeObjectAtIndex:0];
+		[_sectorHistograms addObject:histogram];
+	}
+	return histogram;
+}
+
+//counts compact values a block at a time, without keeping the decoded floats; called with the lock held
+-(XRSectorHistogram *)hundredthsSectorHistogramWithStartAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDir:(BOOL)biDir
+{
+	XRSectorHistogram *histogram = [XRSectorHistogram histogramWithValues:NULL count:0 startAngle:startAngle sectorSize:sectorSize sectorCount:sectorCount biDirectional:biDir];
+	const XRAngleHundredths *hundredths = (const XRAngleHundredths *)[_angleHundredths bytes];
+	NSUInteger count = [_angleHundredths length]/sizeof(XRAngleHundredths);
+	float block[XRDataSetDecodeBlockSize];
+	for(NSUInteger start=0;start<count;start+=XRDataSetDecodeBlockSize)
+	{
+		NSUInteger blockCount = MIN(count - start, (NSUInteger)XRDataSetDecodeBlockSize);
+		for(NSUInteger n=0;n<blockCount;n++)
+			block[n] = XRAngleHundredthsToDegrees(hundredths[start + n]);
+		[histogram addValues:block count:blockCount];
+	}
+	return histogram;
+}
+
+-(XRSectorHistogram *)sectorHistogramWithStartAngle:(float)startAngle sectorSize:(float)sectorSize biDir:(BOOL)biDir
+{
+	//rounded so that sizes such as 360/7 still produce the geometry's sector count
+	int sectorCount = (int)lroundf(360.0/sectorSize);
+	return [self sectorHistogramWithStartAngle:startAngle sectorSize:sectorSize sectorCount:sectorCount biDir:biDir];
+}
+
 -(NSDictionary *)meanCountWithIncrement:(float)angleIncrement startingAngle:(float)startAngle isBiDirectional:(BOOL)isBiDir
 {
-	int total;
-	int result;
-	float angle1;
-	float angle2;
 	float mean;
 	float sd;
-	int totalIncrements = (int)(360.0/angleIncrement);
-	NSMutableArray *anArray = [[NSMutableArray alloc] init];
-	total = 0;
-	for(int i=0;i<totalIncrements;i++)
-	{
-		angle1 = (i * angleIncrement) + startAngle;
-		angle2 = angle1 + angleIncrement;
-		if(angle1>360.0)
-			angle1 = angle1 - 360.0;
-		if(angle2>360.0)
-			angle2 = angle2 - 360.0;
-		result = [self valueCountFromAngle:angle1 toAngle2:angle2 biDir:isBiDir];
-		total += result;
-		[anArray addObject:[NSNumber numberWithInt:result]];
-	}
-	mean = (float)total / (float)totalIncrements;
-	sd = [self standardDeviation:anArray mean:(float)mean];
+	XRSectorHistogram *histogram = [self sectorHistogramWithStartAngle:startAngle sectorSize:angleIncrement biDir:isBiDir];
+	int totalIncrements = [histogram sectorCount];
+
+	mean = (float)[histogram totalCount] / (float)totalIncrements;
+	sd = [self standardDeviation:[histogram countArray] mean:(float)mean];
 
 	return [NSDictionary dictionaryWithObjects:[NSArray arrayWithObjects:[NSNumber numberWithFloat:mean],[NSNumber numberWithFloat:sd],nil]
 									   forKeys:[NSArray arrayWithObjects:@"mean",@"sd",nil]];
@@ -261,266 +666,155 @@
 }
 
 //grid dependent statistics
+-(XRCircularSummary)calculateCircularSummaryForBiDir:(BOOL)isBiDir startAngle:(float)startAngle sectorSize:(float)sectorSize
+{
+	XRSectorHistogram *histogram = [self sectorHistogramWithStartAngle:startAngle sectorSize:sectorSize biDir:isBiDir];
+	[self calculateNonSectorStatisticsForBiDirection:isBiDir];
+	_summary.hasChiSquared = true;
+	_summary.chiSquaredSectorCount = [histogram sectorCount];
+	_summary.chiSquaredExpectedFrequency = (float)[histogram totalCount]/(float)[histogram sectorCount];
+	[self statisticsDidChange];
+	return _summary;
+}
+
 -(NSArray *)calculateStatisticObjectsForBiDir:(BOOL)isBiDir startAngle:(float)startAngle sectorSize:(float)sectorSize
 {
-	[self calculateStatisticObjectsForBiDir:isBiDir];
-	[_circularStatistics addObject:[self chiSquaredWithStartAngle:startAngle sectorSize:sectorSize isBiDir:isBiDir]];
-	[[NSNotificationCenter defaultCenter] postNotificationName:XRDataSetChangedStatisticsNotification object:self];
-	return _circularStatistics;
+	[self calculateCircularSummaryForBiDir:isBiDir startAngle:startAngle sectorSize:sectorSize];
+	return [self currentStatistics];
 }
 //grid independent statistics
 
--(NSArray *)calculateStatisticObjectsForBiDir:(BOOL)isBiDir
+-(XRCircularSummary)calculateCircularSummaryForBiDir:(BOOL)isBiDir
 {
-	
-	XRStatistic *aStat;
-	if(_circularStatistics)
-		[_circularStatistics removeAllObjects];
-	else
-		_circularStatistics = [[NSMutableArray alloc] init];
-	
-	//XRStatistic *aStat;
-	//General Statistics
-	//count
-	aStat = [XRStatistic statisticWithName:@"N" withIntValue:(int)[_theValues length]/4];
-	[_circularStatistics addObject:aStat];
-	//bidir count
-	if(isBiDir)
-	{
-	aStat = [XRStatistic statisticWithName:@"N (Bi-Dir)" withIntValue:(int)[_theValues length]/2];
-	[_circularStatistics addObject:aStat];
-	}
-	//unidirectional stats
-	//aStat = [XRStatistic emptyStatisticWithName:@"Unidirectional Statistics"];
-	//[_circularStatistics addObject:aStat];
 	[self calculateNonSectorStatisticsForBiDirection:isBiDir];
-	[[NSNotificationCenter defaultCenter] postNotificationName:XRDataSetChangedStatisticsNotification object:self];
-	return _circularStatistics;
+	[self statisticsDidChange];
+	return _summary;
+}
+
+-(NSArray *)calculateStatisticObjectsForBiDir:(BOOL)isBiDir
+{
+	[self calculateCircularSummaryForBiDir:isBiDir];
+	return [self currentStatistics];
+}
+
++(int)vectorCalculationMethod
+{
+	return [[[NSUserDefaults standardUserDefaults] objectForKey:@"vectorCalculationMethod"] intValue];
+}
+
+//built from the cached running sums only; leaves currentStatistics alone and posts nothing
+-(XRCircularSummary)circularSummaryForBiDir:(BOOL)isBiDir
+{
+	XRCircularResultant resultant = [self circularResultant:isBiDir];
+	return XRCircularSummaryMake(resultant, (int)(resultant.count / (isBiDir ? 2 : 1)), isBiDir, [XRDataSet vectorCalculationMethod]);
 }
 
 -(void)calculateNonSectorStatisticsForBiDirection:(BOOL)isBiDir
 {
-	float sumXVector,sumXVectorCBar;
-	float sumYVector,sumYVectorSBar;
-	float meanDir;
-	int rbarPosition;
-	int kappaPosition;
-	int standErrorPosition;
-	int calculationType = [[[NSUserDefaults standardUserDefaults] objectForKey:@"vectorCalculationMethod"] intValue];
-	//this section is affected by the calculation approach 
-	[self computeXVector:isBiDir];
-	sumXVector = [[_circularStatistics objectAtIndex:[_circularStatistics count]-2] floatValue];
-	sumXVectorCBar = [[_circularStatistics objectAtIndex:[_circularStatistics count]-1] floatValue];
-	[self computeYVector:isBiDir];
-	sumYVector = [[_circularStatistics objectAtIndex:[_circularStatistics count]-2] floatValue];
-	sumYVectorSBar = [[_circularStatistics objectAtIndex:[_circularStatistics count]-1] floatValue];
-
-	meanDir = (float)[self degreesFromRadians:atan2((double)sumYVector,(double)sumXVector)];
-	//NSLog(@"%f %f %f %f %f",sumXVector, sumXVectorCBar, sumYVector, sumYVectorSBar,meanDir);
-	if(meanDir < 0.0)
-		meanDir += 360.0;
-	if(calculationType==0)
-		meanDir = meanDir/2.0;
-	//end calculation approach
-	
-	[_circularStatistics addObject:[XRStatistic statisticWithName:[NSString stringWithUTF8String:"θ̅"] withFloatValue:meanDir]];
-	[[_circularStatistics lastObject] setASCIIName:@"Mean Direction"];
-	//@"Resultant Length (R)"
-	[_circularStatistics addObject:[XRStatistic statisticWithName:[NSString stringWithUTF8String:"R"] withFloatValue:sqrt((sumXVector*sumXVector)+(sumYVector*sumYVector))]];
-	[[_circularStatistics lastObject] setASCIIName:@"Resultant Length (R)"];
-	//@"Mean Resultant Length (R-Bar)" 
-	[_circularStatistics addObject:[XRStatistic statisticWithName:@"Circular Varience" withFloatValue:(1.0-sqrt((sumXVectorCBar*sumXVectorCBar)+(sumYVectorSBar*sumYVectorSBar)))]];
-	[_circularStatistics addObject:[XRStatistic statisticWithName:[NSString stringWithUTF8String:"R̅"] withFloatValue:sqrt((sumXVectorCBar*sumXVectorCBar)+(sumYVectorSBar*sumYVectorSBar))]];
-	[[_circularStatistics lastObject] setASCIIName:@"Mean Resultant Length (R-Bar)"];
-	rbarPosition = (int)[_circularStatistics count] - 1;
-	[_circularStatistics addObject:[self calculateRayleighForRBar:[_circularStatistics objectAtIndex:rbarPosition]]];
-	[_circularStatistics addObject:[self calculateKappaForRBar:[_circularStatistics objectAtIndex:rbarPosition]]];
-	kappaPosition = (int)[_circularStatistics count] - 1;
-	[_circularStatistics addObject:[self calculateStandardErrorWithN:(int)[_theValues length]/4 rbar:[_circularStatistics objectAtIndex:rbarPosition] kappa:[_circularStatistics objectAtIndex:kappaPosition]]];
-	standErrorPosition = (int)[_circularStatistics count] -1;
-	[_circularStatistics addObject:[self calculateAngleIntervalWithStandardError:[_circularStatistics objectAtIndex:standErrorPosition]]];
+	_summary = [self circularSummaryForBiDir:isBiDir];
+	_hasSummary = YES;
+	_summaryPending = NO;
+	_circularStatistics = nil;
+	_statisticsByName = nil;
 }
 
--(void)computeXVector:(BOOL)isBiDir
+//X and Y vectors come from a single fused pass over the values; see XRCircularResultant.h
+-(XRCircularResultant)circularResultant:(BOOL)isBiDir
 {
-	float *values = (float *)malloc([_theValues length]);
-	float _sumXVector;
-	float _sumXVectorCBar;
-	float inversevalue = 0.0;
-	int calculationType = [[[NSUserDefaults standardUserDefaults] objectForKey:@"vectorCalculationMethod"] intValue];
-	int count = (int)[_theValues length]/sizeof(float);
-	_sumXVector = 0.0;
-    [_theValues getBytes:values length:[_theValues length]];
-	if(calculationType == 1)
+	int calculationType = [XRDataSet vectorCalculationMethod];
+	int angleMultiplier = (calculationType == 1) ? 1 : 2;
+	int method = angleMultiplier - 1;
+	XRCircularResultant resultant;
+	@synchronized(self)
 	{
-		for(int i=0;i<count;i++)
+		if(!_hasRunningResultant[method] && _angleHundredths)
 		{
-			_sumXVector += cos([self radiansFromDegrees:values[i]]);
+			_runningResultant[method] = XRCircularResultantComputeHundredths((const XRAngleHundredths *)[_angleHundredths bytes],
+																			 [_angleHundredths length]/sizeof(XRAngleHundredths),
+																			 angleMultiplier,
+																			 false);
+			_hasRunningResultant[method] = YES;
 		}
-		if(isBiDir)
+		else if(!_hasRunningResultant[method])
 		{
-			for(int i=0;i<count;i++)
-			{
-				float tempValue = values[i] + 180.0;
-				if(tempValue > 180)
-					tempValue -= 360.0;
-				_sumXVector += cos([self radiansFromDegrees:tempValue]);
-			}
+			XRDataSetValueBuffer buffer = [self valueBuffer];
+			_runningResultant[method] = XRCircularResultantCompute(buffer.values, buffer.count, angleMultiplier, false);
+			_hasRunningResultant[method] = YES;
 		}
-		if(isBiDir)
-			_sumXVectorCBar = _sumXVector / count * 2;
-		else
-			_sumXVectorCBar = _sumXVector / count;
+		resultant = _runningResultant[method];
 	}
-	else
-	{
-		for(int i=0;i<count;i++)
-		{
-			inversevalue = values[i] * 2;
-			while(inversevalue > 360.0)
-				inversevalue = inversevalue - 360.0;
-			_sumXVector += cos([self radiansFromDegrees:inversevalue]);
-		}
-		if(isBiDir)
-		{
-			for(int i=0;i<count;i++)
-			{
-				inversevalue = (values[i] + 180);
-				if(inversevalue>360)
-					inversevalue -= 360.0;
-				inversevalue = inversevalue * 2;
-				while(inversevalue > 360.0)
-					inversevalue = inversevalue - 360.0;
-				_sumXVector += cos([self radiansFromDegrees:inversevalue]);
-			}
-		}
-		if(isBiDir)
-			_sumXVectorCBar = _sumXVector /( count * 2);
-		else
-			_sumXVectorCBar = _sumXVector /( count);
-	}
-	[_circularStatistics addObject:[XRStatistic statisticWithName:@"X Vector" withFloatValue:_sumXVector]];
-	[_circularStatistics addObject:[XRStatistic statisticWithName:[NSString stringWithUTF8String:"C̅"] withFloatValue:_sumXVectorCBar]];
-	[[_circularStatistics lastObject] setASCIIName:@"Standarized X Vector"];
-	free(values);
-	return;
+	if(isBiDir)
+		return XRCircularResultantMirrored(resultant, angleMultiplier);
+	return resultant;
+}
+
++(NSArray *)xVectorStatisticsForResultant:(XRCircularResultant)resultant
+{
+	XRStatistic *standardized = [XRStatistic statisticWithName:[NSString stringWithUTF8String:"C̅"] withFloatValue:(float)resultant.meanCos];
+	[standardized setASCIIName:@"Standarized X Vector"];
+	return [NSArray arrayWithObjects:[XRStatistic statisticWithName:@"X Vector" withFloatValue:(float)resultant.sumCos],standardized,nil];
+}
+
++(NSArray *)yVectorStatisticsForResultant:(XRCircularResultant)resultant
+{
+	XRStatistic *standardized = [XRStatistic statisticWithName:[NSString stringWithUTF8String:"S̅"] withFloatValue:(float)resultant.meanSin];
+	[standardized setASCIIName:@"Standarized Y Vector"];
+	return [NSArray arrayWithObjects:[XRStatistic statisticWithName:@"Y Vector" withFloatValue:(float)resultant.sumSin],standardized,nil];
+}
+
+-(void)computeXVector:(BOOL)isBiDir
+{
+	[(NSMutableArray *)[self currentStatistics] addObjectsFromArray:[XRDataSet xVectorStatisticsForResultant:[self circularResultant:isBiDir]]];
+	_statisticsByName = nil;
 }
 
 -(void)computeYVector:(BOOL)isBiDir
 {
-	float *values = (float *)malloc([_theValues length]);
-	float _sumYVector,_sumYVectorSBar;
-	float inversevalue;
-	int count = (int)[_theValues length]/sizeof(float);
-	int calculationType = [[[NSUserDefaults standardUserDefaults] objectForKey:@"vectorCalculationMethod"] intValue];
-	_sumYVector = 0.0;
-    [_theValues getBytes:values length: [_theValues length]];
-	if(calculationType == 1)
-	{
-		for(int i=0;i<count;i++)
-		{
-			_sumYVector += sin([self radiansFromDegrees:values[i]]);
-		}
-		if(isBiDir)
-		{
-			for(int i=0;i<count;i++)
-			{
-				float tempValue = values[i] + 180.0;
-				if(tempValue > 180)
-					tempValue -= 360.0;
-				_sumYVector += sin([self radiansFromDegrees:tempValue]);
-			}
-		}
-		if(isBiDir)
-			_sumYVectorSBar = _sumYVector / count * 2;
-		else
-			_sumYVectorSBar = _sumYVector / count;
-	}
-	else
-	{
-		for(int i=0;i<count;i++)
-		{
-			inversevalue = values[i] * 2;
-			while(inversevalue > 360.0)
-				inversevalue = inversevalue - 360.0;
-			_sumYVector += sin([self radiansFromDegrees:inversevalue]);
-		}
-		if(isBiDir)
-		{
-			for(int i=0;i<count;i++)
-			{
-				inversevalue = (values[i] + 180);
-				if(inversevalue>360)
-					inversevalue -= 360.0;
-				inversevalue = inversevalue * 2;
-				while(inversevalue > 360.0)
-					inversevalue = inversevalue - 360.0;
-				_sumYVector += sin([self radiansFromDegrees:inversevalue]);
-			}
-		}
-		if(isBiDir)
-			_sumYVectorSBar = _sumYVector /( count * 2);
-		else
-			_sumYVectorSBar = _sumYVector /( count);
-	}
-	[_circularStatistics addObject:[XRStatistic statisticWithName:@"Y Vector" withFloatValue:_sumYVector]];
-	[_circularStatistics addObject:[XRStatistic statisticWithName:[NSString stringWithUTF8String:"S̅"] withFloatValue:_sumYVectorSBar]];
-	[[_circularStatistics lastObject] setASCIIName:@"Standarized Y Vector"];
-	free(values);
-	return;
+	[(NSMutableArray *)[self currentStatistics] addObjectsFromArray:[XRDataSet yVectorStatisticsForResultant:[self circularResultant:isBiDir]]];
+	_statisticsByName = nil;
 }
 
 -(XRStatistic *)calculateRayleighForRBar:(XRStatistic *)rbar
 {
-	int count;
-	float rbarValue = [rbar floatValue];
-	float stat;
-	float scalerfactor;
-	XRStatistic *result;
-	float calresult;
-	count = (int)[_theValues length]/4;
-	stat = count * rbarValue * rbarValue;
-	scalerfactor = 1 + (2 * stat - stat*stat)/(4*count) -  (24 * stat - 132 * stat* stat + 76 * stat* stat* stat - 9 * stat* stat* stat* stat) / (288 * count* count);
-	calresult = exp(-stat)*scalerfactor;
-	//NSLog(@"rayleigh: %i %f %f %f %f",count,stat,scalerfactor,calresult,rbarValue);
-	result = [XRStatistic statisticWithName:@"Rayleigh Probability" withFloatValue:calresult];
-	
-	return result;
+	return [XRStatistic statisticWithName:@"Rayleigh Probability" withFloatValue:XRCircularSummaryRayleighProbability((int)[self valueCount], [rbar floatValue])];
 }
 
--(XRStatistic *)calculateKappaForRBar:(XRStatistic *)rbar
++(XRStatistic *)kappaStatistic:(float)kappa
 {
-	float result;
-	XRStatistic *theStat;
-	if([rbar floatValue]<.53)
-		result =  (2 * [rbar floatValue]) + ([rbar floatValue]*[rbar floatValue]*[rbar floatValue]) + (5 * [rbar floatValue]*[rbar floatValue]*[rbar floatValue]*[rbar floatValue]*[rbar floatValue])/6;
-	else if([rbar floatValue]<.85)
-		result =  -0.4 + 1.39 * [rbar floatValue] + 0.43/(1 - [rbar floatValue]);
-	else
-		result = 1/(([rbar floatValue]*[rbar floatValue]*[rbar floatValue]) - 4 * ([rbar floatValue]*[rbar floatValue]) + 3 * [rbar floatValue]);
-	theStat = [XRStatistic statisticWithName:[NSString stringWithUTF8String:"κ (est)"] withFloatValue:result];
+	XRStatistic *theStat = [XRStatistic statisticWithName:[NSString stringWithUTF8String:"κ (est)"] withFloatValue:kappa];
 	[theStat setASCIIName:@"Concentration Parameter (Kappa): Estimated"];
 	return theStat;
 }
 
--(XRStatistic *)calculateStandardErrorWithN:(int)n rbar:(XRStatistic *)rbar kappa:(XRStatistic *)kappa
+-(XRStatistic *)calculateKappaForRBar:(XRStatistic *)rbar
 {
-	float result = 1/sqrt(((float)n * [rbar floatValue] * [kappa floatValue]));
-	XRStatistic *theStat;
-	//NSLog(@"n: %i, rbar %f, kappa %f, result %f, degrees %f",n, [rbar floatValue], [kappa floatValue],result,[self degreesFromRadians:result]);
-	
-	theStat =  [XRStatistic statisticWithName:@"Se" withFloatValue:[self degreesFromRadians:result]];
+	return [XRDataSet kappaStatistic:XRCircularSummaryKappa([rbar floatValue])];
+}
+
++(XRStatistic *)standardErrorStatistic:(float)standardError
+{
+	XRStatistic *theStat =  [XRStatistic statisticWithName:@"Se" withFloatValue:standardError];
 	[theStat setASCIIName:@"Standard Error Of Mean Direction (Se)"];
 	return theStat;
 }
 
--(XRStatistic *)calculateAngleIntervalWithStandardError:(XRStatistic *)error
+-(XRStatistic *)calculateStandardErrorWithN:(int)n rbar:(XRStatistic *)rbar kappa:(XRStatistic *)kappa
 {
-	XRStatistic *theStat =  [XRStatistic statisticWithName:[NSString stringWithUTF8String:"θ̅± (95%)"] withFloatValue:([error floatValue] * 1.64)];
+	return [XRDataSet standardErrorStatistic:XRCircularSummaryStandardError(n, [rbar floatValue], [kappa floatValue])];
+}
+
++(XRStatistic *)angleIntervalStatistic:(float)interval
+{
+	XRStatistic *theStat =  [XRStatistic statisticWithName:[NSString stringWithUTF8String:"θ̅± (95%)"] withFloatValue:interval];
 	[theStat setASCIIName:@"95% Confidence Interval"];
 	return theStat;
 }
 
+-(XRStatistic *)calculateAngleIntervalWithStandardError:(XRStatistic *)error
+{
+	return [XRDataSet angleIntervalStatistic:XRCircularSummaryConfidenceInterval([error floatValue])];
+}
+
 -(double)radiansFromDegrees:(double)degrees
 {
 	double pi = 3.14159265358989323846;
@@ -535,31 +829,22 @@
 	return result;
 }
 
--(XRStatistic *)chiSquaredWithStartAngle:(float)startAngle sectorSize:(float)sectorSize isBiDir:(BOOL)isBiDir
++(XRStatistic *)chiSquaredStatisticWithSectorCount:(int)sectorCount expectedFrequency:(float)expectedFreq
 {
-	int sectorCount = 360.0/sectorSize;
-	float angle;
-	float expectedFreq;
-	XRStatistic *theStat;
-	int *countArray = (int *)malloc(sizeof(int)*sectorCount);
-	int totalCount = 0;
-	for(int i=0;i<sectorCount;i++)
-	{
-		angle = (startAngle + (i*sectorSize));
-		countArray[i] = [self valueCountFromAngle:angle toAngle2:(angle + sectorSize) biDir:isBiDir];
-		totalCount += countArray[i];
-	}
-	expectedFreq = (float)totalCount/(float)sectorCount;
-	[self standardDeviationForIntArray:countArray count:sectorCount expected:expectedFreq];
-	theStat = [XRStatistic emptyStatisticWithName:[NSString stringWithUTF8String:"χ2"]];
+	XRStatistic *theStat = [XRStatistic emptyStatisticWithName:[NSString stringWithUTF8String:"χ2"]];
 	if(expectedFreq <+ 5.0)
 		 [theStat setValueString:@"Expected Frequency Too Low: must be >=5 per sector" ];
 	else
 		[theStat setValueString:[NSString stringWithFormat:@"%f: df = ",(double)(sectorCount-1)]];
 	[theStat setASCIIName:@"Chi-Squared"];
-    free(countArray);
 	return theStat;
-	
+}
+
+-(XRStatistic *)chiSquaredWithStartAngle:(float)startAngle sectorSize:(float)sectorSize isBiDir:(BOOL)isBiDir
+{
+	XRSectorHistogram *histogram = [self sectorHistogramWithStartAngle:startAngle sectorSize:sectorSize biDir:isBiDir];
+	int sectorCount = [histogram sectorCount];
+	return [XRDataSet chiSquaredStatisticWithSectorCount:sectorCount expectedFrequency:(float)[histogram totalCount]/(float)sectorCount];
 }
 
 -(float)standardDeviationForIntArray:(int *)array count:(int)count expected:(float)expected
@@ -572,9 +857,9 @@
 	
 }
 
--(NSString *)statisticsDescription
++(NSString *)descriptionOfStatistics:(NSArray *)statistics
 {
-	NSEnumerator *anEnum = [_circularStatistics objectEnumerator];
+	NSEnumerator *anEnum = [statistics objectEnumerator];
 	XRStatistic *aStat;
 	NSMutableString *theString = [[NSMutableString alloc] init];
 	
@@ -590,17 +875,110 @@
 	return theString;
 }
 
++(NSString *)statisticsDescriptionForSummary:(XRCircularSummary)summary
+{
+	return [XRDataSet descriptionOfStatistics:[XRDataSet statisticsForSummary:summary]];
+}
+
+-(NSString *)statisticsDescription
+{
+	return [XRDataSet descriptionOfStatistics:[self currentStatistics]];
+}
+
 #pragma mark Mutability
 
+-(void)valuesWillChange
+{
+	_generation++;
+}
+
+-(NSMutableData *)mutableValues
+{
+	if(!_ownsValues)
+	{
+		_theValues = [[NSMutableData alloc] initWithData:[self loadedValues]];
+		_ownsValues = YES;
+		_valueSource = nil;
+		[self recordValueCopy:[_theValues length]];
+	}
+	return (NSMutableData *)_theValues;
+}
+
+//Only the new values are visited: running sums and cached histograms are updated in place.
+-(void)appendValues:(const float *)values count:(NSUInteger)count
+{
+	@synchronized(self)
+	{
+		//compact storage is kept, so it still matches the storage recorded for the document,
+		//unless a new value cannot be stored that way. A deferred set takes its storage first.
+		if(!_theValues && !_angleHundredths)
+			[self loadedValues];
+		NSData *encoded = nil;
+		if(_angleHundredths)
+		{
+			BOOL rounded = NO;
+			encoded = [self hundredthsForValues:values count:count losslessly:_angleStorage == XRDataSetAngleStorageHundredths rounded:&rounded];
+			if(!encoded)
+				[self storeAnglesAsFloats];
+		}
+		[self valuesWillChange];
+		if(encoded)
+			[self appendHundredths:encoded];
+		else
+		{
+			for(int method=0;method<2;method++)
+			{
+				if(_hasRunningResultant[method])
+					_runningResultant[method] = XRCircularResultantAdd(_runningResultant[method], XRCircularResultantCompute(values, count, method + 1, false));
+			}
+			for(XRSectorHistogram *histogram in _sectorHistograms)
+				[histogram addValues:values count:count];
+			[_fineHistogram addValues:values count:count];
+			[[self mutableValues] appendBytes:values length:count * sizeof(float)];
+			[self recordValueCopy:count * sizeof(float)];
+		}
+	}
+	[[NSNotificationCenter defaultCenter] postNotificationName:XRDataSetDidAppendValuesNotification object:self];
+}
+
+//appends values already stored as hundredths, counting the values they decode to; called with the lock held
+-(void)appendHundredths:(NSData *)encoded
+{
+	const XRAngleHundredths *hundredths = (const XRAngleHundredths *)[encoded bytes];
+	NSUInteger count = [encoded length]/sizeof(XRAngleHundredths);
+	for(int method=0;method<2;method++)
+	{
+		if(_hasRunningResultant[method])
+			_runningResultant[method] = XRCircularResultantAdd(_runningResultant[method], XRCircularResultantComputeHundredths(hundredths, count, method + 1, false));
+	}
+	[_fineHistogram addHundredths:hundredths count:count];
+	if([_sectorHistograms count] || _theValues)
+	{
+		NSMutableData *decoded = [NSMutableData dataWithLength:count * sizeof(float)];
+		float *floats = (float *)[decoded mutableBytes];
+		for(NSUInteger n=0;n<count;n++)
+			floats[n] = XRAngleHundredthsToDegrees(hundredths[n]);
+		for(XRSectorHistogram *histogram in _sectorHistograms)
+			[histogram addValues:floats count:count];
+		//floats decoded from the hundredths are an NSMutableData the set owns
+		[(NSMutableData *)_theValues appendData:decoded];
+	}
+	[(NSMutableData *)_angleHundredths appendData:encoded];
+	[self recordValueCopy:[encoded length]];
+}
+
 -(void)appendData:(NSData *)data
 {
-	[_theValues appendData:data];
+	if(data == _theValues)
+		data = [NSData dataWithData:data];
+	[self appendValues:(const float *)[data bytes] count:[data length]/sizeof(float)];
 }
 
 -(void)appendDataFromFile:(NSString *)path encoding:(NSStringEncoding)encoding
 {
 	NSString *theContents = [[NSString alloc] initWithData:[NSData dataWithContentsOfFile:path] encoding:encoding];
 	NSScanner *theScanner = [NSScanner scannerWithString:theContents];
+	NSMutableData *newValues = [[NSMutableData alloc] init];
 	
 	float aValue;
 	_name = [path lastPathComponent];
@@ -609,9 +987,9 @@
 		[theScanner scanFloat:&aValue];
 		
 		if((aValue<=360.0)||(aValue>=0))
-			[_theValues appendBytes:&aValue length:sizeof(float)];
+			[newValues appendBytes:&aValue length:sizeof(float)];
 	}
-	
+	[self appendValues:(const float *)[newValues bytes] count:[newValues length]/sizeof(float)];
 }
 
 @end
@@ -0,0 +1,264 @@
+//
+// XRDataSetAngleStorageTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import Foundation
+@testable import PaleoRose
+import Testing
+
+struct XRDataSetAngleStorageTests {
+
+    // MARK: - Test Setup
+
+    /// Deterministic values, so a failing case can be reproduced
+    private struct SplitMix64: RandomNumberGenerator {
+        var state: UInt64
+
+        mutating func next() -> UInt64 {
+            state &+= 0x9E37_79B9_7F4A_7C15
+            var value = state
+            value = (value ^ (value >> 30)) &* 0xBF58_476D_1CE4_E5B9
+            value = (value ^ (value >> 27)) &* 0x94D0_49BB_1331_11EB
+            return value ^ (value >> 31)
+        }
+    }
+
+    /// Readings taken to a hundredth of a degree, as a Float column read from a document holds them
+    private func compassValues(count: Int, seed: UInt64) -> [Float] {
+        var generator = SplitMix64(state: seed)
+        return (0 ..< count).map { _ in Float(Double(UInt16.random(in: 0 ..< 36000, using: &generator)) / 100.0) }
+    }
+
+    private func exactly(_ value: Float) -> XRAngleHundredths? {
+        var hundredths: XRAngleHundredths = 0
+        return XRAngleHundredthsFromDegreesExactly(value, &hundredths) ? hundredths : nil
+    }
+
+    private func rounded(_ value: Float) -> XRAngleHundredths? {
+        var hundredths: XRAngleHundredths = 0
+        return XRAngleHundredthsFromDegreesRounded(value, &hundredths) ? hundredths : nil
+    }
+
+    private func counts(_ dataSet: XRDataSet, startAngle: Float, sectorSize: Float, biDir: Bool) throws -> [Int32] {
+        let sectorCount = Int32((360.0 / sectorSize).rounded())
+        let histogram = try #require(dataSet.sectorHistogram(
+            withStartAngle: startAngle,
+            sectorSize: sectorSize,
+            sectorCount: sectorCount,
+            biDir: biDir
+        ))
+        return (0 ..< sectorCount).map { histogram.count(forSector: $0) }
+    }
+
+    // MARK: - Encoding
+
+    @Test("Every hundredth decodes to the bin edge it stands for and encodes back exactly")
+    func hundredthsRoundTrip() {
+        let mismatches = (0 ..< XRAngleHundredths(XRAngleHundredthsCount)).filter { hundredths in
+            let degrees = XRAngleHundredthsToDegrees(hundredths)
+            return degrees != Float(Double(hundredths) / 100.0) || exactly(degrees) != hundredths
+        }
+        #expect(mismatches.isEmpty)
+    }
+
+    @Test("Values that are not whole hundredths are only stored by rounding")
+    func inexactValues() {
+        for value: Float in [Float(12.5).nextUp, -0.0, -1.0, 360.0, .infinity, .nan] {
+            #expect(exactly(value) == nil)
+        }
+        #expect(rounded(12.344) == 1234)
+        #expect(rounded(359.996) == 0)
+        #expect(rounded(-0.5) == 35950)
+        #expect(rounded(725.0) == 500)
+        #expect(rounded(.nan) == nil)
+        #expect(rounded(-.infinity) == nil)
+    }
+
+    // MARK: - Storage
+
+    @Test("Lossless storage keeps every float and halves the memory")
+    func losslessStorage() throws {
+        let values = compassValues(count: 10000, seed: 11)
+        let dataSet = try XRDataSet.stub(values: values)
+
+        #expect(dataSet.storeAnglesAsHundredths(losslessly: true))
+
+        #expect(dataSet.angleStorage() == .hundredths)
+        #expect(dataSet.valueStorageBytes() == UInt(values.count * MemoryLayout<UInt16>.size))
+        #expect(dataSet.valueCount() == UInt(values.count))
+        #expect(dataSet.withValues { Array($0) } == values)
+        #expect(dataSet.evictValues())
+        #expect(dataSet.valueStorageBytes() == UInt(values.count * MemoryLayout<UInt16>.size))
+        #expect(dataSet.withValues { Array($0) } == values)
+    }
+
+    @Test("Lossless storage is refused, leaving the floats alone, when a value is not a whole hundredth")
+    func losslessStorageRefused() throws {
+        var values = compassValues(count: 1000, seed: 13)
+        values[500] = 123.456
+        let dataSet = try XRDataSet.stub(values: values)
+
+        #expect(!dataSet.storeAnglesAsHundredths(losslessly: true))
+
+        #expect(dataSet.angleStorage() == .float)
+        #expect(dataSet.valueStorageBytes() == UInt(values.count * MemoryLayout<Float>.size))
+        #expect(dataSet.withValues { Array($0) } == values)
+    }
+
+    @Test("Rounded storage replaces each value with its nearest hundredth")
+    func roundedStorage() throws {
+        let values: [Float] = [123.456, 0.004, 359.999, 45.0]
+        let dataSet = try XRDataSet.stub(values: values)
+        let before = try counts(dataSet, startAngle: 0, sectorSize: 0.01, biDir: false)
+
+        #expect(dataSet.storeAnglesAsHundredths(losslessly: false))
+
+        #expect(dataSet.angleStorage() == .roundedHundredths)
+        #expect(dataSet.withValues { Array($0) } == [123.46, 0.0, 0.0, 45.0])
+        #expect(try counts(dataSet, startAngle: 0, sectorSize: 0.01, biDir: false) != before)
+    }
+
+    @Test("Appending values that can be stored the same way keeps compact storage and its counts current")
+    func appendKeepsCompactStorage() throws {
+        let values = compassValues(count: 1000, seed: 17)
+        let more = compassValues(count: 200, seed: 18)
+        let dataSet = try XRDataSet.stub(values: values)
+        #expect(dataSet.storeAnglesAsHundredths(losslessly: true))
+        _ = try counts(dataSet, startAngle: 1.3, sectorSize: 7, biDir: false)
+        _ = dataSet.circularResultant(false)
+        let fresh = try XRDataSet.stub(values: values + more)
+
+        dataSet.append(more.withUnsafeBufferPointer { Data(buffer: $0) })
+
+        #expect(dataSet.angleStorage() == .hundredths)
+        #expect(dataSet.valueStorageBytes() == UInt((values.count + more.count) * MemoryLayout<UInt16>.size))
+        #expect(dataSet.withValues { Array($0) } == values + more)
+        #expect(
+            try counts(dataSet, startAngle: 1.3, sectorSize: 7, biDir: false)
+                == counts(fresh, startAngle: 1.3, sectorSize: 7, biDir: false)
+        )
+        #expect(abs(dataSet.circularResultant(false).meanCos - fresh.circularResultant(false).meanCos) < 1e-6)
+    }
+
+    @Test("Appending to rounded storage rounds the new values")
+    func appendRounds() throws {
+        let dataSet = try XRDataSet.stub(values: [10.0, 20.0])
+        #expect(dataSet.storeAnglesAsHundredths(losslessly: false))
+        let more: [Float] = [12.345, 270.0]
+
+        dataSet.append(more.withUnsafeBufferPointer { Data(buffer: $0) })
+
+        #expect(dataSet.angleStorage() == .roundedHundredths)
+        #expect(dataSet.withValues { Array($0) } == [10.0, 20.0, 12.35, 270.0])
+    }
+
+    @Test("Appending a value that is not a whole hundredth returns lossless storage to floats")
+    func appendDecodes() throws {
+        let values = compassValues(count: 1000, seed: 17)
+        let dataSet = try XRDataSet.stub(values: values)
+        dataSet.storeAnglesAsHundredths(losslessly: true)
+        let more: [Float] = [12.345, 270.0]
+
+        dataSet.append(more.withUnsafeBufferPointer { Data(buffer: $0) })
+
+        #expect(dataSet.angleStorage() == .float)
+        #expect(dataSet.withValues { Array($0) } == values + more)
+    }
+
+    // MARK: - Statistics
+
+    @Test("Table sums match the float sums", arguments: [1, 2] as [Int32])
+    func tableResultantMatchesFloat(angleMultiplier: Int32) {
+        let values = compassValues(count: 100_000, seed: 19)
+        let hundredths = values.map { exactly($0) ?? 0 }
+
+        for biDir in [false, true] {
+            let expected = XRCircularResultantComputeScalar(values, values.count, angleMultiplier, biDir)
+            let table = XRCircularResultantComputeHundredths(hundredths, hundredths.count, angleMultiplier, biDir)
+
+            #expect(table.count == expected.count)
+            #expect(abs(table.sumCos - expected.sumCos) < 1e-6 * Double(values.count))
+            #expect(abs(table.sumSin - expected.sumSin) < 1e-6 * Double(values.count))
+        }
+    }
+
+    @Test("Compact data sets report the statistics and counts of their floats")
+    func compactStatisticsMatchFloat() throws {
+        let values = compassValues(count: 50000, seed: 23)
+        let floats = try XRDataSet.stub(values: values)
+        let compact = try XRDataSet.stub(values: values)
+        #expect(compact.storeAnglesAsHundredths(losslessly: true))
+
+        for biDir in [false, true] {
+            let expected = floats.circularResultant(biDir)
+            let resultant = compact.circularResultant(biDir)
+            #expect(abs(resultant.meanCos - expected.meanCos) < 1e-6)
+            #expect(abs(resultant.meanSin - expected.meanSin) < 1e-6)
+            for (startAngle, sectorSize) in [(0.0, 10.0), (2.5, 5.0), (1.3, 7.0)] as [(Float, Float)] {
+                #expect(
+                    try counts(compact, startAngle: startAngle, sectorSize: sectorSize, biDir: biDir)
+                        == counts(floats, startAngle: startAngle, sectorSize: sectorSize, biDir: biDir)
+                )
+            }
+        }
+        #expect(compact.valueStorageBytes() == UInt(values.count * MemoryLayout<UInt16>.size))
+    }
+
+    // MARK: - Benchmark
+
+    @Test(
+        "Benchmark compact storage against floats",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled),
+        arguments: [1_000_000, 10_000_000]
+    )
+    func benchmarkCompactStorage(valueCount: Int) throws {
+        let values = compassValues(count: valueCount, seed: 29)
+        let floats = try XRDataSet.stub(values: values)
+        let compact = try XRDataSet.stub(values: values)
+        #expect(compact.storeAnglesAsHundredths(losslessly: true))
+        let hundredths = values.map { exactly($0) ?? 0 }
+
+        let float = Benchmark.measure("float resultant, \(valueCount) values", iterations: 5) {
+            _ = XRCircularResultantCompute(values, values.count, 2, true)
+        }
+        let table = Benchmark.measure("table resultant, \(valueCount) values", iterations: 5) {
+            _ = XRCircularResultantComputeHundredths(hundredths, hundredths.count, 2, true)
+        }
+        let floatHistogram = Benchmark.measure("float sectors, \(valueCount) values", iterations: 1) {
+            _ = floats.sectorHistogram(withStartAngle: 1.3, sectorSize: 7, sectorCount: 51, biDir: true)
+        }
+        let compactHistogram = Benchmark.measure("compact sectors, \(valueCount) values", iterations: 1) {
+            _ = compact.sectorHistogram(withStartAngle: 1.3, sectorSize: 7, sectorCount: 51, biDir: true)
+        }
+        let resultantSpeedup = Benchmark.seconds(float) / Benchmark.seconds(table)
+        let histogramSpeedup = Benchmark.seconds(floatHistogram) / Benchmark.seconds(compactHistogram)
+        print("[benchmark] \(valueCount) values: \(floats.valueStorageBytes()) bytes as floats, "
+            + "\(compact.valueStorageBytes()) as hundredths")
+        print("[benchmark] \(valueCount) values: resultant \(resultantSpeedup)x, sectors \(histogramSpeedup)x")
+        #expect(compact.valueStorageBytes() * 2 == floats.valueStorageBytes())
+    }
+}
@@ -0,0 +1,129 @@
+//
+// XRDataSetAppendTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import Foundation
+import Numerics
+@testable import PaleoRose
+import Testing
+
+@Suite(.serialized)
+struct XRDataSetAppendTests {
+
+    // MARK: - Test Setup
+
+    private let history: [Float] = (0 ..< 20000).map { Float(($0 &* 7919) % 36000) / 100.0 }
+    private let readings: [Float] = (0 ..< 300).map { Float(($0 &* 331) % 3600) / 10.0 }
+
+    private func data(_ values: [Float]) -> Data {
+        values.withUnsafeBufferPointer { Data(buffer: $0) }
+    }
+
+    // MARK: - Tests
+
+    @Test("Running vector sums match a full recomputation", arguments: [false, true])
+    func runningResultant(biDir: Bool) throws {
+        let dataSet = try XRDataSet.stub(values: history)
+        _ = dataSet.circularResultant(biDir)
+
+        dataSet.append(data(readings))
+        let running = dataSet.circularResultant(biDir)
+
+        let full = try XRDataSet.stub(values: history + readings).circularResultant(biDir)
+        #expect(running.count == full.count)
+        #expect(running.sumCos.isApproximatelyEqual(to: full.sumCos, absoluteTolerance: 1e-3))
+        #expect(running.sumSin.isApproximatelyEqual(to: full.sumSin, absoluteTolerance: 1e-3))
+    }
+
+    @Test("Cached histograms are updated with the appended values", arguments: [false, true])
+    func histogramsFollowAppend(biDir: Bool) throws {
+        let dataSet = try XRDataSet.stub(values: history)
+        let cached = try #require(dataSet.sectorHistogram(withStartAngle: 5, sectorSize: 10, sectorCount: 36, biDir: biDir))
+
+        dataSet.append(data(readings))
+
+        let current = try #require(dataSet.sectorHistogram(withStartAngle: 5, sectorSize: 10, sectorCount: 36, biDir: biDir))
+        let fresh = try #require(try XRDataSet.stub(values: history + readings)
+            .sectorHistogram(withStartAngle: 5, sectorSize: 10, sectorCount: 36, biDir: biDir))
+        #expect(current === cached)
+        #expect((0 ..< 36).map { current.count(forSector: $0) } == (0 ..< 36).map { fresh.count(forSector: $0) })
+        #expect(current.totalCount == fresh.totalCount)
+    }
+
+    @Test("Appending copies only the new values")
+    func appendCopiesOnlyNewValues() throws {
+        let dataSet = try XRDataSet.stub(values: history)
+        _ = dataSet.calculateStatisticObjects(forBiDir: false, startAngle: 0, sectorSize: 10)
+        let bytes = dataSet.valueCopyBytes()
+
+        dataSet.append(data(readings))
+        _ = dataSet.calculateStatisticObjects(forBiDir: false, startAngle: 0, sectorSize: 10)
+
+        #expect(dataSet.valueCopyBytes() == bytes + UInt(readings.count * MemoryLayout<Float>.size))
+        let count = try #require(dataSet.currentStatistic(withName: "N"))
+        #expect(count.intValue() == Int32(history.count + readings.count))
+    }
+
+    @Test("A borrowed buffer is used as is and copied on the first append")
+    func borrowedValuesCopyOnAppend() throws {
+        let borrowed = NSData(data: data(history))
+        let dataSet = try #require(XRDataSet(
+            id: 1,
+            name: "Borrowed",
+            tableName: "t",
+            column: "c",
+            predicate: "",
+            comments: NSAttributedString(),
+            valuesNoCopy: Data(referencing: borrowed)
+        ))
+        #expect(!dataSet.ownsValues())
+        #expect(dataSet.valueCopyCount() == 0)
+        #expect(dataSet.valueCount() == UInt(history.count))
+
+        dataSet.append(data(readings))
+
+        #expect(dataSet.ownsValues())
+        #expect(dataSet.valueCopyCount() == 2)
+        #expect(dataSet.valueCopyBytes() == UInt((history.count + readings.count) * MemoryLayout<Float>.size))
+        #expect(dataSet.withValues { Array($0) } == history + readings)
+        #expect(borrowed.length == history.count * MemoryLayout<Float>.size)
+    }
+
+    @Test("Appending posts a notification")
+    func appendPostsNotification() throws {
+        let dataSet = try XRDataSet.stub(values: history)
+        var notified = false
+        let observer = NotificationCenter.default.addObserver(
+            forName: NSNotification.Name(XRDataSetDidAppendValuesNotification),
+            object: dataSet,
+            queue: nil
+        ) { _ in notified = true }
+        defer { NotificationCenter.default.removeObserver(observer) }
+
+        dataSet.append(data(readings))
+
+        #expect(notified)
+    }
+}
@@ -0,0 +1,174 @@
+//
+// XRDataSetValuesTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import Foundation
+@testable import PaleoRose
+import Testing
+
+// Copy counters are process wide, so these tests must not run alongside each other.
+@Suite(.serialized)
+struct XRDataSetValuesTests {
+
+    /// Counts the reads of a deferred data set
+    private final class CountingValueSource: NSObject, XRDataSetValueSource {
+        let values: [Float]?
+        private(set) var reads = 0
+
+        init(values: [Float]?) {
+            self.values = values
+        }
+
+        func values(for _: XRDataSet?) -> Data? {
+            reads += 1
+            return values?.withUnsafeBufferPointer { Data(buffer: $0) }
+        }
+    }
+
+    private func buildDeferredDataSet(_ source: CountingValueSource) throws -> XRDataSet {
+        try #require(XRDataSet(
+            id: 1,
+            name: "Deferred",
+            tableName: "t",
+            column: "v",
+            predicate: "",
+            comments: NSAttributedString(),
+            valueSource: source
+        ))
+    }
+
+    @Test("withValues borrows the values without copying")
+    func withValuesDoesNotCopy() throws {
+        let values: [Float] = [10.0, 20.0, 30.0]
+        let dataSet = try XRDataSet.stub(values: values)
+        let copies = dataSet.valueCopyCount()
+
+        let borrowed = dataSet.withValues { Array($0) }
+
+        #expect(borrowed == values)
+        #expect(dataSet.valueCount() == 3)
+        #expect(dataSet.valueCopyCount() == copies)
+    }
+
+    @Test("theData still returns a counted copy")
+    func theDataIsCounted() throws {
+        let dataSet = try XRDataSet.stub(values: [10.0, 20.0])
+        let copies = dataSet.valueCopyCount()
+        let bytes = dataSet.valueCopyBytes()
+
+        _ = dataSet.theData()
+
+        #expect(dataSet.valueCopyCount() == copies + 1)
+        #expect(dataSet.valueCopyBytes() == bytes + 2 * UInt(MemoryLayout<Float>.size))
+    }
+
+    @Test(
+        "Statistics and sector counts read the values in place",
+        arguments: [false, true]
+    )
+    func statisticsDoNotCopy(biDir: Bool) throws {
+        let dataSet = try XRDataSet.stub(values: (0 ..< 1000).map { Float($0 % 360) })
+        let copies = dataSet.valueCopyCount()
+        let bytes = dataSet.valueCopyBytes()
+
+        _ = dataSet.calculateStatisticObjects(forBiDir: biDir, startAngle: 0, sectorSize: 10)
+        _ = dataSet.valueCount(fromAngle: 0, toAngle2: 90, biDir: biDir)
+        _ = dataSet.meanCount(withIncrement: 15, startingAngle: 5, isBiDirectional: biDir)
+
+        #expect(dataSet.valueCopyCount() == copies)
+        #expect(dataSet.valueCopyBytes() == bytes)
+    }
+
+    @Test("A borrowed buffer is invalidated by appending")
+    func appendInvalidatesBuffer() throws {
+        let dataSet = try XRDataSet.stub(values: [10.0, 20.0])
+        let buffer = dataSet.valueBuffer()
+        #expect(dataSet.isValidValueBuffer(buffer))
+
+        let more: [Float] = [30.0]
+        dataSet.append(more.withUnsafeBufferPointer { Data(buffer: $0) })
+
+        #expect(!dataSet.isValidValueBuffer(buffer))
+        #expect(dataSet.isValidValueBuffer(dataSet.valueBuffer()))
+        #expect(dataSet.valueBuffer().count == 3)
+    }
+
+    // MARK: - Deferred Values
+
+    @Test("A deferred data set reads its values once, when a histogram first needs them")
+    func deferredLoadsOnFirstUse() throws {
+        let source = CountingValueSource(values: [5, 15, 25, 355])
+        let dataSet = try buildDeferredDataSet(source)
+        #expect(!dataSet.hasLoadedValues())
+        #expect(source.reads == 0)
+
+        let histogram = try #require(dataSet.sectorHistogram(withStartAngle: 0, sectorSize: 10, biDir: false))
+
+        #expect(histogram.totalCount == 4)
+        #expect(dataSet.hasLoadedValues())
+        #expect(dataSet.valueCount() == 4)
+        #expect(source.reads == 1)
+    }
+
+    @Test("Evicted values are read again, and cached histograms survive eviction")
+    func evictAndReload() throws {
+        let source = CountingValueSource(values: [5, 15, 25])
+        let dataSet = try buildDeferredDataSet(source)
+        _ = dataSet.sectorHistogram(withStartAngle: 0, sectorSize: 10, biDir: false)
+        let buffer = dataSet.valueBuffer()
+
+        #expect(dataSet.evictValues())
+        #expect(!dataSet.hasLoadedValues())
+        #expect(!dataSet.isValidValueBuffer(buffer))
+        _ = dataSet.sectorHistogram(withStartAngle: 0, sectorSize: 10, biDir: false)
+        #expect(source.reads == 1)
+
+        #expect(dataSet.withValues { Array($0) } == [5, 15, 25])
+        #expect(source.reads == 2)
+    }
+
+    @Test("Appended and detached data sets keep their values")
+    func appendedValuesAreNotEvicted() throws {
+        let appended = try buildDeferredDataSet(CountingValueSource(values: [1]))
+        let more: [Float] = [2]
+        appended.append(more.withUnsafeBufferPointer { Data(buffer: $0) })
+        let detached = try buildDeferredDataSet(CountingValueSource(values: [3]))
+        detached.detachValueSource()
+
+        #expect(!appended.evictValues())
+        #expect(appended.withValues { Array($0) } == [1, 2])
+        #expect(!detached.evictValues())
+        #expect(detached.hasLoadedValues())
+        #expect(detached.valueSource() == nil)
+    }
+
+    @Test("A source that cannot read leaves the data set empty")
+    func unreadableSourceIsEmpty() throws {
+        let dataSet = try buildDeferredDataSet(CountingValueSource(values: nil))
+
+        #expect(dataSet.valueCount() == 0)
+        #expect(dataSet.hasLoadedValues())
+    }
+}
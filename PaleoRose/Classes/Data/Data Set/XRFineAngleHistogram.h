@@ -0,0 +1,61 @@
+//
+// XRFineAngleHistogram.h
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+#import "XRAngleHundredths.h"
+
+@class XRSectorHistogram;
+
+#define XRFineAngleHistogramBinsPerDegree XRAngleHundredthsPerDegree
+#define XRFineAngleHistogramBinCount (360 * XRFineAngleHistogramBinsPerDegree)
+
+// Counts of a data set's values in 0.01 degree bins, with running sums over the bins, built
+// in one pass. Bin k holds the values v with edge(k) <= v < edge(k + 1), where edge(k) is the
+// float nearest k / 100, so the number of values below any edge is exact. The counts of a rose
+// whose sector boundaries all fall on edges, in either direction, are then read off in O(sectors)
+// without visiting the values.
+@interface XRFineAngleHistogram : NSObject
+
+//values that any sector can count: everything except NaN
+@property (readonly) NSUInteger totalCount;
+
++(instancetype)histogramWithValues:(const float *)values count:(NSUInteger)count;
+
+//counts further values, e.g. after they are appended to the data set
+-(void)addValues:(const float *)values count:(NSUInteger)count;
+
+//hundredth h is edge h, so each is counted straight into its bin
++(instancetype)histogramWithHundredths:(const XRAngleHundredths *)hundredths count:(NSUInteger)count;
+-(void)addHundredths:(const XRAngleHundredths *)hundredths count:(NSUInteger)count;
+
+//the same counts as +[XRSectorHistogram histogramWithValues:...], or nil when a sector boundary is not on a bin edge
+-(XRSectorHistogram *)sectorHistogramWithStartAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDirectional:(BOOL)isBiDir;
+
+//YES when angle is on a bin edge between 0 and 360
++(BOOL)isBinEdge:(float)angle;
+
+@end
@@ -0,0 +1,194 @@
+//
+// XRFineAngleHistogram.m
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#import "XRFineAngleHistogram.h"
+#import "XRSectorHistogram.h"
+#import <math.h>
+
+//edge k of the bins, the float nearest k / 100; 360 is the last edge
+static const float *XRFineAngleEdges(void)
+{
+	static float edges[XRFineAngleHistogramBinCount + 1];
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		for(int k=0;k<=XRFineAngleHistogramBinCount;k++)
+			edges[k] = (float)((double)k / (double)XRFineAngleHistogramBinsPerDegree);
+	});
+	return edges;
+}
+
+//index of the edge equal to angle, or -1 when angle is not an edge
+static inline int XRFineAngleEdgeIndex(const float *edges, float angle)
+{
+	if(!(angle >= 0.0 && angle <= 360.0))
+		return -1;
+	long k = lround((double)angle * XRFineAngleHistogramBinsPerDegree);
+	if(k < 0 || k > XRFineAngleHistogramBinCount || edges[k] != angle)
+		return -1;
+	return (int)k;
+}
+
+//bin of a value in [0, 360); the estimate is corrected against the float edges themselves
+static inline int XRFineAngleBin(const float *edges, float value)
+{
+	int k = (int)((double)value * XRFineAngleHistogramBinsPerDegree);
+	if(k >= XRFineAngleHistogramBinCount)
+		k = XRFineAngleHistogramBinCount - 1;
+	while(k > 0 && value < edges[k])
+		k--;
+	while(k < XRFineAngleHistogramBinCount - 1 && value >= edges[k + 1])
+		k++;
+	return k;
+}
+
+@interface XRFineAngleHistogram()
+{
+	uint64_t *_below; //_below[k] is the number of values in [0, edge(k)); XRFineAngleHistogramBinCount + 1 entries
+	uint64_t _negativeCount; //values below 0, which every wrapping sector counts
+}
+@property (readwrite) NSUInteger totalCount;
+@property (nonatomic) NSMutableData *binCounts;
+@property (nonatomic) NSMutableData *runningCounts;
+@property (nonatomic) BOOL runningCountsAreCurrent;
+@end
+
+@implementation XRFineAngleHistogram
+
++(instancetype)histogramWithValues:(const float *)values count:(NSUInteger)count
+{
+	XRFineAngleHistogram *histogram = [[XRFineAngleHistogram alloc] init];
+	histogram.binCounts = [NSMutableData dataWithLength:sizeof(uint64_t) * XRFineAngleHistogramBinCount];
+	histogram.runningCounts = [NSMutableData dataWithLength:sizeof(uint64_t) * (XRFineAngleHistogramBinCount + 1)];
+	[histogram addValues:values count:count];
+	return histogram;
+}
+
++(instancetype)histogramWithHundredths:(const XRAngleHundredths *)hundredths count:(NSUInteger)count
+{
+	XRFineAngleHistogram *histogram = [XRFineAngleHistogram histogramWithValues:NULL count:0];
+	[histogram addHundredths:hundredths count:count];
+	return histogram;
+}
+
++(BOOL)isBinEdge:(float)angle
+{
+	return XRFineAngleEdgeIndex(XRFineAngleEdges(), angle) >= 0;
+}
+
+-(void)addValues:(const float *)values count:(NSUInteger)count
+{
+	const float *edges = XRFineAngleEdges();
+	uint64_t *bins = (uint64_t *)[_binCounts mutableBytes];
+	NSUInteger counted = 0;
+	for(NSUInteger n=0;n<count;n++)
+	{
+		float value = values[n];
+		if(isnan(value))
+			continue;
+		counted++;
+		if(value < 0.0)
+			_negativeCount++;
+		else if(value < 360.0)
+			bins[XRFineAngleBin(edges, value)]++;
+	}
+	_totalCount += counted;
+	_runningCountsAreCurrent = NO;
+}
+
+-(void)addHundredths:(const XRAngleHundredths *)hundredths count:(NSUInteger)count
+{
+	uint64_t *bins = (uint64_t *)[_binCounts mutableBytes];
+	for(NSUInteger n=0;n<count;n++)
+		bins[hundredths[n]]++;
+	_totalCount += count;
+	_runningCountsAreCurrent = NO;
+}
+
+-(void)calculateRunningCounts
+{
+	const uint64_t *bins = (const uint64_t *)[_binCounts bytes];
+	_below = (uint64_t *)[_runningCounts mutableBytes];
+	_below[0] = 0;
+	for(int k=0;k<XRFineAngleHistogramBinCount;k++)
+		_below[k + 1] = _below[k] + bins[k];
+	_runningCountsAreCurrent = YES;
+}
+
+//values in the sector from lower to upper, both edge indexes, tested as -[XRDataSet valueCountFromAngle:toAngle2:] tests them
+-(uint64_t)countFromEdge:(int)lower toEdge:(int)upper lowerAngle:(float)lowerAngle upperAngle:(float)upperAngle
+{
+	uint64_t belowLower = _negativeCount + _below[lower];
+	uint64_t belowUpper = _negativeCount + _below[upper];
+	if(lowerAngle < upperAngle)
+		return belowUpper - belowLower;
+	return (_totalCount - belowLower) + belowUpper;
+}
+
+-(XRSectorHistogram *)sectorHistogramWithStartAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDirectional:(BOOL)isBiDir
+{
+	const float *edges = XRFineAngleEdges();
+	int sectors = MAX(sectorCount, 0);
+	NSMutableData *countData = [NSMutableData dataWithLength:sizeof(int) * sectors];
+	int *counts = (int *)[countData mutableBytes];
+	if(!_runningCountsAreCurrent)
+		[self calculateRunningCounts];
+	//boundaries are computed exactly as -[XRSectorHistogram calculateBounds] computes them
+	for(int i=0;i<sectors;i++)
+	{
+		float angle1 = ((float)i * sectorSize) + startAngle;
+		float angle2 = angle1 + sectorSize;
+		float angle3, angle4;
+		int edge1, edge2;
+		if(angle1 >= 360.0)
+			angle1 = angle1 - 360.0;
+		if(angle2 >= 360.0)
+			angle2 = angle2 - 360.0;
+		edge1 = XRFineAngleEdgeIndex(edges, angle1);
+		edge2 = XRFineAngleEdgeIndex(edges, angle2);
+		if(edge1 < 0 || edge2 < 0)
+			return nil;
+		uint64_t count = [self countFromEdge:edge1 toEdge:edge2 lowerAngle:angle1 upperAngle:angle2];
+		if(isBiDir)
+		{
+			angle3 = angle1 + 180.0;
+			if(angle3 > 360.0)
+				angle3 -= 360.0;
+			angle4 = angle2 + 180.0;
+			if(angle4 > 360.0)
+				angle4 -= 360.0;
+			edge1 = XRFineAngleEdgeIndex(edges, angle3);
+			edge2 = XRFineAngleEdgeIndex(edges, angle4);
+			if(edge1 < 0 || edge2 < 0)
+				return nil;
+			count += [self countFromEdge:edge1 toEdge:edge2 lowerAngle:angle3 upperAngle:angle4];
+		}
+		counts[i] = (int)count;
+	}
+	return [XRSectorHistogram histogramWithCounts:counts startAngle:startAngle sectorSize:sectorSize sectorCount:sectorCount biDirectional:isBiDir];
+}
+
+@end
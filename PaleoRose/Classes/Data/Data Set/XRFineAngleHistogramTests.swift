@@ -0,0 +1,210 @@
+//
+// XRFineAngleHistogramTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import Foundation
+@testable import PaleoRose
+import Testing
+
+struct XRFineAngleHistogramTests {
+
+    // MARK: - Test Setup
+
+    /// Deterministic values and geometries, so a failing case can be reproduced
+    private struct SplitMix64: RandomNumberGenerator {
+        var state: UInt64
+
+        mutating func next() -> UInt64 {
+            state &+= 0x9E37_79B9_7F4A_7C15
+            var value = state
+            value = (value ^ (value >> 30)) &* 0xBF58_476D_1CE4_E5B9
+            value = (value ^ (value >> 27)) &* 0x94D0_49BB_1331_11EB
+            return value ^ (value >> 31)
+        }
+    }
+
+    typealias Geometry = XRDataSet.SectorGeometry
+
+    /// Geometries whose boundaries all fall on bin edges
+    static let alignedGeometries: [Geometry] = [
+        Geometry(sectorCount: 36, startAngle: 0, biDir: false),
+        Geometry(sectorCount: 36, startAngle: 0, biDir: true),
+        Geometry(sectorCount: 72, startAngle: 2.5, biDir: false),
+        Geometry(sectorCount: 72, startAngle: 2.5, biDir: true),
+        Geometry(sectorCount: 24, startAngle: 359.5, biDir: true),
+        Geometry(sectorCount: 8, startAngle: 0.25, biDir: true),
+        Geometry(sectorCount: 4, startAngle: 45, biDir: false),
+        Geometry(sectorCount: 1, startAngle: 0, biDir: false)
+    ]
+
+    /// Every bin edge, the floats either side of it, and values no in-range sector counts.
+    private func edgeValues() -> [Float] {
+        var values: [Float] = []
+        for index in 0 ... 36000 {
+            let edge = Float(Double(index) / 100.0)
+            values.append(contentsOf: [edge.nextDown, edge, edge.nextUp])
+        }
+        values.append(contentsOf: [-1.0, -.infinity, 360.0, 365.0, 720.0, .infinity, .nan])
+        return values
+    }
+
+    private func randomValues(count: Int, using generator: inout SplitMix64) -> [Float] {
+        (0 ..< count).map { _ in Float.random(in: -5.0 ..< 365.0, using: &generator) }
+    }
+
+    private func fineCounts(_ histogram: XRFineAngleHistogram, geometry: Geometry) -> [Int32]? {
+        histogram.sectorHistogram(
+            withStartAngle: geometry.startAngle,
+            sectorSize: geometry.sectorSize,
+            sectorCount: geometry.sectorCount,
+            biDirectional: geometry.biDir
+        ).map { sectors in (0 ..< geometry.sectorCount).map { sectors.count(forSector: $0) } }
+    }
+
+    // MARK: - Exactness
+
+    @Test("Sectors on bin edges are counted as the per-sector counter counts them", arguments: alignedGeometries)
+    func matchesLegacyCountsOnEdges(geometry: Geometry) throws {
+        let values = edgeValues()
+        let dataSet = try XRDataSet.stub(values: values)
+        let histogram = try #require(XRFineAngleHistogram(values: values, count: UInt(values.count)))
+
+        let counts = try #require(fineCounts(histogram, geometry: geometry))
+
+        #expect(counts == dataSet.legacySectorCounts(geometry))
+        #expect(histogram.totalCount == UInt(values.count - 1))
+    }
+
+    @Test("Random geometries match the per-sector counter", arguments: [7, 31] as [UInt64])
+    func matchesLegacyCountsForRandomGeometries(seed: UInt64) throws {
+        var generator = SplitMix64(state: seed)
+        let values = randomValues(count: 20000, using: &generator) + edgeValues()
+        let dataSet = try XRDataSet.stub(values: values)
+        let histogram = try #require(XRFineAngleHistogram(values: values, count: UInt(values.count)))
+        let sectorCounts: [Int32] = [2, 3, 8, 12, 16, 24, 36, 45, 60, 72, 90, 120, 144, 180, 360, 720]
+        var readFromBins = 0
+
+        for _ in 0 ..< 100 {
+            let sectorCount = try #require(sectorCounts.randomElement(using: &generator))
+            let geometry = Geometry(
+                sectorCount: sectorCount,
+                startAngle: Float(Double(Int.random(in: 0 ..< 36000, using: &generator)) / 100.0),
+                biDir: Bool.random(using: &generator)
+            )
+            let expected = dataSet.legacySectorCounts(geometry)
+            if let counts = fineCounts(histogram, geometry: geometry) {
+                #expect(counts == expected, "\(geometry.testDescription)")
+                readFromBins += 1
+            }
+            let sectors = try #require(dataSet.sectorHistogram(
+                withStartAngle: geometry.startAngle,
+                sectorSize: geometry.sectorSize,
+                sectorCount: geometry.sectorCount,
+                biDir: geometry.biDir
+            ))
+            #expect((0 ..< geometry.sectorCount).map { sectors.count(forSector: $0) } == expected)
+        }
+        #expect(readFromBins > 0)
+    }
+
+    @Test("Sectors off the bin edges are left to the exact pass")
+    func unalignedSectorsFallBack() throws {
+        let values: [Float] = [1.0, 100.0, 200.0]
+        let histogram = try #require(XRFineAngleHistogram(values: values, count: UInt(values.count)))
+        let dataSet = try XRDataSet.stub(values: values)
+        let geometry = Geometry(sectorCount: 7, startAngle: 0, biDir: false)
+
+        #expect(fineCounts(histogram, geometry: geometry) == nil)
+        #expect(!XRFineAngleHistogram.isBinEdge(0.005))
+        #expect(XRFineAngleHistogram.isBinEdge(359.99))
+        let sectors = try #require(dataSet.sectorHistogram(
+            withStartAngle: geometry.startAngle,
+            sectorSize: geometry.sectorSize,
+            biDir: geometry.biDir
+        ))
+        let counts = (0 ..< geometry.sectorCount).map { sectors.count(forSector: $0) }
+        #expect(counts == dataSet.legacySectorCounts(geometry))
+    }
+
+    @Test("Appended values are counted by later geometries")
+    func appendKeepsBinsCurrent() throws {
+        let dataSet = try XRDataSet.stub(values: [5.0, 15.0, 25.0])
+        _ = dataSet.sectorHistogram(withStartAngle: 0, sectorSize: 10, biDir: false)
+
+        let appended: [Float] = [5.5, 359.995, 0.0]
+        dataSet.append(appended.withUnsafeBufferPointer { Data(buffer: $0) })
+        let geometry = Geometry(sectorCount: 72, startAngle: 0.5, biDir: true)
+        let sectors = try #require(dataSet.sectorHistogram(
+            withStartAngle: geometry.startAngle,
+            sectorSize: geometry.sectorSize,
+            sectorCount: geometry.sectorCount,
+            biDir: geometry.biDir
+        ))
+
+        let counts = (0 ..< geometry.sectorCount).map { sectors.count(forSector: $0) }
+        #expect(counts == dataSet.legacySectorCounts(geometry))
+        #expect(sectors.totalCount == 12)
+    }
+
+    // MARK: - Benchmark
+
+    @Test(
+        "Benchmark start angle scrubbing",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled),
+        arguments: [1_000_000, 10_000_000]
+    )
+    func benchmarkScrubbing(valueCount: Int) throws {
+        let values = (0 ..< valueCount).map { Float(($0 &* 7919) % 36000) / 100.0 }
+        let startAngles = (0 ..< 100).map { Float(Double($0) / 10.0) }
+
+        let exact = Benchmark.measure("exact pass per step, \(valueCount) values", iterations: 1) {
+            for startAngle in startAngles {
+                _ = XRSectorHistogram(
+                    values: values,
+                    count: UInt(values.count),
+                    startAngle: startAngle,
+                    sectorSize: 10,
+                    sectorCount: 36,
+                    biDirectional: true
+                )
+            }
+        }
+        let fine = Benchmark.measure("fine bins, \(valueCount) values", iterations: 1) {
+            let histogram = XRFineAngleHistogram(values: values, count: UInt(values.count))
+            for startAngle in startAngles {
+                _ = histogram?.sectorHistogram(
+                    withStartAngle: startAngle,
+                    sectorSize: 10,
+                    sectorCount: 36,
+                    biDirectional: true
+                )
+            }
+        }
+        let speedup = Benchmark.seconds(exact) / Benchmark.seconds(fine)
+        print("[benchmark] scrubbing speedup at \(valueCount) values: \(speedup)x")
+    }
+}
@@ -0,0 +1,55 @@
+//
+// XRSectorHistogram.h
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+// Sector counts for a complete rose, built in a single pass over a value buffer.
+// Sector i spans [startAngle + i * sectorSize, startAngle + (i + 1) * sectorSize),
+// wrapping at 360 degrees. In bi-directional mode each sector also counts the values
+// of the sector mirrored by 180 degrees, matching -[XRDataSet valueCountFromAngle:toAngle2:biDir:].
+@interface XRSectorHistogram : NSObject
+
+@property (readonly) float startAngle;
+@property (readonly) float sectorSize;
+@property (readonly) int sectorCount;
+@property (readonly) BOOL isBiDirectional;
+@property (readonly) int totalCount;
+@property (readonly) int maxCount;
+
++(instancetype)histogramWithValues:(const float *)values count:(NSUInteger)count startAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDirectional:(BOOL)isBiDir;
+//counts already tallied elsewhere, for example by an SQLite aggregate; values added later are counted as usual
++(instancetype)histogramWithCounts:(const int *)counts startAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDirectional:(BOOL)isBiDir;
+
+//counts further values, e.g. after they are appended to the data set
+-(void)addValues:(const float *)values count:(NSUInteger)count;
+
+-(BOOL)matchesStartAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDirectional:(BOOL)isBiDir;
+
+-(int)countForSector:(int)sector;
+-(const int *)counts NS_RETURNS_INNER_POINTER;
+-(NSArray *)countArray;
+
+@end
@@ -0,0 +1,232 @@
+//
+// XRSectorHistogram.m
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#import "XRSectorHistogram.h"
+#import <math.h>
+
+typedef struct {
+	float lower;
+	float upper;
+} XRSectorBounds;
+
+//same test as -[XRDataSet valueCountFromAngle:toAngle2:]
+static inline BOOL XRSectorContainsValue(XRSectorBounds bounds, float value)
+{
+	if(bounds.lower < bounds.upper)
+		return (bounds.lower <= value) && (value < bounds.upper);
+	return (value >= bounds.lower) || (value < bounds.upper);
+}
+
+static inline void XRCountAllSectors(const XRSectorBounds *bounds, int sectorCount, float value, int *counts)
+{
+	for(int i=0;i<sectorCount;i++)
+	{
+		if(XRSectorContainsValue(bounds[i], value))
+			counts[i]++;
+	}
+}
+
+//Finds the sector a value nominally falls in, then applies the exact boundary test to it
+//and its neighbours so that float rounding at the edges is resolved the same way the
+//per-sector scan resolves it.
+static inline void XRCountNearestSectors(const XRSectorBounds *bounds, int sectorCount, double origin, double sectorSize, float value, int *counts)
+{
+	double position = (double)value - origin;
+	int candidate;
+	if(sectorCount < 3)
+	{
+		XRCountAllSectors(bounds, sectorCount, value, counts);
+		return;
+	}
+	while(position < 0.0)
+		position += 360.0;
+	while(position >= 360.0)
+		position -= 360.0;
+	candidate = (int)(position / sectorSize);
+	if(candidate >= sectorCount)
+		candidate = sectorCount - 1;
+	for(int offset = -1;offset <= 1;offset++)
+	{
+		int i = (candidate + offset + sectorCount) % sectorCount;
+		if(XRSectorContainsValue(bounds[i], value))
+			counts[i]++;
+	}
+}
+
+//the nearest sector lookup is only valid when the sectors tile the circle once
+static BOOL XRSectorBoundsAreCanonical(const XRSectorBounds *bounds, int sectorCount, float sectorSize)
+{
+	if(sectorSize <= 0.0 || fabs(((double)sectorCount * sectorSize) - 360.0) > sectorSize * 0.001)
+		return NO;
+	for(int i=0;i<sectorCount;i++)
+	{
+		if(bounds[i].lower < 0.0 || bounds[i].lower > 360.0 || bounds[i].upper < 0.0 || bounds[i].upper > 360.0)
+			return NO;
+	}
+	return YES;
+}
+
+@interface XRSectorHistogram()
+
+@property (readwrite) float startAngle;
+@property (readwrite) float sectorSize;
+@property (readwrite) int sectorCount;
+@property (readwrite) BOOL isBiDirectional;
+@property (readwrite) int totalCount;
+@property (readwrite) int maxCount;
+@property (nonatomic) NSMutableData *sectorCounts;
+@property (nonatomic) NSMutableData *primaryBounds;
+@property (nonatomic) NSMutableData *mirrorBounds;
+@property (readwrite) BOOL boundsAreCanonical;
+
+@end
+
+@implementation XRSectorHistogram
+
++(instancetype)histogramWithValues:(const float *)values count:(NSUInteger)count startAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDirectional:(BOOL)isBiDir
+{
+	XRSectorHistogram *histogram = [[XRSectorHistogram alloc] init];
+	histogram.startAngle = startAngle;
+	histogram.sectorSize = sectorSize;
+	histogram.sectorCount = MAX(sectorCount, 0);
+	histogram.isBiDirectional = isBiDir;
+	histogram.sectorCounts = [NSMutableData dataWithLength:sizeof(int) * histogram.sectorCount];
+	[histogram calculateBounds];
+	[histogram addValues:values count:count];
+	return histogram;
+}
+
++(instancetype)histogramWithCounts:(const int *)counts startAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDirectional:(BOOL)isBiDir
+{
+	XRSectorHistogram *histogram = [XRSectorHistogram histogramWithValues:NULL count:0 startAngle:startAngle sectorSize:sectorSize sectorCount:sectorCount biDirectional:isBiDir];
+	if(counts && histogram.sectorCount > 0)
+		memcpy([histogram.sectorCounts mutableBytes], counts, sizeof(int) * histogram.sectorCount);
+	[histogram calculateTotals];
+	return histogram;
+}
+
+-(void)calculateBounds
+{
+	int sectors = _sectorCount;
+	XRSectorBounds *primary;
+	XRSectorBounds *mirror;
+	_primaryBounds = [NSMutableData dataWithLength:sizeof(XRSectorBounds) * sectors];
+	_mirrorBounds = [NSMutableData dataWithLength:sizeof(XRSectorBounds) * sectors];
+	primary = (XRSectorBounds *)[_primaryBounds mutableBytes];
+	mirror = (XRSectorBounds *)[_mirrorBounds mutableBytes];
+	//boundaries are computed exactly as -[XRLayerData calculateSectorValues] and
+	//-[XRDataSet valueCountFromAngle:toAngle2:biDir:] compute them
+	for(int i=0;i<sectors;i++)
+	{
+		float angle1 = ((float)i * _sectorSize) + _startAngle;
+		float angle2 = angle1 + _sectorSize;
+		float angle3, angle4;
+		if(angle1 >= 360.0)
+			angle1 = angle1 - 360.0;
+		if(angle2 >= 360.0)
+			angle2 = angle2 - 360.0;
+		angle3 = angle1 + 180.0;
+		if(angle3 > 360.0)
+			angle3 -= 360.0;
+		angle4 = angle2 + 180.0;
+		if(angle4 > 360.0)
+			angle4 -= 360.0;
+		primary[i] = (XRSectorBounds){angle1, angle2};
+		mirror[i] = (XRSectorBounds){angle3, angle4};
+	}
+	_boundsAreCanonical = XRSectorBoundsAreCanonical(primary, sectors, _sectorSize) && (!_isBiDirectional || XRSectorBoundsAreCanonical(mirror, sectors, _sectorSize));
+}
+
+-(void)addValues:(const float *)values count:(NSUInteger)count
+{
+	int sectors = _sectorCount;
+	int *counts = (int *)[_sectorCounts mutableBytes];
+	const XRSectorBounds *primary = (const XRSectorBounds *)[_primaryBounds bytes];
+	const XRSectorBounds *mirror = (const XRSectorBounds *)[_mirrorBounds bytes];
+	BOOL canonical = _boundsAreCanonical;
+	if(sectors == 0 || count == 0)
+		return;
+
+	for(NSUInteger n=0;n<count;n++)
+	{
+		float value = values[n];
+		if(canonical && value >= 0.0 && value < 360.0)
+		{
+			XRCountNearestSectors(primary, sectors, _startAngle, _sectorSize, value, counts);
+			if(_isBiDirectional)
+				XRCountNearestSectors(mirror, sectors, (double)_startAngle + 180.0, _sectorSize, value, counts);
+		}
+		else
+		{
+			XRCountAllSectors(primary, sectors, value, counts);
+			if(_isBiDirectional)
+				XRCountAllSectors(mirror, sectors, value, counts);
+		}
+	}
+
+	[self calculateTotals];
+}
+
+-(void)calculateTotals
+{
+	const int *counts = (const int *)[_sectorCounts bytes];
+	_totalCount = 0;
+	_maxCount = 0;
+	for(int i=0;i<_sectorCount;i++)
+	{
+		_totalCount += counts[i];
+		if(counts[i] > _maxCount)
+			_maxCount = counts[i];
+	}
+}
+
+-(BOOL)matchesStartAngle:(float)startAngle sectorSize:(float)sectorSize sectorCount:(int)sectorCount biDirectional:(BOOL)isBiDir
+{
+	return (_startAngle == startAngle) && (_sectorSize == sectorSize) && (_sectorCount == sectorCount) && (_isBiDirectional == isBiDir);
+}
+
+-(int)countForSector:(int)sector
+{
+	if(sector < 0 || sector >= _sectorCount)
+		return 0;
+	return ((const int *)[_sectorCounts bytes])[sector];
+}
+
+-(const int *)counts
+{
+	return (const int *)[_sectorCounts bytes];
+}
+
+-(NSArray *)countArray
+{
+	NSMutableArray *theArray = [[NSMutableArray alloc] initWithCapacity:_sectorCount];
+	const int *counts = [self counts];
+	for(int i=0;i<_sectorCount;i++)
+		[theArray addObject:[NSNumber numberWithInt:counts[i]]];
+	return theArray;
+}
+
+@end
@@ -0,0 +1,132 @@
+//
+// XRSectorHistogramTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import Foundation
+@testable import PaleoRose
+import Testing
+
+struct XRSectorHistogramTests {
+
+    // MARK: - Test Setup
+
+    typealias Geometry = XRDataSet.SectorGeometry
+
+    static let geometries: [Geometry] = [
+        Geometry(sectorCount: 36, startAngle: 0, biDir: false),
+        Geometry(sectorCount: 36, startAngle: 0, biDir: true),
+        Geometry(sectorCount: 72, startAngle: 2.5, biDir: false),
+        Geometry(sectorCount: 72, startAngle: 2.5, biDir: true),
+        Geometry(sectorCount: 7, startAngle: 10, biDir: false),
+        Geometry(sectorCount: 7, startAngle: 10, biDir: true),
+        Geometry(sectorCount: 4, startAngle: 45, biDir: true),
+        Geometry(sectorCount: 2, startAngle: 90, biDir: false),
+        Geometry(sectorCount: 24, startAngle: 359.5, biDir: true)
+    ]
+
+    /// Every hundredth of a degree, so that every sector boundary is hit exactly, plus
+    /// a few out of range values that only the wrapping sector may count.
+    private func boundaryValues() -> [Float] {
+        var values = (0 ... 36000).map { Float($0) / 100.0 }
+        values.append(contentsOf: [-1.0, 360.0, 365.0, 720.0])
+        return values
+    }
+
+    // MARK: - Exactness
+
+    @Test("Histogram matches per-sector counting", arguments: geometries)
+    func matchesLegacyCounts(geometry: Geometry) throws {
+        let dataSet = try XRDataSet.stub(values: boundaryValues())
+
+        let histogram = try #require(dataSet.sectorHistogram(
+            withStartAngle: geometry.startAngle,
+            sectorSize: geometry.sectorSize,
+            sectorCount: geometry.sectorCount,
+            biDir: geometry.biDir
+        ))
+
+        let expected = dataSet.legacySectorCounts(geometry)
+        let counts = (0 ..< geometry.sectorCount).map { histogram.count(forSector: $0) }
+        #expect(counts == expected)
+        #expect(histogram.totalCount == expected.reduce(0, +))
+        #expect(histogram.maxCount == expected.max())
+    }
+
+    @Test("Histogram is reused until the data set changes")
+    func cachesUntilAppend() throws {
+        let dataSet = try XRDataSet.stub(values: [5.0, 15.0, 25.0])
+        let first = dataSet.sectorHistogram(withStartAngle: 0, sectorSize: 10, biDir: false)
+        let second = dataSet.sectorHistogram(withStartAngle: 0, sectorSize: 10, sectorCount: 36, biDir: false)
+        #expect(first === second)
+
+        let appended: [Float] = [5.0]
+        dataSet.append(appended.withUnsafeBufferPointer { Data(buffer: $0) })
+        let third = try #require(dataSet.sectorHistogram(withStartAngle: 0, sectorSize: 10, biDir: false))
+        #expect(first !== third)
+        #expect(third.count(forSector: 0) == 2)
+    }
+
+    @Test("Mean count and chi-squared read the same histogram")
+    func statisticsShareHistogram() throws {
+        let dataSet = try XRDataSet.stub(values: boundaryValues())
+        let histogram = try #require(dataSet.sectorHistogram(withStartAngle: 0, sectorSize: 10, biDir: true))
+
+        let meanCount = try #require(dataSet.meanCount(withIncrement: 10, startingAngle: 0, isBiDirectional: true))
+        let mean = try #require(meanCount["mean"] as? NSNumber)
+        _ = dataSet.chiSquared(withStartAngle: 0, sectorSize: 10, isBiDir: true)
+
+        #expect(mean.floatValue == Float(histogram.totalCount) / 36.0)
+        #expect(dataSet.sectorHistogram(withStartAngle: 0, sectorSize: 10, biDir: true) === histogram)
+    }
+
+    // MARK: - Benchmark
+
+    @Test(
+        "Benchmark sector counting",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled),
+        arguments: [10000, 1_000_000, 10_000_000]
+    )
+    func benchmarkSectorCounting(valueCount: Int) throws {
+        let values = (0 ..< valueCount).map { Float(($0 &* 7919) % 36000) / 100.0 }
+        let dataSet = try XRDataSet.stub(values: values)
+        let geometry = Geometry(sectorCount: 72, startAngle: 0, biDir: true)
+
+        let legacy = Benchmark.measure("per-sector scan, \(valueCount) values", iterations: 1) {
+            _ = dataSet.legacySectorCounts(geometry)
+        }
+        let single = Benchmark.measure("single-pass histogram, \(valueCount) values") {
+            _ = XRSectorHistogram(
+                values: values,
+                count: UInt(values.count),
+                startAngle: geometry.startAngle,
+                sectorSize: geometry.sectorSize,
+                sectorCount: geometry.sectorCount,
+                biDirectional: geometry.biDir
+            )
+        }
+        print("[benchmark] speedup at \(valueCount) values: \(Benchmark.seconds(legacy) / Benchmark.seconds(single))x")
+    }
+}
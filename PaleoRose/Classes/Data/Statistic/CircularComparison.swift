@@ -0,0 +1,124 @@
+//
+// CircularComparison.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import Foundation
+
+/// Two-sample comparisons of circular data sets, computed from each set's cached vector sums.
+///
+/// A data set's resultant is a sufficient statistic for the F test: the pooled sample's resultant is
+/// the sum of the two, so no values are copied and no combined set is built. Summaries are read with
+/// `circularSummary(forBiDir:)`, which leaves the sets' displayed statistics alone and posts nothing,
+/// so the matrix can be filled from several threads.
+enum CircularComparison {
+
+    struct FTest {
+        let first: XRCircularSummary
+        let second: XRCircularSummary
+        let pooled: XRCircularSummary
+        /// `nil` when the pooled κ is below 2 and the statistic is not defined.
+        let fStatistic: Float?
+
+        var degreesOfFreedom: (Int, Int) {
+            (1, Int(pooled.count) - 2)
+        }
+
+        init(first: XRCircularSummary, second: XRCircularSummary, calculationType: Int32) {
+            self.first = first
+            self.second = second
+            pooled = XRCircularSummaryPooled(first, second, calculationType)
+            var statistic: Float = 0
+            fStatistic = XRCircularSummaryFStatistic(first, second, pooled, &statistic) ? statistic : nil
+        }
+    }
+
+    static func fTest(_ first: XRDataSet, _ second: XRDataSet, biDirectional: Bool) -> FTest {
+        FTest(
+            first: first.circularSummary(forBiDir: biDirectional),
+            second: second.circularSummary(forBiDir: biDirectional),
+            calculationType: XRDataSet.vectorCalculationMethod()
+        )
+    }
+
+    /// F tests for every pair of `dataSets`. Entry `[i][j]` compares set `i` with set `j`; the
+    /// diagonal is `nil`. Each set is summarized once, then the pairs are spread across all cores.
+    static func fTestMatrix(
+        _ dataSets: [XRDataSet],
+        biDirectional: Bool,
+        concurrently: Bool = true
+    ) -> [[FTest?]] {
+        let count = dataSets.count
+        let calculationType = XRDataSet.vectorCalculationMethod()
+        var summaries = [XRCircularSummary](repeating: XRCircularSummary(), count: count)
+        summaries.withUnsafeMutableBufferPointer { buffer in
+            perform(count, concurrently: concurrently) { index in
+                buffer[index] = dataSets[index].circularSummary(forBiDir: biDirectional)
+            }
+        }
+
+        let pairs = (0 ..< count).flatMap { row in (row + 1 ..< count).map { (row, $0) } }
+        var results = [FTest?](repeating: nil, count: pairs.count)
+        results.withUnsafeMutableBufferPointer { buffer in
+            perform(pairs.count, concurrently: concurrently) { index in
+                let (row, column) = pairs[index]
+                buffer[index] = FTest(first: summaries[row], second: summaries[column], calculationType: calculationType)
+            }
+        }
+
+        var matrix = [[FTest?]](repeating: [FTest?](repeating: nil, count: count), count: count)
+        for (index, (row, column)) in pairs.enumerated() {
+            guard let test = results[index] else {
+                continue
+            }
+            matrix[row][column] = test
+            matrix[column][row] = FTest(first: test.second, second: test.first, calculationType: calculationType)
+        }
+        return matrix
+    }
+
+    /// Tab delimited F statistics for `fTestMatrix`, with data set names as row and column headers.
+    static func matrixReport(names: [String], matrix: [[FTest?]]) -> String {
+        var lines = ["\t" + names.joined(separator: "\t")]
+        for (name, row) in zip(names, matrix) {
+            let cells = row.map { test -> String in
+                guard let test else {
+                    return "-"
+                }
+                return test.fStatistic.map { String(format: "%f", $0) } ?? "n/c"
+            }
+            lines.append(([name] + cells).joined(separator: "\t"))
+        }
+        return lines.joined(separator: "\n")
+    }
+
+    private static func perform(_ iterations: Int, concurrently: Bool, _ body: (Int) -> Void) {
+        if concurrently {
+            DispatchQueue.concurrentPerform(iterations: iterations, execute: body)
+        } else {
+            (0 ..< iterations).forEach(body)
+        }
+    }
+}
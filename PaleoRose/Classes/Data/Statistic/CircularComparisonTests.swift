@@ -0,0 +1,186 @@
+//
+// CircularComparisonTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import Foundation
+import Numerics
+@testable import PaleoRose
+import Testing
+
+@Suite("CircularComparison", .serialized)
+struct CircularComparisonTests {
+
+    // MARK: - Test Setup
+
+    private func values(count: Int, center: Float, spread: Int, seed: Int) -> [Float] {
+        (0 ..< count).map { index in
+            let offset = Float((((index &+ seed) &* 7919) % (spread * 100))) / 100.0 - Float(spread) / 2.0
+            let angle = center + offset
+            return angle < 0 ? angle + 360 : angle
+        }
+    }
+
+    // MARK: - Tests
+
+    @Test("The pooled summary matches summarizing the combined values", arguments: [false, true])
+    func pooledMatchesCombinedSet(biDir: Bool) throws {
+        let first = values(count: 3000, center: 40, spread: 30, seed: 1)
+        let second = values(count: 2000, center: 55, spread: 20, seed: 2)
+        let combined = try XRDataSet.stub(values: first + second)
+
+        let test = try CircularComparison.fTest(
+            XRDataSet.stub(values: first),
+            XRDataSet.stub(values: second),
+            biDirectional: biDir
+        )
+        let expected = combined.circularSummary(forBiDir: biDir)
+
+        #expect(test.pooled.count == expected.count)
+        #expect(test.pooled.resultant.count == expected.resultant.count)
+        #expect(test.pooled.resultantLength.isApproximatelyEqual(to: expected.resultantLength, relativeTolerance: 1e-5))
+        #expect(test.pooled.meanResultantLength.isApproximatelyEqual(to: expected.meanResultantLength, relativeTolerance: 1e-5))
+        #expect(test.pooled.kappa.isApproximatelyEqual(to: expected.kappa, relativeTolerance: 1e-4))
+        #expect(test.pooled.meanDirection.isApproximatelyEqual(to: expected.meanDirection, absoluteTolerance: 1e-3))
+        #expect(test.degreesOfFreedom == (1, 4998))
+    }
+
+    @Test("The F statistic follows the κ dependent correction")
+    func fStatistic() throws {
+        let first = try XRDataSet.stub(values: values(count: 500, center: 90, spread: 20, seed: 3))
+        let second = try XRDataSet.stub(values: values(count: 700, center: 100, spread: 20, seed: 4))
+
+        let test = CircularComparison.fTest(first, second, biDirectional: false)
+
+        let kp = test.pooled.kappa
+        let n = Float(test.pooled.count)
+        let (r1, r2, rp) = (test.first.resultantLength, test.second.resultantLength, test.pooled.resultantLength)
+        var expected = (n - 2) * (r1 + r2 - rp) / (n - r1 - r2)
+        if kp < 10 {
+            expected *= 1 + 3 / (8 * kp)
+        }
+        let statistic = try #require(test.fStatistic)
+        #expect(kp >= 2)
+        #expect(statistic.isApproximatelyEqual(to: expected, relativeTolerance: 1e-4))
+    }
+
+    @Test("Dispersed samples have no F statistic")
+    func lowKappaIsNotCalculable() throws {
+        let uniform = (0 ..< 3600).map { Float($0) / 10.0 }
+
+        let test = try CircularComparison.fTest(
+            XRDataSet.stub(values: uniform),
+            XRDataSet.stub(values: uniform),
+            biDirectional: false
+        )
+
+        #expect(test.pooled.kappa < 2)
+        #expect(test.fStatistic == nil)
+    }
+
+    @Test("Comparing sets copies no values and leaves their statistics alone")
+    func noCopiesOrNotifications() throws {
+        let sets = try (0 ..< 4).map {
+            try XRDataSet.stub(values: values(count: 1000, center: Float($0) * 10, spread: 30, seed: $0))
+        }
+        sets.forEach { _ = $0.circularResultant(false) }
+        let copies = sets.map { $0.valueCopyCount() }
+        var notifications = 0
+        let observer = NotificationCenter.default.addObserver(
+            forName: NSNotification.Name(XRDataSetChangedStatisticsNotification),
+            object: nil,
+            queue: nil
+        ) { note in
+            // Other suites may post for their own data sets at the same time
+            if let object = note.object as? XRDataSet, sets.contains(where: { $0 === object }) {
+                notifications += 1
+            }
+        }
+        defer { NotificationCenter.default.removeObserver(observer) }
+
+        _ = CircularComparison.fTestMatrix(sets, biDirectional: false)
+
+        #expect(sets.map { $0.valueCopyCount() } == copies)
+        #expect(notifications == 0)
+        #expect(sets.allSatisfy { $0.currentStatistics() == nil })
+    }
+
+    @Test("The all-pairs matrix is symmetric and matches pairwise tests")
+    func matrix() throws {
+        let sets = try (0 ..< 6).map {
+            try XRDataSet.stub(values: values(count: 400 + $0 * 50, center: Float($0) * 5 + 30, spread: 25, seed: $0))
+        }
+
+        let matrix = CircularComparison.fTestMatrix(sets, biDirectional: false)
+        let serial = CircularComparison.fTestMatrix(sets, biDirectional: false, concurrently: false)
+
+        #expect(matrix.count == sets.count)
+        for row in 0 ..< sets.count {
+            #expect(matrix[row][row] == nil)
+            for column in 0 ..< sets.count where column != row {
+                let test = try #require(matrix[row][column])
+                let transposed = try #require(matrix[column][row])
+                let pairwise = CircularComparison.fTest(sets[row], sets[column], biDirectional: false)
+                #expect(test.fStatistic == pairwise.fStatistic)
+                #expect(test.fStatistic == transposed.fStatistic)
+                #expect(test.fStatistic == serial[row][column]?.fStatistic)
+            }
+        }
+
+        let report = CircularComparison.matrixReport(names: sets.map { $0.name() }, matrix: matrix)
+        #expect(report.split(separator: "\n").count == sets.count + 1)
+    }
+
+    // MARK: - Benchmark
+
+    @Test(
+        "Benchmark all-pairs F test matrix",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkMatrix() throws {
+        let sets = try (0 ..< 200).map {
+            try XRDataSet.stub(values: values(count: 50000, center: Float($0 % 36) * 10, spread: 40, seed: $0))
+        }
+
+        let copied = try Benchmark.measure("copy and concatenate, 20 pairs", iterations: 1) {
+            for index in 0 ..< 20 {
+                let pooled = try XRDataSet.stub(
+                    values: sets[index].withValues { Array($0) } + sets[index + 1].withValues { Array($0) }
+                )
+                _ = pooled.calculateCircularSummary(forBiDir: false)
+            }
+        }
+        print("[benchmark] copying path, per pair: \(Benchmark.seconds(copied) / 20 * 1e3) ms")
+
+        let serial = Benchmark.measure("matrix of \(sets.count) sets, serial") {
+            _ = CircularComparison.fTestMatrix(sets, biDirectional: false, concurrently: false)
+        }
+        let parallel = Benchmark.measure("matrix of \(sets.count) sets, parallel") {
+            _ = CircularComparison.fTestMatrix(sets, biDirectional: false)
+        }
+        print("[benchmark] parallel speedup \(Benchmark.seconds(serial) / Benchmark.seconds(parallel))x")
+    }
+}
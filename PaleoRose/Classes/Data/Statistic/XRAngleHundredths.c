@@ -0,0 +1,81 @@
+//
+// XRAngleHundredths.c
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "XRAngleHundredths.h"
+#include <math.h>
+#include <pthread.h>
+#include <string.h>
+
+static XRAngleSinCos XRAngleTable[XRAngleHundredthsCount];
+static pthread_once_t XRAngleTableOnce = PTHREAD_ONCE_INIT;
+
+static void XRAngleTableBuild(void)
+{
+	for(int h=0;h<XRAngleHundredthsCount;h++)
+	{
+		double radians = ((double)h / (double)XRAngleHundredthsPerDegree) * (M_PI / 180.0);
+		XRAngleTable[h].cos = cos(radians);
+		XRAngleTable[h].sin = sin(radians);
+	}
+}
+
+const XRAngleSinCos *XRAngleHundredthsSinCosTable(void)
+{
+	pthread_once(&XRAngleTableOnce, XRAngleTableBuild);
+	return XRAngleTable;
+}
+
+float XRAngleHundredthsToDegrees(XRAngleHundredths hundredths)
+{
+	return (float)((double)hundredths / (double)XRAngleHundredthsPerDegree);
+}
+
+bool XRAngleHundredthsFromDegreesExactly(float value, XRAngleHundredths *hundredths)
+{
+	if(!(value >= 0.0f && value < 360.0f))
+		return false;
+	long h = lround((double)value * XRAngleHundredthsPerDegree);
+	if(h >= XRAngleHundredthsCount)
+		return false;
+	//compared as bits, so that -0 is not taken for 0
+	float decoded = XRAngleHundredthsToDegrees((XRAngleHundredths)h);
+	if(memcmp(&decoded, &value, sizeof(float)) != 0)
+		return false;
+	*hundredths = (XRAngleHundredths)h;
+	return true;
+}
+
+bool XRAngleHundredthsFromDegreesRounded(float value, XRAngleHundredths *hundredths)
+{
+	if(!isfinite(value))
+		return false;
+	double h = fmod(round((double)value * XRAngleHundredthsPerDegree), (double)XRAngleHundredthsCount);
+	if(h < 0.0)
+		h += XRAngleHundredthsCount;
+	*hundredths = (XRAngleHundredths)h;
+	return true;
+}
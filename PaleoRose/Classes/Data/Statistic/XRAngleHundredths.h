@@ -0,0 +1,59 @@
+//
+// XRAngleHundredths.h
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef XRAngleHundredths_h
+#define XRAngleHundredths_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Azimuths held as hundredths of a degree in [0, 36000), the resolution compass readings are
+// taken at. Hundredths h stands for the float nearest h / 100, which is also bin edge h of
+// XRFineAngleHistogram, so counts made from hundredths match counts made from those floats.
+#define XRAngleHundredthsPerDegree 100
+#define XRAngleHundredthsCount 36000 //360 * XRAngleHundredthsPerDegree
+
+typedef uint16_t XRAngleHundredths;
+
+float XRAngleHundredthsToDegrees(XRAngleHundredths hundredths);
+
+// true only when value decodes back to the same float, bit for bit
+bool XRAngleHundredthsFromDegreesExactly(float value, XRAngleHundredths *hundredths);
+
+// the nearest hundredth, wrapped into [0, 360); false for NaN and infinities
+bool XRAngleHundredthsFromDegreesRounded(float value, XRAngleHundredths *hundredths);
+
+// cos and sin of every hundredth of a degree, built on first use. Interleaved so that looking
+// up one angle touches one cache line.
+typedef struct {
+	double cos;
+	double sin;
+} XRAngleSinCos;
+
+const XRAngleSinCos *XRAngleHundredthsSinCosTable(void);
+
+#endif /* XRAngleHundredths_h */
@@ -0,0 +1,155 @@
+//
+// XRCircularResultant.c
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "XRCircularResultant.h"
+#include <math.h>
+
+#if __has_include(<Accelerate/Accelerate.h>)
+#include <Accelerate/Accelerate.h>
+#define XR_CIRCULAR_RESULTANT_ACCELERATE 1
+#endif
+
+// Values are processed in blocks; each block is summed in float and the block sums are
+// accumulated in double, which keeps R̅ stable for very large sets.
+#define XRCircularResultantBlockSize 1024
+
+static const double XRDegreesToRadians = M_PI / 180.0;
+
+// Reduces multiplier * degrees into [0, 360) before the conversion to radians, so the
+// float sin and cos see small arguments.
+static inline float XRCircularReducedRadians(float degrees, int angleMultiplier)
+{
+	double angle = (double)degrees * (double)angleMultiplier;
+	angle -= 360.0 * floor(angle / 360.0);
+	return (float)(angle * XRDegreesToRadians);
+}
+
+XRCircularResultant XRCircularResultantMake(double sumCos, double sumSin, size_t count)
+{
+	XRCircularResultant result;
+	result.count = count;
+	result.sumCos = sumCos;
+	result.sumSin = sumSin;
+	result.meanCos = (count > 0) ? sumCos / (double)count : 0.0;
+	result.meanSin = (count > 0) ? sumSin / (double)count : 0.0;
+	return result;
+}
+
+XRCircularResultant XRCircularResultantAdd(XRCircularResultant lhs, XRCircularResultant rhs)
+{
+	return XRCircularResultantMake(lhs.sumCos + rhs.sumCos, lhs.sumSin + rhs.sumSin, lhs.count + rhs.count);
+}
+
+XRCircularResultant XRCircularResultantMirrored(XRCircularResultant unidirectional, int angleMultiplier)
+{
+	// cos(Θ + 180) = -cos Θ, but cos(2Θ + 360) = cos 2Θ
+	double mirror = (angleMultiplier % 2 == 0) ? 1.0 : -1.0;
+	return XRCircularResultantMake(unidirectional.sumCos + mirror * unidirectional.sumCos,
+								   unidirectional.sumSin + mirror * unidirectional.sumSin,
+								   unidirectional.count * 2);
+}
+
+static XRCircularResultant XRCircularResultantFinish(double sumCos, double sumSin, size_t count, int angleMultiplier, bool biDirectional)
+{
+	XRCircularResultant result = XRCircularResultantMake(sumCos, sumSin, count);
+	if(biDirectional)
+		result = XRCircularResultantMirrored(result, angleMultiplier);
+	return result;
+}
+
+XRCircularResultant XRCircularResultantComputeScalar(const float *values, size_t count, int angleMultiplier, bool biDirectional)
+{
+	double sumCos = 0.0;
+	double sumSin = 0.0;
+	for(size_t start = 0; start < count; start += XRCircularResultantBlockSize)
+	{
+		size_t end = (count - start < XRCircularResultantBlockSize) ? count : start + XRCircularResultantBlockSize;
+		double blockCos = 0.0;
+		double blockSin = 0.0;
+		for(size_t i = start; i < end; i++)
+		{
+			double radians = XRCircularReducedRadians(values[i], angleMultiplier);
+			blockCos += cos(radians);
+			blockSin += sin(radians);
+		}
+		sumCos += blockCos;
+		sumSin += blockSin;
+	}
+	return XRCircularResultantFinish(sumCos, sumSin, count, angleMultiplier, biDirectional);
+}
+
+XRCircularResultant XRCircularResultantCompute(const float *values, size_t count, int angleMultiplier, bool biDirectional)
+{
+#if XR_CIRCULAR_RESULTANT_ACCELERATE
+	float radians[XRCircularResultantBlockSize];
+	float sines[XRCircularResultantBlockSize];
+	float cosines[XRCircularResultantBlockSize];
+	double sumCos = 0.0;
+	double sumSin = 0.0;
+	for(size_t start = 0; start < count; start += XRCircularResultantBlockSize)
+	{
+		int blockCount = (int)((count - start < XRCircularResultantBlockSize) ? count - start : XRCircularResultantBlockSize);
+		float blockCos = 0.0f;
+		float blockSin = 0.0f;
+		for(int i = 0; i < blockCount; i++)
+			radians[i] = XRCircularReducedRadians(values[start + i], angleMultiplier);
+		vvsincosf(sines, cosines, radians, &blockCount);
+		vDSP_sve(cosines, 1, &blockCos, (vDSP_Length)blockCount);
+		vDSP_sve(sines, 1, &blockSin, (vDSP_Length)blockCount);
+		sumCos += blockCos;
+		sumSin += blockSin;
+	}
+	return XRCircularResultantFinish(sumCos, sumSin, count, angleMultiplier, biDirectional);
+#else
+	return XRCircularResultantComputeScalar(values, count, angleMultiplier, biDirectional);
+#endif
+}
+
+XRCircularResultant XRCircularResultantComputeHundredths(const XRAngleHundredths *hundredths, size_t count, int angleMultiplier, bool biDirectional)
+{
+	const XRAngleSinCos *table = XRAngleHundredthsSinCosTable();
+	double sumCos = 0.0;
+	double sumSin = 0.0;
+	if(angleMultiplier == 1)
+	{
+		for(size_t i = 0; i < count; i++)
+		{
+			sumCos += table[hundredths[i]].cos;
+			sumSin += table[hundredths[i]].sin;
+		}
+	}
+	else
+	{
+		uint32_t multiplier = (uint32_t)angleMultiplier;
+		for(size_t i = 0; i < count; i++)
+		{
+			uint32_t index = ((uint32_t)hundredths[i] * multiplier) % XRAngleHundredthsCount;
+			sumCos += table[index].cos;
+			sumSin += table[index].sin;
+		}
+	}
+	return XRCircularResultantFinish(sumCos, sumSin, count, angleMultiplier, biDirectional);
+}
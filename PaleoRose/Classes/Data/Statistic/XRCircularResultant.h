@@ -0,0 +1,63 @@
+//
+// XRCircularResultant.h
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef XRCircularResultant_h
+#define XRCircularResultant_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "XRAngleHundredths.h"
+
+// Vector sums of a set of azimuths, in degrees.
+//
+// angleMultiplier is 1 for the standard vector calculation and 2 for the doubled-angle
+// method used with axial data. The bi-directional mirror (every value + 180 degrees) is
+// folded in analytically: with a multiplier of 1 the mirror cancels the primary sums, with
+// a multiplier of 2 it duplicates them. Sums are accumulated in double.
+typedef struct {
+	size_t count;   // number of vectors summed, doubled when bi-directional
+	double sumCos;  // Σ cos Θ  (X vector)
+	double sumSin;  // Σ sin Θ  (Y vector)
+	double meanCos; // C̅
+	double meanSin; // S̅
+} XRCircularResultant;
+
+XRCircularResultant XRCircularResultantCompute(const float *values, size_t count, int angleMultiplier, bool biDirectional);
+
+// The same sums for angles stored as hundredths of a degree (see XRAngleHundredths.h); every
+// cos and sin is read from the table rather than computed. angleMultiplier must be positive.
+XRCircularResultant XRCircularResultantComputeHundredths(const XRAngleHundredths *hundredths, size_t count, int angleMultiplier, bool biDirectional);
+
+// Helpers for maintaining running sums: combine the resultants of two disjoint sets of
+// values, and add the bi-directional mirror to a unidirectional resultant.
+XRCircularResultant XRCircularResultantMake(double sumCos, double sumSin, size_t count);
+XRCircularResultant XRCircularResultantAdd(XRCircularResultant lhs, XRCircularResultant rhs);
+XRCircularResultant XRCircularResultantMirrored(XRCircularResultant unidirectional, int angleMultiplier);
+
+// Plain C loop used when Accelerate is not available; exposed so the two can be compared.
+XRCircularResultant XRCircularResultantComputeScalar(const float *values, size_t count, int angleMultiplier, bool biDirectional);
+
+#endif /* XRCircularResultant_h */
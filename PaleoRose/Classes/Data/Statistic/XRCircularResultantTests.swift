@@ -0,0 +1,134 @@
+//
+// XRCircularResultantTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import Foundation
+import Numerics
+@testable import PaleoRose
+import Testing
+
+struct XRCircularResultantTests {
+
+    // MARK: - Test Setup
+
+    struct Configuration: CustomTestStringConvertible {
+        let angleMultiplier: Int32
+        let biDir: Bool
+
+        var testDescription: String { "multiplier \(angleMultiplier)\(biDir ? " bi-dir" : "")" }
+    }
+
+    static let configurations: [Configuration] = [
+        Configuration(angleMultiplier: 1, biDir: false),
+        Configuration(angleMultiplier: 1, biDir: true),
+        Configuration(angleMultiplier: 2, biDir: false),
+        Configuration(angleMultiplier: 2, biDir: true)
+    ]
+
+    private let values: [Float] = (0 ..< 5000).map { Float(($0 &* 104_729) % 36000) / 100.0 }
+
+    /// Straightforward double precision sums, mirroring each value explicitly.
+    private func reference(_ values: [Float], configuration: Configuration) -> (sumCos: Double, sumSin: Double, count: Int) {
+        var angles = values.map { Double($0) }
+        if configuration.biDir {
+            angles += values.map { Double($0) + 180.0 }
+        }
+        let radians = angles.map { $0 * Double(configuration.angleMultiplier) * .pi / 180.0 }
+        return (radians.map(cos).reduce(0, +), radians.map(sin).reduce(0, +), angles.count)
+    }
+
+    // MARK: - Tests
+
+    @Test("Fused sums match a per-value reference", arguments: configurations)
+    func matchesReference(configuration: Configuration) {
+        let expected = reference(values, configuration: configuration)
+
+        let result = XRCircularResultantCompute(values, values.count, configuration.angleMultiplier, configuration.biDir)
+
+        #expect(result.count == expected.count)
+        #expect(result.sumCos.isApproximatelyEqual(to: expected.sumCos, absoluteTolerance: 1e-3))
+        #expect(result.sumSin.isApproximatelyEqual(to: expected.sumSin, absoluteTolerance: 1e-3))
+        #expect(result.meanCos.isApproximatelyEqual(to: expected.sumCos / Double(expected.count), absoluteTolerance: 1e-6))
+        #expect(result.meanSin.isApproximatelyEqual(to: expected.sumSin / Double(expected.count), absoluteTolerance: 1e-6))
+    }
+
+    @Test("Vectorized and scalar paths agree", arguments: configurations)
+    func vectorizedMatchesScalar(configuration: Configuration) {
+        let vectorized = XRCircularResultantCompute(values, values.count, configuration.angleMultiplier, configuration.biDir)
+        let scalar = XRCircularResultantComputeScalar(values, values.count, configuration.angleMultiplier, configuration.biDir)
+
+        #expect(vectorized.sumCos.isApproximatelyEqual(to: scalar.sumCos, absoluteTolerance: 1e-3))
+        #expect(vectorized.sumSin.isApproximatelyEqual(to: scalar.sumSin, absoluteTolerance: 1e-3))
+    }
+
+    @Test("Mean resultant length stays exact for a large concentrated set")
+    func largeSetIsStable() {
+        let concentrated = [Float](repeating: 30.0, count: 4_000_000)
+
+        let result = XRCircularResultantCompute(concentrated, concentrated.count, 1, false)
+        let rBar = (result.meanCos * result.meanCos + result.meanSin * result.meanSin).squareRoot()
+
+        #expect(rBar.isApproximatelyEqual(to: 1.0, absoluteTolerance: 1e-6))
+        #expect(result.sumCos.isApproximatelyEqual(to: 4_000_000 * cos(Double.pi / 6.0), relativeTolerance: 1e-6))
+    }
+
+    @Test("Data set vector statistics come from the fused kernel")
+    func dataSetStatistics() throws {
+        let dataSet = try XRDataSet.stub(values: values, name: "Resultant")
+        let resultant = dataSet.circularResultant(false)
+
+        _ = dataSet.calculateStatisticObjects(forBiDir: false)
+
+        let xVector = try #require(dataSet.currentStatistic(withName: "X Vector"))
+        let yVector = try #require(dataSet.currentStatistic(withName: "Y Vector"))
+        #expect(xVector.floatValue() == Float(resultant.sumCos))
+        #expect(yVector.floatValue() == Float(resultant.sumSin))
+    }
+
+    // MARK: - Benchmark
+
+    @Test(
+        "Benchmark resultant kernel",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled),
+        arguments: [1_000_000, 100_000_000]
+    )
+    func benchmarkResultant(valueCount: Int) {
+        let large = (0 ..< valueCount).map { Float(($0 &* 7919) % 36000) / 100.0 }
+        let vectorized = Benchmark.measure("fused resultant, \(valueCount) values") {
+            _ = XRCircularResultantCompute(large, large.count, 2, true)
+        }
+        let scalar = Benchmark.measure("scalar resultant, \(valueCount) values") {
+            _ = XRCircularResultantComputeScalar(large, large.count, 2, true)
+        }
+        print("[benchmark] fused: \(Benchmark.seconds(vectorized) * 1e9 / Double(valueCount)) ns/sample")
+        print("[benchmark] scalar: \(Benchmark.seconds(scalar) * 1e9 / Double(valueCount)) ns/sample")
+
+        let concentrated = [Float](repeating: 45.0, count: valueCount)
+        let result = XRCircularResultantCompute(concentrated, concentrated.count, 1, false)
+        let rBar = (result.meanCos * result.meanCos + result.meanSin * result.meanSin).squareRoot()
+        #expect(rBar.isApproximatelyEqual(to: 1.0, absoluteTolerance: 1e-6))
+    }
+}
@@ -0,0 +1,110 @@
+//
+// XRCircularSummary.c
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "XRCircularSummary.h"
+#include <math.h>
+
+// The constant -[XRDataSet degreesFromRadians:] has always used; kept so that saved
+// reports and the inspector do not shift in the last digits.
+static const double XRSummaryPi = 3.14159265358989323846;
+
+static inline double XRSummaryDegrees(double radians)
+{
+	return 180.0 * radians / XRSummaryPi;
+}
+
+float XRCircularSummaryRayleighProbability(int count, float meanResultantLength)
+{
+	float stat = count * meanResultantLength * meanResultantLength;
+	float scalerfactor = 1 + (2 * stat - stat*stat)/(4*count) -  (24 * stat - 132 * stat* stat + 76 * stat* stat* stat - 9 * stat* stat* stat* stat) / (288 * count* count);
+	return exp(-stat)*scalerfactor;
+}
+
+float XRCircularSummaryKappa(float rbar)
+{
+	if(rbar<.53)
+		return (2 * rbar) + (rbar*rbar*rbar) + (5 * rbar*rbar*rbar*rbar*rbar)/6;
+	else if(rbar<.85)
+		return -0.4 + 1.39 * rbar + 0.43/(1 - rbar);
+	return 1/((rbar*rbar*rbar) - 4 * (rbar*rbar) + 3 * rbar);
+}
+
+float XRCircularSummaryStandardError(int count, float meanResultantLength, float kappa)
+{
+	float result = 1/sqrt(((float)count * meanResultantLength * kappa));
+	return XRSummaryDegrees(result);
+}
+
+float XRCircularSummaryConfidenceInterval(float standardError)
+{
+	return standardError * 1.64;
+}
+
+XRCircularSummary XRCircularSummaryMake(XRCircularResultant resultant, int count, bool biDirectional, int calculationType)
+{
+	XRCircularSummary summary = {0};
+	double meanLength = sqrt((resultant.meanCos*resultant.meanCos)+(resultant.meanSin*resultant.meanSin));
+	float meanDir = (float)XRSummaryDegrees(atan2(resultant.sumSin,resultant.sumCos));
+	if(meanDir < 0.0)
+		meanDir += 360.0;
+	if(calculationType==0)
+		meanDir = meanDir/2.0;
+
+	summary.count = count;
+	summary.biDirectional = biDirectional;
+	summary.resultant = resultant;
+	summary.meanDirection = meanDir;
+	summary.resultantLength = sqrt((resultant.sumCos*resultant.sumCos)+(resultant.sumSin*resultant.sumSin));
+	summary.circularVariance = 1.0 - meanLength;
+	summary.meanResultantLength = meanLength;
+	summary.rayleighProbability = XRCircularSummaryRayleighProbability(count, summary.meanResultantLength);
+	summary.kappa = XRCircularSummaryKappa(summary.meanResultantLength);
+	summary.standardError = XRCircularSummaryStandardError(count, summary.meanResultantLength, summary.kappa);
+	summary.confidenceInterval = XRCircularSummaryConfidenceInterval(summary.standardError);
+	return summary;
+}
+
+XRCircularSummary XRCircularSummaryPooled(XRCircularSummary first, XRCircularSummary second, int calculationType)
+{
+	XRCircularResultant resultant = XRCircularResultantAdd(first.resultant, second.resultant);
+	return XRCircularSummaryMake(resultant, first.count + second.count, first.biDirectional, calculationType);
+}
+
+bool XRCircularSummaryFStatistic(XRCircularSummary first, XRCircularSummary second, XRCircularSummary pooled, float *fStatistic)
+{
+	float kp = pooled.kappa;
+	float n = (float)pooled.count;
+	float R1 = first.resultantLength;
+	float R2 = second.resultantLength;
+	float Rp = pooled.resultantLength;
+	*fStatistic = 0;
+	if(kp >= 10.0)
+		*fStatistic = ((n - 2.0)*(R1 + R2 - Rp))/(n-R1-R2);
+	else if(kp >= 2.0)
+		*fStatistic = (1 + (3/(8*kp)))*((n - 2.0)*(R1 + R2 - Rp))/(n-R1-R2);
+	return kp >= 2.0;
+}
@@ -0,0 +1,72 @@
+//
+// XRCircularSummary.h
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef XRCircularSummary_h
+#define XRCircularSummary_h
+
+#include <stdbool.h>
+#include "XRCircularResultant.h"
+
+// Every statistic a data set reports, computed once and read by field.
+//
+// The XRStatistic array shown in the inspector and report is a view of this struct built on
+// demand by -[XRDataSet currentStatistics]. Values are rounded to float exactly where the
+// statistic objects always stored them, so the view prints the same numbers as before.
+typedef struct {
+	int count;                    // N
+	bool biDirectional;           // N (Bi-Dir) is reported as 2N
+	XRCircularResultant resultant; // X Vector, C̅, Y Vector, S̅
+	float meanDirection;          // θ̅, degrees
+	float resultantLength;        // R
+	float circularVariance;
+	float meanResultantLength;    // R̅
+	float rayleighProbability;
+	float kappa;                  // κ (est)
+	float standardError;          // Se, degrees
+	float confidenceInterval;     // θ̅± (95%), degrees
+	// χ2 depends on the sector grid and is only present after a grid dependent calculation
+	bool hasChiSquared;
+	int chiSquaredSectorCount;
+	float chiSquaredExpectedFrequency;
+} XRCircularSummary;
+
+// calculationType is the vectorCalculationMethod default: 0 halves the mean direction of
+// the doubled-angle method, 1 is the standard method.
+XRCircularSummary XRCircularSummaryMake(XRCircularResultant resultant, int count, bool biDirectional, int calculationType);
+
+// Two-sample comparison (Mardia & Jupp). The pooled sample's resultant is the sum of the two
+// resultants, so it is summarized without building the combined set. Returns false when κ of
+// the pooled sample is below 2 and the F statistic is not defined.
+XRCircularSummary XRCircularSummaryPooled(XRCircularSummary first, XRCircularSummary second, int calculationType);
+bool XRCircularSummaryFStatistic(XRCircularSummary first, XRCircularSummary second, XRCircularSummary pooled, float *fStatistic);
+
+float XRCircularSummaryRayleighProbability(int count, float meanResultantLength);
+float XRCircularSummaryKappa(float meanResultantLength);
+float XRCircularSummaryStandardError(int count, float meanResultantLength, float kappa);
+float XRCircularSummaryConfidenceInterval(float standardError);
+
+#endif /* XRCircularSummary_h */
@@ -0,0 +1,156 @@
+//
+// XRCircularSummaryTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import AppKit
+import Numerics
+@testable import PaleoRose
+import Testing
+
+@MainActor
+struct XRCircularSummaryTests {
+
+    // MARK: - Test Setup
+
+    /// Loosely clustered around 60 degrees so every statistic is defined.
+    private func clusteredValues(count: Int, seed: Int = 0) -> [Float] {
+        (0 ..< count).map { Float(((($0 &+ seed) &* 7919) % 9000)) / 100.0 + 15.0 }
+    }
+
+    private func value(_ name: String, in dataSet: XRDataSet) throws -> Float {
+        try #require(dataSet.currentStatistic(withName: name)).floatValue()
+    }
+
+    // MARK: - Tests
+
+    @Test("The statistic view reports the summary fields under their usual names", arguments: [false, true])
+    func viewMatchesSummary(biDir: Bool) throws {
+        let dataSet = try XRDataSet.stub(values: clusteredValues(count: 2500))
+
+        let summary = dataSet.calculateCircularSummary(forBiDir: biDir, startAngle: 0, sectorSize: 10)
+
+        #expect(summary.count == 2500)
+        #expect(summary.biDirectional == biDir)
+        #expect(try #require(dataSet.currentStatistic(withName: "N")).intValue() == 2500)
+        #expect((dataSet.currentStatistic(withName: "N (Bi-Dir)") != nil) == biDir)
+        #expect(try value("X Vector", in: dataSet) == Float(summary.resultant.sumCos))
+        #expect(try value("S̅", in: dataSet) == Float(summary.resultant.meanSin))
+        #expect(try value("θ̅", in: dataSet) == summary.meanDirection)
+        #expect(try value("R", in: dataSet) == summary.resultantLength)
+        #expect(try value("Circular Varience", in: dataSet) == summary.circularVariance)
+        #expect(try value("R̅", in: dataSet) == summary.meanResultantLength)
+        #expect(try value("Rayleigh Probability", in: dataSet) == summary.rayleighProbability)
+        #expect(try value("κ (est)", in: dataSet) == summary.kappa)
+        #expect(try value("Se", in: dataSet) == summary.standardError)
+        #expect(try value("θ̅± (95%)", in: dataSet) == summary.confidenceInterval)
+        #expect(summary.hasChiSquared)
+        #expect(dataSet.currentStatistic(withName: "χ2")?.valueString != nil)
+        #expect(dataSet.currentStatistics().count == (biDir ? 16 : 15))
+    }
+
+    @Test("Derived statistics chain from the float mean resultant length")
+    func derivedStatisticsChain() throws {
+        let dataSet = try XRDataSet.stub(values: clusteredValues(count: 800, seed: 3))
+
+        let summary = dataSet.calculateCircularSummary(forBiDir: false)
+        let rBar = (summary.resultant.meanCos * summary.resultant.meanCos + summary.resultant.meanSin * summary.resultant.meanSin).squareRoot()
+
+        #expect(summary.meanResultantLength == Float(rBar))
+        #expect(summary.circularVariance == Float(1.0 - rBar))
+        #expect(summary.kappa == XRCircularSummaryKappa(summary.meanResultantLength))
+        #expect(summary.standardError == XRCircularSummaryStandardError(800, summary.meanResultantLength, summary.kappa))
+        #expect(summary.confidenceInterval == XRCircularSummaryConfidenceInterval(summary.standardError))
+        #expect(!summary.hasChiSquared)
+        #expect(dataSet.currentStatistic(withName: "χ2") == nil)
+    }
+
+    @Test("Statistic objects are built once per calculation")
+    func viewIsBuiltOnDemand() throws {
+        let dataSet = try XRDataSet.stub(values: clusteredValues(count: 100))
+        #expect(dataSet.currentStatistics() == nil)
+
+        _ = dataSet.calculateCircularSummary(forBiDir: false)
+        let first = try #require(dataSet.currentStatistic(withName: "N"))
+        #expect(first === dataSet.currentStatistics().first as? XRStatistic)
+
+        _ = dataSet.calculateCircularSummary(forBiDir: false)
+        #expect(first !== dataSet.currentStatistic(withName: "N"))
+    }
+
+    @Test("Line arrow layers read the mean direction from the summary")
+    func lineArrowUsesSummary() throws {
+        let controller = XRGeometryController.stub(sectorSize: 10, sectorCount: 36, relativeSize: 0.8)
+        controller.resetGeometry(withBoundsRect: NSRect(x: 0, y: 0, width: 400, height: 400))
+        let dataSet = try XRDataSet.stub(values: clusteredValues(count: 500))
+        let layer = try #require(XRLayerLineArrow(geometryController: controller, with: dataSet))
+
+        let summary = dataSet.calculateCircularSummary(forBiDir: false)
+        layer.generateGraphics()
+
+        let graphics = try #require(layer.value(forKey: "graphicalObjects") as? [[String: Any]])
+        let vector = try #require(graphics.first?["vector"] as? NSBezierPath)
+        let end = vector.getPoints()[1]
+        let expected = controller.rotation(of: NSPoint(x: 0, y: controller.radius(ofRelativePercent: 1.0)), byAngle: Double(summary.meanDirection))
+        #expect(end.x.isApproximatelyEqual(to: expected.x, absoluteTolerance: 1e-6))
+        #expect(end.y.isApproximatelyEqual(to: expected.y, absoluteTolerance: 1e-6))
+    }
+
+    // MARK: - Benchmark
+
+    @Test(
+        "Benchmark line arrow regeneration",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkLineArrowRegeneration() throws {
+        let controller = XRGeometryController.stub(sectorSize: 10, sectorCount: 36, relativeSize: 0.8)
+        controller.resetGeometry(withBoundsRect: NSRect(x: 0, y: 0, width: 800, height: 800))
+        let dataSets = try (0 ..< 50).map { try XRDataSet.stub(values: clusteredValues(count: 10000, seed: $0)) }
+        let layers = try dataSets.flatMap { dataSet in
+            try (0 ..< 20).map { _ in try #require(XRLayerLineArrow(geometryController: controller, with: dataSet)) }
+        }
+
+        let summary = Benchmark.measure("summary + \(layers.count) line arrows") {
+            dataSets.forEach { _ = $0.calculateCircularSummary(forBiDir: false) }
+            layers.forEach { $0.generateGraphics() }
+        }
+        let named = Benchmark.measure("summary + statistic objects + name lookups for \(layers.count) line arrows") {
+            dataSets.forEach { _ = $0.calculateCircularSummary(forBiDir: false) }
+            for dataSet in dataSets {
+                for stat in dataSet.currentStatistics() as? [XRStatistic] ?? [] {
+                    _ = stat.valueString
+                }
+            }
+            for layer in layers {
+                for name in ["θ̅", "R̅", "θ̅± (95%)"] {
+                    _ = layer.dataSet()?.currentStatistics().compactMap { $0 as? XRStatistic }.first { $0.statisticName == name }
+                }
+                layer.generateGraphics()
+            }
+        }
+        print("[benchmark] summary speedup \(Benchmark.seconds(named) / Benchmark.seconds(summary))x")
+    }
+}
@@ -33,11 +33,17 @@
 @property (readwrite) BOOL isEmpty;
 @property (readwrite) BOOL isFloat;
 @property (nonatomic) NSFormatter *aFormatter;
-@property (nonatomic) NSNumber *value;
 
 @end
 
+//The value is kept unboxed and only formatted when valueString is first read; most statistics
+//are never displayed. A string set with setValueString: takes precedence until the value changes.
 @implementation XRStatistic
+{
+	double _scalar;
+	NSString *_explicitValueString;
+	NSString *_formattedValueString;
+}
 
 
 -(id)init
@@ -83,44 +89,66 @@
 		return _statisticName;
 }
 
+-(NSString *)valueString
+{
+	if(_explicitValueString || _isEmpty)
+		return _explicitValueString;
+	if(!_formattedValueString)
+	{
+		if(_aFormatter)
+			_formattedValueString = [_aFormatter stringForObjectValue:(_isFloat ? [NSNumber numberWithFloat:(float)_scalar] : [NSNumber numberWithInt:(int)_scalar])];
+		else if(_isFloat)
+			_formattedValueString = [NSString stringWithFormat:@"%f",(float)_scalar];
+		else
+			_formattedValueString = [NSString stringWithFormat:@"%i",(int)_scalar];
+	}
+	return _formattedValueString;
+}
+
+-(void)setValueString:(NSString *)valueString
+{
+	_explicitValueString = valueString;
+}
+
+-(void)valueWillChange
+{
+	[self willChangeValueForKey:@"valueString"];
+	_explicitValueString = nil;
+	_formattedValueString = nil;
+}
+
 -(void)setFloatValue:(float)aValue
 {
+	[self valueWillChange];
 	_isFloat = YES;
-    _value = [NSNumber numberWithFloat:aValue];
-	if(!_aFormatter)
-		[self setValueString:[NSString stringWithFormat:@"%f",aValue]];
-	else
-		[self setValueString:[_aFormatter stringForObjectValue:[NSNumber numberWithFloat:aValue]]];
-		
+	_isEmpty = NO;
+	_scalar = aValue;
+	[self didChangeValueForKey:@"valueString"];
 }
 
 -(float)floatValue
 {
-	return [_value floatValue];
+	return (float)_scalar;
 }
 -(void)setIntValue:(int)aValue
 {
+	[self valueWillChange];
 	_isFloat = NO;
-	_value = [NSNumber numberWithInt:aValue];
-	if(!_aFormatter)
-		[self setValueString:[NSString stringWithFormat:@"%i",aValue]];
-	else
-		[self setValueString:[_aFormatter stringForObjectValue:[NSNumber numberWithInt:aValue]]];
-	
+	_isEmpty = NO;
+	_scalar = aValue;
+	[self didChangeValueForKey:@"valueString"];
 }
 
 -(int)intValue
 {
-	return [_value intValue];
+	return (int)_scalar;
 }
 
 -(void)setFormatter:(NSFormatter *)formatter
 {
+	[self valueWillChange];
 	_aFormatter = formatter;
-	if(_isFloat)
-		[self setValueString:[_aFormatter stringForObjectValue:_value]];
-	else
-		[self setValueString:[_aFormatter stringForObjectValue:_value]];
+	[self didChangeValueForKey:@"valueString"];
 }
 
 -(void)setEmpty:(BOOL)isEmpty
@@ -94,4 +94,14 @@
     XCTAssertEqual([_testObject floatValue], -128.25);
     XCTAssertTrue([_testObject.valueString isEqualToString:@"-128.250000"]);
 }
+
+-(void)testExplicitValueStringIsReplacedBySettingAValue {
+    _testObject = [XRStatistic statisticWithName:@"Test Statistic" withIntValue:12];
+    [_testObject setValueString:@"twelve"];
+    XCTAssertTrue([_testObject.valueString isEqualToString:@"twelve"]);
+    XCTAssertEqual([_testObject intValue], 12);
+
+    [_testObject setIntValue:13];
+    XCTAssertTrue([_testObject.valueString isEqualToString:@"13"]);
+}
 @end
@@ -0,0 +1,302 @@
+//
+// ColumnValueCache.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import CryptoKit
+import Foundation
+import OSLog
+
+/// Sidecar files holding data set columns as packed Float32 values, mapped instead of read.
+///
+/// Reading a column from SQLite steps through every row and converts each value to `Float`.
+/// Once a column has been read, the cache writes the values to a file in `directory`:
+///
+///     offset  size  contents
+///          0     8  "PRCOLF32"
+///          8     4  format version, UInt32 little-endian
+///         12     4  reserved, zero
+///         16     8  row count, UInt64 little-endian
+///         24    32  SHA-256 of the source description
+///         56     8  reserved, zero
+///         64   4·n  values, Float32 little-endian
+///
+/// A later load maps the file and hands the values to `XRDataSet` without copying. The source
+/// description covers the document file's identity, size and modification date and the table's
+/// schema, column and predicate; saving the document changes it. A file whose hash or length does
+/// not match is rebuilt from SQLite.
+///
+/// Files are named by document path, table, column and predicate, so those of moved or deleted
+/// documents are never read again. Each rebuild prunes the directory: a hit refreshes a file's
+/// modification date, and files unused for `maximumAge` are removed, then the least recently used
+/// until the rest fit in `maximumSize`.
+final class ColumnValueCache {
+    /// Identifies the contents of a saved document without reading it
+    struct DocumentStamp: Equatable {
+        let path: String
+        let size: UInt64
+        let modified: Date
+        let fileNumber: UInt64
+
+        init?(path: String) {
+            guard let attributes = try? FileManager.default.attributesOfItem(atPath: path),
+                  let size = attributes[.size] as? NSNumber,
+                  let modified = attributes[.modificationDate] as? Date
+            else {
+                return nil
+            }
+            self.path = URL(fileURLWithPath: path).standardizedFileURL.resolvingSymlinksInPath().path
+            self.size = size.uint64Value
+            self.modified = modified
+            fileNumber = (attributes[.systemFileNumber] as? NSNumber)?.uint64Value ?? 0
+        }
+    }
+
+    /// Names one column of one table, filtered by a predicate
+    struct Source: Equatable {
+        let document: DocumentStamp
+        let table: String
+        let column: String
+        let predicate: String
+        /// The table's CREATE statement from sqlite_master
+        let schema: String
+
+        /// Names the sidecar file; stays the same when the document is saved again
+        var key: String {
+            Self.digest([document.path, table, column, predicate])
+        }
+
+        /// Written into the header; changes whenever the source may have changed
+        var contentHash: Data {
+            Data(SHA256.hash(data: Data(description.utf8)))
+        }
+
+        private var description: String {
+            [
+                document.path,
+                String(document.size),
+                String(document.modified.timeIntervalSinceReferenceDate.bitPattern),
+                String(document.fileNumber),
+                table,
+                column,
+                predicate,
+                schema
+            ].joined(separator: "\u{1F}")
+        }
+
+        private static func digest(_ parts: [String]) -> String {
+            SHA256.hash(data: Data(parts.joined(separator: "\u{1F}").utf8))
+                .map { String(format: "%02x", $0) }
+                .joined()
+        }
+    }
+
+    enum CacheError: Error {
+        case couldNotMap(String)
+    }
+
+    static let magic = Data("PRCOLF32".utf8)
+    static let version: UInt32 = 1
+    static let headerSize = 64
+    static let fileExtension = "f32"
+
+    /// `Library/Caches/<bundle identifier>/ColumnValues`
+    static let shared: ColumnValueCache = {
+        let caches = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask)[0]
+        let bundle = Bundle.main.bundleIdentifier ?? "PaleoRose"
+        return ColumnValueCache(directory: caches.appendingPathComponent(bundle).appendingPathComponent("ColumnValues"))
+    }()
+
+    let directory: URL
+
+    /// Files not used for this long are removed
+    var maximumAge: TimeInterval = 30 * 24 * 60 * 60
+
+    /// The least recently used files are removed until the directory holds at most this many bytes
+    var maximumSize: UInt64 = 2 * 1024 * 1024 * 1024
+
+    private var hits = 0
+    private var rebuilds = 0
+    private let lock = NSLock()
+
+    /// Loads served from a mapped file
+    var hitCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return hits
+    }
+
+    /// Loads that read SQLite and wrote a new file
+    var rebuildCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return rebuilds
+    }
+
+    init(directory: URL) {
+        self.directory = directory
+    }
+
+    func url(for source: Source) -> URL {
+        directory.appendingPathComponent(source.key).appendingPathExtension(Self.fileExtension)
+    }
+
+    /// The cached values for `source` as little-endian Float32 data, or the values `read` returns.
+    ///
+    /// On a miss the values are written to the sidecar for next time; a failed write is logged and
+    /// the values are still returned.
+    func values(for source: Source, read: () throws -> [Float]) throws -> NSData {
+        if let mapped = map(source) {
+            count(&hits)
+            return mapped
+        }
+        let values = try read()
+        do {
+            try write(values, for: source)
+            count(&rebuilds)
+            prune()
+        } catch {
+            Logger.memoryStoreLogger.error("Could not write column cache for \(source.table).\(source.column): \(error)")
+        }
+        return values.withUnsafeBufferPointer { NSData(bytes: $0.baseAddress, length: $0.count * MemoryLayout<Float>.size) }
+    }
+
+    /// Maps the sidecar for `source`, or returns nil if it is missing, stale or damaged
+    func map(_ source: Source) -> NSData? {
+        let path = url(for: source).path
+        let descriptor = open(path, O_RDONLY)
+        guard descriptor >= 0 else {
+            return nil
+        }
+        defer { close(descriptor) }
+        var info = stat()
+        guard fstat(descriptor, &info) == 0, info.st_size >= Self.headerSize else {
+            return nil
+        }
+        let length = Int(info.st_size)
+        guard let base = mmap(nil, length, PROT_READ, MAP_PRIVATE, descriptor, 0), base != MAP_FAILED else {
+            return nil
+        }
+        let header = UnsafeRawBufferPointer(start: base, count: Self.headerSize)
+        guard let rowCount = Self.rowCount(inHeader: header, expecting: source.contentHash),
+              length == Self.headerSize + rowCount * MemoryLayout<Float>.size
+        else {
+            munmap(base, length)
+            return nil
+        }
+        // Marks the file as recently used for pruning
+        futimes(descriptor, nil)
+        return NSData(
+            bytesNoCopy: base + Self.headerSize,
+            length: rowCount * MemoryLayout<Float>.size,
+            deallocator: { _, _ in munmap(base, length) }
+        )
+    }
+
+    /// Writes a new sidecar for `source`, replacing any existing one
+    func write(_ values: [Float], for source: Source) throws {
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        var file = Self.header(rowCount: values.count, contentHash: source.contentHash)
+        file.reserveCapacity(Self.headerSize + values.count * MemoryLayout<Float>.size)
+        for value in values {
+            withUnsafeBytes(of: value.bitPattern.littleEndian) { file.append(contentsOf: $0) }
+        }
+        try file.write(to: url(for: source), options: .atomic)
+    }
+
+    /// Removes files unused for `maximumAge`, then the least recently used beyond `maximumSize`
+    ///
+    /// The most recently used file is always kept. A file that another store has mapped stays readable
+    /// until it is unmapped.
+    func prune(now: Date = Date()) {
+        let keys: Set<URLResourceKey> = [.contentModificationDateKey, .fileSizeKey]
+        guard let urls = try? FileManager.default.contentsOfDirectory(
+            at: directory,
+            includingPropertiesForKeys: Array(keys),
+            options: .skipsHiddenFiles
+        ) else {
+            return
+        }
+        let files = urls.compactMap { url -> (url: URL, used: Date, size: UInt64)? in
+            guard url.pathExtension == Self.fileExtension,
+                  let values = try? url.resourceValues(forKeys: keys),
+                  let used = values.contentModificationDate
+            else {
+                return nil
+            }
+            return (url, used, UInt64(values.fileSize ?? 0))
+        }
+        var kept: UInt64 = 0
+        for (index, file) in files.sorted(by: { $0.used > $1.used }).enumerated() {
+            let isStale = now.timeIntervalSince(file.used) > maximumAge || kept + file.size > maximumSize
+            guard index > 0, isStale else {
+                kept += file.size
+                continue
+            }
+            do {
+                try FileManager.default.removeItem(at: file.url)
+            } catch {
+                Logger.memoryStoreLogger.error("Could not remove column cache \(file.url.lastPathComponent): \(error)")
+            }
+        }
+    }
+
+    private func count(_ counter: inout Int) {
+        lock.lock()
+        defer { lock.unlock() }
+        counter += 1
+    }
+
+    func removeAll() throws {
+        if FileManager.default.fileExists(atPath: directory.path) {
+            try FileManager.default.removeItem(at: directory)
+        }
+    }
+
+    // MARK: - Header
+
+    static func header(rowCount: Int, contentHash: Data) -> Data {
+        var header = magic
+        withUnsafeBytes(of: version.littleEndian) { header.append(contentsOf: $0) }
+        header.append(contentsOf: [UInt8](repeating: 0, count: 4))
+        withUnsafeBytes(of: UInt64(rowCount).littleEndian) { header.append(contentsOf: $0) }
+        header.append(contentHash)
+        header.append(contentsOf: [UInt8](repeating: 0, count: headerSize - header.count))
+        return header
+    }
+
+    /// The row count from a header that matches the format and `contentHash`
+    static func rowCount(inHeader header: UnsafeRawBufferPointer, expecting contentHash: Data) -> Int? {
+        guard header.count >= headerSize,
+              header.prefix(8).elementsEqual(magic),
+              UInt32(littleEndian: header.loadUnaligned(fromByteOffset: 8, as: UInt32.self)) == version,
+              header[24 ..< 56].elementsEqual(contentHash)
+        else {
+            return nil
+        }
+        let rowCount = UInt64(littleEndian: header.loadUnaligned(fromByteOffset: 16, as: UInt64.self))
+        return rowCount <= UInt64(Int.max / MemoryLayout<Float>.size) ? Int(rowCount) : nil
+    }
+}
@@ -0,0 +1,265 @@
+//
+// ColumnValueCacheTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import CodableSQLiteNonThread
+import Foundation
+@testable import PaleoRose
+import Testing
+
+@Suite(
+    "Column Value Cache",
+    .tags(.integration),
+    .serialized
+)
+struct ColumnValueCacheTests {
+
+    // MARK: - Test Setup
+
+    private let values: [Float] = (0 ..< 5000).map { Float(($0 &* 7919) % 36000) / 100.0 }
+
+    private func source(document path: String, schema: String = "CREATE TABLE t (v REAL)") throws -> ColumnValueCache.Source {
+        try ColumnValueCache.Source(
+            document: #require(ColumnValueCache.DocumentStamp(path: path)),
+            table: "t",
+            column: "v",
+            predicate: "",
+            schema: schema
+        )
+    }
+
+    private func source(document path: String, table: String) throws -> ColumnValueCache.Source {
+        try ColumnValueCache.Source(
+            document: #require(ColumnValueCache.DocumentStamp(path: path)),
+            table: table,
+            column: "v",
+            predicate: "",
+            schema: "CREATE TABLE \(table) (v REAL)"
+        )
+    }
+
+    private func readDataSets(_ path: String, cache: ColumnValueCache) throws -> [XRDataSet] {
+        let store = try InMemoryStore(interface: SQLiteInterface())
+        store.columnCache = cache
+        store.defersDataSetValues = false
+        try store.load(from: path)
+        return try store.readSnapshot().dataSets
+    }
+
+    private func touch(_ path: String, by seconds: TimeInterval) throws {
+        let modified = try #require(try FileManager.default.attributesOfItem(atPath: path)[.modificationDate] as? Date)
+        try FileManager.default.setAttributes([.modificationDate: modified.addingTimeInterval(seconds)], ofItemAtPath: path)
+    }
+
+    // MARK: - File Format
+
+    @Test("Written values map back unchanged")
+    func roundTrip() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let cache = ColumnValueCache(directory: directory.appendingPathComponent("cache"))
+        let source = try source(document: InMemoryStore.sampleDocument(in: directory))
+
+        try cache.write(values, for: source)
+        let mapped = try #require(cache.map(source))
+
+        let file = try Data(contentsOf: cache.url(for: source))
+        #expect(file.count == ColumnValueCache.headerSize + values.count * MemoryLayout<Float>.size)
+        #expect(file.prefix(8) == ColumnValueCache.magic)
+        #expect(Array(UnsafeBufferPointer(start: mapped.bytes.assumingMemoryBound(to: Float.self), count: values.count)) == values)
+    }
+
+    @Test("A changed source misses and the file is rebuilt")
+    func staleSourceRebuilds() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let cache = ColumnValueCache(directory: directory.appendingPathComponent("cache"))
+        let document = try InMemoryStore.sampleDocument(in: directory)
+        let original = try source(document: document)
+        try cache.write(values, for: original)
+
+        let altered = try source(document: document, schema: "CREATE TABLE t (v REAL, w REAL)")
+        #expect(altered.key == original.key)
+        #expect(cache.map(altered) == nil)
+
+        var reads = 0
+        let replacement = Array(values.reversed())
+        let rebuilt = try cache.values(for: altered) {
+            reads += 1
+            return replacement
+        }
+        #expect(reads == 1)
+        #expect(rebuilt.length == replacement.count * MemoryLayout<Float>.size)
+        #expect(cache.rebuildCount == 1)
+        #expect(cache.map(original) == nil)
+        #expect(cache.map(altered) != nil)
+    }
+
+    @Test("A truncated file is not used")
+    func truncatedFile() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let cache = ColumnValueCache(directory: directory.appendingPathComponent("cache"))
+        let source = try source(document: InMemoryStore.sampleDocument(in: directory))
+        try cache.write(values, for: source)
+
+        let handle = try FileHandle(forWritingTo: cache.url(for: source))
+        try handle.truncate(atOffset: UInt64(ColumnValueCache.headerSize + 10))
+        try handle.close()
+
+        #expect(cache.map(source) == nil)
+    }
+
+    // MARK: - Pruning
+
+    @Test("Writing a file removes those unused for the maximum age")
+    func pruneByAge() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let cache = ColumnValueCache(directory: directory.appendingPathComponent("cache"))
+        let document = try InMemoryStore.sampleDocument(in: directory)
+        let old = try source(document: document, table: "old")
+        let recent = try source(document: document, table: "recent")
+        try cache.write(values, for: old)
+        try cache.write(values, for: recent)
+        try touch(cache.url(for: old).path, by: -cache.maximumAge - 60)
+        try touch(cache.url(for: recent).path, by: -cache.maximumAge + 60)
+
+        _ = try cache.values(for: source(document: document, table: "new")) { values }
+
+        #expect(cache.map(old) == nil)
+        #expect(!FileManager.default.fileExists(atPath: cache.url(for: old).path))
+        #expect(cache.map(recent) != nil)
+    }
+
+    @Test("Writing a file removes the least recently used beyond the maximum size")
+    func pruneBySize() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let cache = ColumnValueCache(directory: directory.appendingPathComponent("cache"))
+        let document = try InMemoryStore.sampleDocument(in: directory)
+        cache.maximumSize = UInt64(2 * (ColumnValueCache.headerSize + values.count * MemoryLayout<Float>.size))
+        let sources = try ["a", "b", "c"].map { try source(document: document, table: $0) }
+        let newest = try source(document: document, table: "d")
+        for (index, source) in sources.enumerated() {
+            try cache.write(values, for: source)
+            try touch(cache.url(for: source).path, by: TimeInterval(-300 + 100 * index))
+        }
+
+        // Mapping "a" makes it the most recently used of the three
+        #expect(cache.map(sources[0]) != nil)
+        _ = try cache.values(for: newest) { values }
+
+        let remaining = try FileManager.default.contentsOfDirectory(atPath: cache.directory.path)
+        #expect(Set(remaining) == Set([sources[0], newest].map { cache.url(for: $0).lastPathComponent }))
+    }
+
+    // MARK: - Store
+
+    @Test("Reopening a document maps its data sets instead of reading them")
+    func reopenMapsDataSets() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let cache = ColumnValueCache(directory: directory.appendingPathComponent("cache"))
+        let document = try InMemoryStore.sampleDocument(in: directory)
+
+        let first = try readDataSets(document, cache: cache)
+        let second = try readDataSets(document, cache: cache)
+
+        #expect(!first.isEmpty)
+        #expect(cache.rebuildCount == first.count)
+        #expect(cache.hitCount == second.count)
+        #expect(second.allSatisfy { !$0.ownsValues() })
+        for (read, mapped) in zip(first, second) {
+            #expect(read.withValues { Array($0) } == mapped.withValues { Array($0) })
+        }
+    }
+
+    @Test("Saving the document again rebuilds the cache")
+    func modifiedDocumentRebuilds() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let cache = ColumnValueCache(directory: directory.appendingPathComponent("cache"))
+        let document = try InMemoryStore.sampleDocument(in: directory)
+        let dataSets = try readDataSets(document, cache: cache)
+
+        try touch(document, by: 10)
+        _ = try readDataSets(document, cache: cache)
+
+        #expect(cache.hitCount == 0)
+        #expect(cache.rebuildCount == 2 * dataSets.count)
+    }
+
+    @Test("Without a cache the store reads SQLite and writes nothing")
+    func noCache() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let document = try InMemoryStore.sampleDocument(in: directory)
+        let store = try InMemoryStore(interface: SQLiteInterface())
+        store.defersDataSetValues = false
+        try store.load(from: document)
+
+        let dataSets = try store.readSnapshot().dataSets
+
+        #expect(dataSets.allSatisfy { $0.ownsValues() })
+        #expect(try FileManager.default.contentsOfDirectory(atPath: directory.path) == ["rtest1.XRose"])
+    }
+
+    // MARK: - Benchmark
+
+    @Test(
+        "Benchmark: loading a 10M row data set from SQLite and from the cache",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkLoad() throws {
+        let rows = 10_000_000
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let document = try InMemoryStore.sampleDocument(in: directory)
+        let interface = SQLiteInterface()
+        let file = try interface.openDatabase(path: document)
+        for sql in [
+            "CREATE TABLE big (v REAL)",
+            "INSERT INTO big WITH RECURSIVE n(x) AS (SELECT 0 UNION ALL SELECT x + 1 FROM n WHERE x < \(rows - 1)) SELECT (x * 7919 % 36000) / 100.0 FROM n",
+            "INSERT INTO _datasets (NAME, TABLENAME, COLUMNNAME) VALUES ('big', 'big', 'v')"
+        ] {
+            _ = try interface.executeQuery(sqlite: file, query: Query(sql: sql))
+        }
+        try interface.close(store: file)
+        let cache = ColumnValueCache(directory: directory.appendingPathComponent("cache"))
+
+        let scanned = try Benchmark.measure("10M rows read from SQLite", iterations: 1) {
+            _ = try readDataSets(document, cache: cache)
+        }
+        let mapped = try Benchmark.measure("10M rows mapped from the cache", iterations: 3) {
+            _ = try readDataSets(document, cache: cache)
+        }
+
+        #expect(cache.hitCount >= 3)
+        print("[benchmark] mapped load: \(Benchmark.seconds(scanned) / Benchmark.seconds(mapped))x")
+    }
+}
@@ -0,0 +1,280 @@
+//
+// DeferredDataSetValues.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import CodableSQLiteNonThread
+import Foundation
+import OSLog
+
+/// Reads the values of deferred data sets from the document file the first time they are needed,
+/// and releases them again under memory pressure.
+///
+/// A document opened from an unchanged file creates its data sets with this object as their
+/// `XRDataSetValueSource`, so opening reads only `_datasets`. Each read opens its own read-only
+/// connection and goes through the column cache when there is one, so it is safe on any thread.
+/// The file must keep matching the data sets: the store calls `relocate(to:)` after saving and
+/// `detach(readingTable:)` before it changes a table the data sets read. If the file is changed by
+/// something else, or cannot be read, values are read from the in-memory store with `storeValues`
+/// instead. With `countsSectorsInStore`, sector counts are computed by `SectorHistogramAggregate`
+/// without reading the values at all.
+final class DeferredDataSetValues: NSObject, XRDataSetValueSource {
+
+    private let interface: StoreProtocol
+    private let columnCache: ColumnValueCache?
+    private let storeValues: (DataSet) throws -> [Float]
+    private let lock = NSLock()
+    private var document: ColumnValueCache.DocumentStamp
+    private let dataSets = NSHashTable<XRDataSet>.weakObjects()
+    private var memoryPressureSource: DispatchSourceMemoryPressure?
+    private var loads = 0
+    private var histogramsCounted = 0
+
+    /// When set, sector histograms of data sets whose values have not been read are counted by
+    /// SQLite, so only the counts are brought into memory
+    var countsSectorsInStore = false
+
+    /// - Parameters:
+    /// - storeValues: Reads a data set's values from the in-memory store, on any thread
+    init(
+        document: ColumnValueCache.DocumentStamp,
+        interface: StoreProtocol,
+        columnCache: ColumnValueCache?,
+        storeValues: @escaping (DataSet) throws -> [Float]
+    ) {
+        self.document = document
+        self.interface = interface
+        self.columnCache = columnCache
+        self.storeValues = storeValues
+        super.init()
+    }
+
+    deinit {
+        memoryPressureSource?.cancel()
+    }
+
+    /// Number of data sets whose values have been read, counting reads after an eviction again
+    var loadCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return loads
+    }
+
+    /// Number of sector histograms counted by SQLite instead of from loaded values
+    var storeHistogramCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return histogramsCounted
+    }
+
+    /// A data set that reads its values from this source when first asked for them, and then
+    /// stores them as its `_datasets` row records
+    func makeDataSet(_ set: DataSet) -> XRDataSet {
+        let dataSet = XRDataSet(
+            id: Int32(set._id ?? -1),
+            name: set.NAME ?? "Unnamed",
+            tableName: set.TABLENAME ?? "Unnamed",
+            column: set.COLUMNNAME ?? "Unnamed",
+            predicate: set.PREDICATE ?? "",
+            comments: set.decodedComments() ?? NSMutableAttributedString(),
+            valueSource: self
+        )!
+        dataSet.setAngleStorageWhenLoaded(set.angleStorage)
+        lock.lock()
+        dataSets.add(dataSet)
+        lock.unlock()
+        return dataSet
+    }
+
+    /// Points later reads at the file the store was saved to
+    func relocate(to document: ColumnValueCache.DocumentStamp?) {
+        guard let document else {
+            detach(readingTable: nil)
+            return
+        }
+        lock.lock()
+        self.document = document
+        lock.unlock()
+    }
+
+    /// Loads and keeps the values of the data sets reading `table`, or of every data set when nil,
+    /// so they no longer depend on the file
+    func detach(readingTable table: String?) {
+        for dataSet in registeredDataSets() where table == nil || dataSet.tableName() == table {
+            dataSet.detachValueSource()
+            lock.lock()
+            dataSets.remove(dataSet)
+            lock.unlock()
+        }
+    }
+
+    /// Releases every loaded value buffer that can be read again
+    /// - returns: The number of data sets evicted
+    @discardableResult
+    func evict() -> Int {
+        let evicted = registeredDataSets().filter { $0.evictValues() }.count
+        Logger.memoryStoreLogger.debug("Evicted the values of \(evicted) deferred data sets")
+        return evicted
+    }
+
+    /// Evicts on the main queue when the system reports memory pressure
+    func evictUnderMemoryPressure() {
+        guard memoryPressureSource == nil else {
+            return
+        }
+        let source = DispatchSource.makeMemoryPressureSource(eventMask: [.warning, .critical], queue: .main)
+        source.setEventHandler { [weak self] in
+            self?.evict()
+        }
+        source.resume()
+        memoryPressureSource = source
+    }
+
+    // MARK: - XRDataSetValueSource
+
+    func values(for dataSet: XRDataSet?) -> Data? {
+        guard let dataSet else {
+            return nil
+        }
+        let data = withConnection(reading: dataSet) { set, document, connection in
+            try values(for: set, document: document, sqlite: connection)
+        } ?? valuesFromStore(for: dataSet)
+        if data != nil {
+            lock.lock()
+            loads += 1
+            lock.unlock()
+        }
+        return data
+    }
+
+    func sectorHistogram(
+        for dataSet: XRDataSet?,
+        startAngle: Float,
+        sectorSize: Float,
+        sectorCount: Int32,
+        biDirectional: Bool
+    ) -> XRSectorHistogram? {
+        guard countsSectorsInStore else {
+            return nil
+        }
+        return withConnection(reading: dataSet) { set, _, connection in
+            let histogram = try SectorHistogramAggregate.histogram(
+                of: set,
+                startAngle: startAngle,
+                sectorSize: sectorSize,
+                sectorCount: sectorCount,
+                biDirectional: biDirectional,
+                interface: interface,
+                sqlite: connection
+            )
+            lock.lock()
+            histogramsCounted += 1
+            lock.unlock()
+            return histogram
+        }
+    }
+
+    // MARK: - Private
+
+    /// Runs `body` on a read-only connection to the document, if it still matches the data sets
+    private func withConnection<T>(
+        reading dataSet: XRDataSet?,
+        _ body: (DataSet, ColumnValueCache.DocumentStamp, OpaquePointer) throws -> T
+    ) -> T? {
+        guard let dataSet else {
+            return nil
+        }
+        lock.lock()
+        let document = document
+        lock.unlock()
+        guard ColumnValueCache.DocumentStamp(path: document.path) == document else {
+            Logger.memoryStoreLogger.error("\(document.path) changed before data set \(dataSet.name() ?? "") was read")
+            return nil
+        }
+        let set = storedDataSet(dataSet)
+        do {
+            let connection = try interface.openReadOnlyDatabase(path: document.path)
+            defer {
+                try? interface.close(store: connection)
+            }
+            return try body(set, document, connection)
+        } catch {
+            Logger.memoryStoreLogger.error("Could not read data set \(dataSet.name() ?? ""): \(error)")
+            return nil
+        }
+    }
+
+    /// The values of a data set as the in-memory store holds them, for when the file no longer does
+    private func valuesFromStore(for dataSet: XRDataSet) -> Data? {
+        do {
+            let values = try storeValues(storedDataSet(dataSet))
+            return values.withUnsafeBufferPointer { Data(buffer: $0) }
+        } catch {
+            Logger.memoryStoreLogger.error("Could not read data set \(dataSet.name() ?? "") from the store: \(error)")
+            return nil
+        }
+    }
+
+    private func storedDataSet(_ dataSet: XRDataSet) -> DataSet {
+        DataSet(
+            NAME: dataSet.name(),
+            TABLENAME: dataSet.tableName(),
+            COLUMNNAME: dataSet.columnName(),
+            PREDICATE: dataSet.predicate(),
+            COMMENTS: nil
+        )
+    }
+
+    private func registeredDataSets() -> [XRDataSet] {
+        lock.lock()
+        defer { lock.unlock() }
+        return dataSets.allObjects
+    }
+
+    private func values(for set: DataSet, document: ColumnValueCache.DocumentStamp, sqlite: OpaquePointer) throws -> Data {
+        let read = { [interface] () throws -> [Float] in
+            let query = set.dataQuery(orderedByRowID: interface.hasRowID(table: set.TABLENAME ?? "", sqlite: sqlite))
+            return try interface.readColumn(set.COLUMNNAME ?? "", as: Float.self, sqlite: sqlite, query: query)
+        }
+        guard let columnCache, let table = set.TABLENAME, let schema = try schema(of: table, sqlite: sqlite) else {
+            return try read().withUnsafeBufferPointer { Data(buffer: $0) }
+        }
+        let source = ColumnValueCache.Source(
+            document: document,
+            table: table,
+            column: set.COLUMNNAME ?? "",
+            predicate: set.PREDICATE ?? "",
+            schema: schema
+        )
+        return try Data(referencing: columnCache.values(for: source, read: read))
+    }
+
+    private func schema(of table: String, sqlite: OpaquePointer) throws -> String? {
+        let rows = try interface.executeQuery(
+            sqlite: sqlite,
+            query: Query(sql: "SELECT sql FROM sqlite_master WHERE type = 'table' AND name = ?", bindings: [[table]])
+        )
+        return rows.first?["sql"] as? String
+    }
+}
@@ -0,0 +1,222 @@
+//
+// DeferredDataSetValuesTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import CodableSQLiteNonThread
+import Foundation
+@testable import PaleoRose
+import Testing
+
+@Suite(
+    "Deferred Data Set Values",
+    .tags(.integration),
+    .serialized
+)
+struct DeferredDataSetValuesTests {
+
+    // MARK: - Test Setup
+
+    private func openStore(_ path: String, defers: Bool = true) throws -> InMemoryStore {
+        let store = try InMemoryStore(interface: SQLiteInterface())
+        store.defersDataSetValues = defers
+        try store.load(from: path)
+        return store
+    }
+
+    private func extras(_ dataSets: [XRDataSet]) -> [XRDataSet] {
+        dataSets.filter { $0.tableName()?.hasPrefix("set") == true }
+    }
+
+    /// Physical footprint of the test process, as Activity Monitor reports it
+    private func residentBytes() -> UInt64 {
+        var info = task_vm_info_data_t()
+        var count = mach_msg_type_number_t(MemoryLayout<task_vm_info_data_t>.size / MemoryLayout<natural_t>.size)
+        let result = withUnsafeMutablePointer(to: &info) {
+            $0.withMemoryRebound(to: integer_t.self, capacity: Int(count)) {
+                task_info(mach_task_self_, task_flavor_t(TASK_VM_INFO), $0, &count)
+            }
+        }
+        return result == KERN_SUCCESS ? info.phys_footprint : 0
+    }
+
+    // MARK: - Tests
+
+    @Test("Data sets that no layer draws are left unread when the document opens")
+    func unreferencedDataSetsAreDeferred() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let store = try openStore(InMemoryStore.sampleDocument(in: directory, dataSetCount: 4))
+
+        let dataSets = try store.readSnapshot().dataSets
+
+        let deferred = extras(dataSets)
+        #expect(deferred.count == 4)
+        #expect(deferred.allSatisfy { !$0.hasLoadedValues() })
+        #expect(store.deferredValues?.loadCount == dataSets.filter { $0.hasLoadedValues() }.count)
+    }
+
+    @Test("Every stage of a deferred load is reported")
+    func loadReportCountsDeferred() async throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let store = try openStore(InMemoryStore.sampleDocument(in: directory, dataSetCount: 3))
+
+        _ = try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Bool, Error>) in
+            store.readFromStore { continuation.resume(with: $0) }
+        }
+
+        let report = try #require(store.lastLoadReport)
+        #expect(report.dataSetCount == 4)
+        #expect(report.deferredDataSetCount >= 3)
+    }
+
+    @Test("Deferred values match the values read when the document opens")
+    func deferredValuesMatchEager() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let path = try InMemoryStore.sampleDocument(in: directory, dataSetCount: 3)
+
+        let eager = try openStore(path, defers: false).readSnapshot().dataSets
+        let deferred = try openStore(path).readSnapshot().dataSets
+
+        #expect(deferred.map { $0.setId() } == eager.map { $0.setId() })
+        #expect(InMemoryStore.values(of: deferred) == InMemoryStore.values(of: eager))
+    }
+
+    @Test("Evicted values are released and read back the same")
+    func evictAndReload() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let store = try openStore(InMemoryStore.sampleDocument(in: directory, dataSetCount: 3))
+        let dataSets = try extras(store.readSnapshot().dataSets)
+        let expected = InMemoryStore.values(of: dataSets)
+        let source = try #require(store.deferredValues)
+        let loads = source.loadCount
+
+        #expect(source.evict() >= dataSets.count)
+
+        #expect(dataSets.allSatisfy { !$0.hasLoadedValues() })
+        #expect(InMemoryStore.values(of: dataSets) == expected)
+        #expect(source.loadCount == loads + dataSets.count)
+    }
+
+    @Test("Changing a table keeps the values of the data sets that read it")
+    func changedTableDetaches() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let store = try openStore(InMemoryStore.sampleDocument(in: directory, dataSetCount: 2))
+        let dataSets = try extras(store.readSnapshot().dataSets)
+        let changed = try #require(dataSets.first { $0.tableName() == "set1" })
+        let unchanged = try #require(dataSets.first { $0.tableName() == "set0" })
+
+        try store.addColumn(to: "set1", columnDefinition: "note TEXT")
+
+        #expect(changed.hasLoadedValues())
+        #expect(changed.valueSource() == nil)
+        #expect(!changed.evictValues())
+        #expect(!unchanged.hasLoadedValues())
+        #expect(unchanged.valueSource() != nil)
+    }
+
+    @Test("After saving to another file, evicted values are read from it")
+    func saveRelocates() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let path = try InMemoryStore.sampleDocument(in: directory, dataSetCount: 2)
+        let store = try openStore(path)
+        let dataSets = try extras(store.readSnapshot().dataSets)
+        let expected = InMemoryStore.values(of: dataSets)
+        store.deferredValues?.evict()
+
+        try store.save(to: directory.appendingPathComponent("moved.XRose").path)
+        try FileManager.default.removeItem(atPath: path)
+
+        #expect(InMemoryStore.values(of: dataSets) == expected)
+    }
+
+    @Test("When the file changes on disk, evicted values are read back from the store")
+    func changedFileFallsBackToStore() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let path = try InMemoryStore.sampleDocument(in: directory, dataSetCount: 2)
+        let store = try openStore(path)
+        let dataSets = try extras(store.readSnapshot().dataSets)
+        let expected = InMemoryStore.values(of: dataSets)
+        let source = try #require(store.deferredValues)
+        let loads = source.loadCount
+        source.evict()
+
+        let interface = SQLiteInterface()
+        let file = try interface.openDatabase(path: path)
+        _ = try interface.executeQuery(sqlite: file, query: Query(sql: "DELETE FROM set0"))
+        _ = try interface.executeQuery(sqlite: file, query: Query(sql: "INSERT INTO set1 VALUES (1.5)"))
+        try interface.close(store: file)
+
+        #expect(InMemoryStore.values(of: dataSets) == expected)
+        #expect(dataSets.allSatisfy { $0.valueCount() > 0 })
+        #expect(source.loadCount == loads + dataSets.count)
+    }
+
+    @Test("Documents of at least the sector counting size count sectors in the store")
+    func largeDocumentsCountSectorsInStore() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let path = try InMemoryStore.sampleDocument(in: directory, dataSetCount: 1)
+
+        let small = try openStore(path)
+        _ = try small.readSnapshot()
+        let large = try openStore(path)
+        large.sectorCountingFileSize = 1
+        _ = try large.readSnapshot()
+
+        #expect(small.deferredValues?.countsSectorsInStore == false)
+        #expect(large.deferredValues?.countsSectorsInStore == true)
+    }
+
+    // MARK: - Benchmark
+
+    @Test(
+        "Benchmark: open time and resident memory with and without deferred data sets",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkOpen() throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let path = try InMemoryStore.sampleDocument(in: directory, dataSetCount: 48, rows: 250_000)
+
+        for defers in [false, true] {
+            var dataSets: [XRDataSet] = []
+            let before = residentBytes()
+            let duration = try Benchmark.measure("open 48 x 250k values, deferred: \(defers)", iterations: 1) {
+                dataSets = try openStore(path, defers: defers).readSnapshot().dataSets
+            }
+            let resident = Double(Int64(residentBytes()) - Int64(before)) / 1_048_576
+            let unread = dataSets.filter { !$0.hasLoadedValues() }.count
+            print("[benchmark] deferred: \(defers) open \(String(format: "%.3f", Benchmark.seconds(duration))) s, resident +\(String(format: "%.1f", resident)) MB, \(unread) of \(dataSets.count) unread")
+            #expect(defers ? unread >= 48 : unread == 0)
+        }
+    }
+}
@@ -60,6 +60,10 @@ class DocumentModel: NSObject {
         if let document {
             geometryController.setUndoManager(document.undoManager)
         }
+        // Documents opened in a window map their data set columns on reopen
+        if document != nil, inMemoryStore.columnCache == nil {
+            inMemoryStore.columnCache = .shared
+        }
 
         inMemoryStore.delegate = self
     }
@@ -77,6 +81,26 @@ class DocumentModel: NSObject {
         try inMemoryStore.save(to: file.path)
     }
 
+    /// Whether saving to `file` can update it in place with only the changes since the last save
+    @objc func canSaveIncrementally(to file: URL) -> Bool {
+        inMemoryStore.canSaveIncrementally(to: file.path)
+    }
+
+    /// Records that `file` holds the saved document, after a save wrote it elsewhere and moved it into place
+    @objc func didSave(to file: URL) {
+        inMemoryStore.markSaved(to: file.path)
+    }
+
+    /// Whether tables or layers changed in the store since it was last opened or saved
+    @objc var hasUnsavedStoreChanges: Bool {
+        inMemoryStore.hasUnsavedChanges
+    }
+
+    /// Bytes the most recent save wrote to disk
+    @objc var lastSaveBytesWritten: Int {
+        inMemoryStore.lastSaveReport?.bytesWritten ?? 0
+    }
+
     @objc func openFile(_ file: URL) throws {
         try inMemoryStore.load(from: file.path)
         readFromStore {}
@@ -119,6 +143,24 @@ class DocumentModel: NSObject {
         return dataSet
     }
 
+    /// Changes how a data set holds its angles and records the choice in `_datasets`, so it is
+    /// applied again when the document is opened.
+    /// - returns: false, leaving the data set and the store unchanged, if the values cannot be
+    ///   stored that way, such as values that are not whole hundredths with `.hundredths`
+    @objc @discardableResult
+    func setAngleStorage(_ storage: XRDataSetAngleStorage, for dataSet: XRDataSet) throws -> Bool {
+        switch storage {
+        case .hundredths, .roundedHundredths:
+            guard dataSet.storeAnglesAsHundredths(losslessly: storage == .hundredths) else {
+                return false
+            }
+        default:
+            dataSet.storeAnglesAsFloats()
+        }
+        try inMemoryStore.store(angleStorage: storage, forDataSetID: dataSet.setId())
+        return true
+    }
+
     /// Saves the current geometry controller state to the store
     @objc func saveGeometry() throws {
         try inMemoryStore.store(geometryController: geometryController)
@@ -167,14 +209,22 @@ extension DocumentModel: InMemoryStoreDelegate {
     }
 
     func update(layers: [XRLayer]) {
+        Self.attach(layers, to: geometryController, dataSets: dataSets)
+        self.layers = layers
+        layersSubject.send(layers)
+    }
+
+    /// Connects layers read from a store to the geometry controller and their data sets.
+    static func attach(_ layers: [XRLayer], to geometryController: XRGeometryController, dataSets: [XRDataSet]) {
         // Set datasets and geometry controller on all loaded layers
         // IMPORTANT: Set geometry controller FIRST, then dataset
         // because setDataSet calls generateGraphics which needs the geometry controller
+        let dataSetsByID = Dictionary(dataSets.map { ($0.setId(), $0) }, uniquingKeysWith: { first, _ in first })
         for layer in layers {
             // First, set the dataset for data and line arrow layers
             if let dataLayer = layer as? XRLayerData {
                 let datasetId = dataLayer.datasetId()
-                if let dataset = dataSets.first(where: { $0.setId() == datasetId }) {
+                if let dataset = dataSetsByID[datasetId] {
                     // Set geometry controller first (without generating graphics)
                     layer.setGeometryController(geometryController)
                     // Then set dataset (which will call generateGraphics with everything ready)
@@ -184,7 +234,7 @@ extension DocumentModel: InMemoryStoreDelegate {
                 }
             } else if let arrowLayer = layer as? XRLayerLineArrow {
                 let datasetId = arrowLayer.datasetId()
-                if let dataset = dataSets.first(where: { $0.setId() == datasetId }) {
+                if let dataset = dataSetsByID[datasetId] {
                     // Set geometry controller first (without generating graphics)
                     layer.setGeometryController(geometryController)
                     // Then set dataset (which will call generateGraphics with everything ready)
@@ -197,23 +247,10 @@ extension DocumentModel: InMemoryStoreDelegate {
                 layer.setGeometryController(geometryController)
             }
         }
-
-        self.layers = layers
-        layersSubject.send(layers)
     }
 
     func update(geometry: Geometry) {
-        geometryController.configureIsEqualArea(
-            geometry.isEqualArea,
-            isPercent: geometry.isPercent,
-            maxCount: Int32(geometry.MAXCOUNT),
-            maxPercent: geometry.MAXPERCENT,
-            hollowCore: geometry.HOLLOWCORE,
-            sectorSize: geometry.SECTORSIZE,
-            startingAngle: geometry.STARTINGANGLE,
-            sectorCount: Int32(geometry.SECTORCOUNT),
-            relativeSize: geometry.RELATIVESIZE
-        )
+        StorageModelFactory().configure(geometryController, from: geometry)
     }
 }
 
@@ -489,6 +526,11 @@ extension DocumentModel: UserTableImporting {
         refreshTableNames()
     }
 
+    func importText(from url: URL, options: TextImportOptions, progress: Progress) throws {
+        try StreamingTableImporter(options: options).importTable(from: url, into: inMemoryStore, progress: progress)
+        refreshTableNames()
+    }
+
     func copyTables(
         from sourceURL: URL,
         selecting tables: [(original: String, destination: String)]
@@ -0,0 +1,76 @@
+//
+// InMemoryStore+Testing.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import CodableSQLiteNonThread
+import Foundation
+@testable import PaleoRose
+import Testing
+
+extension InMemoryStore {
+    /// A new, empty directory in the temporary directory; the caller removes it
+    static func temporaryDirectory() throws -> URL {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString, isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        return directory
+    }
+
+    /// A copy of the rtest1 sample document in `directory`, with `dataSetCount` more data sets of
+    /// `rows` values each
+    ///
+    /// The added data sets are named `Set 0`, `Set 1`, … and read column `v` of tables `set0`, `set1`, …;
+    /// no layer draws them.
+    static func sampleDocument(in directory: URL, dataSetCount: Int = 0, rows: Int = 1000) throws -> String {
+        guard
+            let bundle = Bundle(identifier: "PaleoTerra.Unit-Tests"),
+            let sample = bundle.path(forResource: "rtest1", ofType: "XRose")
+        else {
+            Issue.record("Could not find test file")
+            throw SQLiteError.failedToOpen
+        }
+        let path = directory.appendingPathComponent("rtest1.XRose").path
+        try FileManager.default.copyItem(atPath: sample, toPath: path)
+        let interface = SQLiteInterface()
+        let file = try interface.openDatabase(path: path)
+        defer { try? interface.close(store: file) }
+        for set in 0 ..< dataSetCount {
+            let numbers = "WITH RECURSIVE n(x) AS (SELECT 0 UNION ALL SELECT x + 1 FROM n WHERE x < \(rows - 1))"
+            for sql in [
+                "CREATE TABLE set\(set) (v REAL)",
+                "INSERT INTO set\(set) \(numbers) SELECT ((x + \(set)) * 7919 % 36000) / 100.0 FROM n",
+                "INSERT INTO _datasets (NAME, TABLENAME, COLUMNNAME) VALUES ('Set \(set)', 'set\(set)', 'v')"
+            ] {
+                _ = try interface.executeQuery(sqlite: file, query: Query(sql: sql))
+            }
+        }
+        return path
+    }
+
+    /// Each data set's values, in order
+    static func values(of dataSets: [XRDataSet]) -> [[Float]] {
+        dataSets.map { $0.withValues { Array($0) } }
+    }
+}
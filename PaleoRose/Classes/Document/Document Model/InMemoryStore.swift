@@ -55,13 +55,86 @@ class InMemoryStore: NSObject {
         let type: BackupType
     }
 
+    /// Describes what a call to `save(to:)` wrote
+    struct SaveReport: Equatable {
+        enum Mode {
+            /// The whole in-memory database was copied over the file
+            case full
+            /// Only changed tables and layer rows were written into the existing file
+            case incremental
+        }
+
+        let mode: Mode
+        /// Database pages written to the file, in bytes
+        let bytesWritten: Int
+        /// Tables copied whole, or removed from the file, in an incremental save
+        let tablesWritten: [String]
+        /// Layer rows rewritten in an incremental save
+        let rowsWritten: Int
+    }
+
     private var sqliteStore: OpaquePointer?
     private let storageLayerFactory = StorageModelFactory()
     private let storedWindowSizes: [WindowControllerSize] = []
     private var storedColors: [Color] = []
     private var storedDataSets: [DataSet] = []
+    private var changeTracker = StoreChangeTracker()
     let interface: StoreProtocol
 
+    /// Result of the most recent save
+    private(set) var lastSaveReport: SaveReport?
+
+    /// Sidecar files that data set columns are mapped from instead of read row by row.
+    /// Only used for tables unchanged since the store was loaded or saved.
+    var columnCache: ColumnValueCache?
+
+    /// The file the store last matched, as it was then
+    private var documentStamp: ColumnValueCache.DocumentStamp?
+
+    /// Connections that may read data set values at the same time during a load
+    var maximumDataSetReaders = ProcessInfo.processInfo.activeProcessorCount
+
+    /// When the document file matches the store, data sets are created without their values and
+    /// read them from the file when first used; only those referenced by a layer are read during the load
+    var defersDataSetValues = true
+
+    /// Deferred data sets drawn by data layers are not read during the load; their sector counts are
+    /// computed inside SQLite instead, so very large data sets need not be held in memory
+    var countsSectorsInStore = false
+
+    /// Documents whose file is at least this many bytes count sectors in the store whether or not
+    /// `countsSectorsInStore` is set
+    var sectorCountingFileSize: UInt64 = 256 * 1024 * 1024
+
+    private var countsSectorsInDocument: Bool {
+        countsSectorsInStore || (documentStamp?.size ?? 0) >= sectorCountingFileSize
+    }
+
+    /// Source of the deferred data sets read since the document was loaded
+    private(set) var deferredValues: DeferredDataSetValues?
+
+    /// Timings of the most recent `readFromStore(completion:)`, set on the main queue
+    private(set) var lastLoadReport: LoadReport?
+
+    /// Encodes stored rows for change tracking. Sorted keys keep equal rows byte-identical.
+    private let snapshotEncoder: JSONEncoder = {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = .sortedKeys
+        return encoder
+    }()
+
+    /// Alias for the file database attached during an incremental save
+    private static let saveTarget = "saveTarget"
+
+    private let layerTypes: [TableRepresentable.Type] = [
+        Layer.self,
+        LayerText.self,
+        LayerLineArrow.self,
+        LayerCore.self,
+        LayerGrid.self,
+        LayerData.self
+    ]
+
     weak var delegate: InMemoryStoreDelegate?
 
     private let createTableQueries: [QueryProtocol] = [
@@ -95,6 +168,16 @@ class InMemoryStore: NSObject {
         try setupDatabase()
     }
 
+    /// A store that writes straight to a new database file instead of memory, so a document can be
+    /// built without holding all of it. Nothing may exist at `path` yet.
+    init(interface: StoreProtocol = SQLiteInterface(), creatingFileAt path: String) throws {
+        self.interface = interface
+        super.init()
+        let store = try interface.openDatabase(path: path)
+        sqliteStore = store
+        try configureStore(store: store)
+    }
+
     @available(*, deprecated, message: "This code will become unavailable")
     @objc func store() -> OpaquePointer? {
         sqliteStore
@@ -105,82 +188,202 @@ class InMemoryStore: NSObject {
     }
 
     func load(from filePath: String) throws {
+        // Data sets from an earlier load no longer match the store once it is replaced
+        deferredValues?.detach(readingTable: nil)
+        deferredValues = nil
         try backup(info: BackupInfo(path: filePath, type: .fromFile))
+        changeTracker.reset(baselinePath: filePath)
+        documentStamp = ColumnValueCache.DocumentStamp(path: filePath)
     }
 
+    /// Writes the store to a file.
+    ///
+    /// When the file is the one the store was last loaded from or saved to, only the tables and
+    /// layer rows changed since then are written, in one transaction. Otherwise, or if that
+    /// fails, the whole database is copied with the backup API.
     func save(to filePath: String) throws {
+        if canSaveIncrementally(to: filePath) {
+            do {
+                lastSaveReport = try saveIncrementally(to: filePath)
+                markSaved(to: filePath)
+                return
+            } catch {
+                logError(error: "Incremental save failed, saving a full copy: \(error)")
+            }
+        }
+        let store = try validateStore()
         try backup(info: BackupInfo(path: filePath, type: .toFile))
+        let pageCount = try pragmaValue("page_count", sqlite: store)
+        let pageSize = try pragmaValue("page_size", sqlite: store)
+        lastSaveReport = SaveReport(mode: .full, bytesWritten: pageCount * pageSize, tablesWritten: [], rowsWritten: 0)
+        markSaved(to: filePath)
+    }
+
+    /// Whether `save(to:)` can update the file in place with only the changed tables and rows
+    func canSaveIncrementally(to filePath: String) -> Bool {
+        changeTracker.canSaveIncrementally(to: filePath) && FileManager.default.fileExists(atPath: filePath)
+    }
+
+    /// Records that the file at `filePath` now holds the store's contents, for example after the
+    /// document moved a saved temporary file into place
+    func markSaved(to filePath: String) {
+        changeTracker.markSaved(to: filePath)
+        documentStamp = ColumnValueCache.DocumentStamp(path: filePath)
+        deferredValues?.relocate(to: documentStamp)
+    }
+
+    /// Whether tables or layer rows changed since the store was last loaded or saved
+    var hasUnsavedChanges: Bool {
+        changeTracker.hasChanges
+    }
+
+    /// Everything needed to draw a document, read in one call
+    struct Snapshot {
+        let geometry: Geometry?
+        let windowSize: CGSize?
+        let dataSets: [XRDataSet]
+        let layers: [XRLayer]
+    }
+
+    /// Describes how long each stage of a call to `readFromStore(completion:)` took
+    struct LoadReport {
+        enum Stage: String, CaseIterable {
+            case tableNames
+            case windowSize
+            case geometry
+            case dataSets
+            case layers
+        }
+
+        /// Time spent reading each stage, off the main thread. Building the layers overlaps
+        /// reading the data set values.
+        var durations: [Stage: Duration] = [:]
+        /// From the start of the load until the last update was queued for the delegate
+        var total: Duration = .zero
+        var dataSetCount = 0
+        /// Data sets whose values were left unread
+        var deferredDataSetCount = 0
+        /// Connections that read data set values at once
+        var dataSetReaders = 1
+        var layerCount = 0
+
+        fileprivate mutating func measure<T>(_ stage: Stage, _ body: () throws -> T) rethrows -> T {
+            let start = ContinuousClock.now
+            defer { durations[stage] = ContinuousClock.now - start }
+            return try body()
+        }
     }
 
     // MARK: - Read All
 
-    // swiftlint:disable:next function_body_length
+    /// Reads the document on the calling thread without notifying the delegate.
+    ///
+    /// Used where there is no document window to update, such as batch rendering. The layers are
+    /// not yet attached to a geometry controller or their data sets.
+    func readSnapshot() throws -> Snapshot {
+        let sqliteStore = try validateStore()
+        let dataSets = try dataSets(sqliteStore: sqliteStore)
+        let layers = try readLayers(sqliteStore: sqliteStore)
+        loadValues(of: dataSets, referencedBy: layers)
+        return try Snapshot(
+            geometry: optional { try geometry(sqliteStore: sqliteStore) },
+            windowSize: optional { try windowSize(sqliteStore: sqliteStore) },
+            dataSets: dataSets,
+            layers: layers
+        )
+    }
+
+    private func optional<T>(_ read: () throws -> T) throws -> T? {
+        do {
+            return try read()
+        } catch InMemoryStoreError.unexpectedEmptyResult {
+            return nil
+        }
+    }
+
+    /// Reads the document and hands each part to the delegate on the main queue as it is ready.
+    ///
+    /// Table names, window size and geometry are small and delivered first. The layer rows are then
+    /// read, and the layers are built while the data set values are read on their own connections.
+    /// Everything read from the in-memory store is read on the loading thread. The data sets always
+    /// reach the delegate before the layers that refer to them. `completion` is called on the main
+    /// queue after the last update.
     func readFromStore(completion: @escaping (Result<Bool, Error>) -> Void) {
-        // swiftlint:disable:next closure_body_length
-        DispatchQueue.global(qos: .background).async { [weak self] in
+        DispatchQueue.global(qos: .userInitiated).async { [weak self] in
             guard let self else {
-                completion(.failure(InMemoryStoreError.databaseDoesNotExist))
+                DispatchQueue.main.async { completion(.failure(InMemoryStoreError.databaseDoesNotExist)) }
                 return
             }
-            do {
-                let group = DispatchGroup()
-                let sqliteStore = try validateStore()
-                // directly settable values
-                let tableNames = try tableNames(sqliteStore: sqliteStore)
-                group.enter()
-                DispatchQueue.main.async { [weak self] in
-                    self?.delegate?.update(tableNames: tableNames)
-                    group.leave()
-                }
-                do {
-                    let windowSize = try windowSize(sqliteStore: sqliteStore)
-                    group.enter()
-                    DispatchQueue.main.async { [weak self] in
-                        self?.delegate?.update(windowSize: windowSize)
-                        group.leave()
-                    }
-                } catch InMemoryStoreError.unexpectedEmptyResult {
-                    print("Window size not found")
-                } catch {
-                    throw error
-                }
-                do {
-                    let geometry = try geometry(sqliteStore: sqliteStore)
-                    group.enter()
-                    DispatchQueue.main.async { [weak self] in
-                        self?.delegate?.update(geometry: geometry)
-                        group.leave()
-                    }
-                } catch InMemoryStoreError.unexpectedEmptyResult {
-                    print("Window size not found")
-                } catch {
-                    throw error
-                }
-                // requires additional processing
-                let dataSets = try dataSets(sqliteStore: sqliteStore)
-
-                // IMPORTANT: Update dataSets first and wait for it to complete
-                // before updating layers, because layers need to look up their
-                // datasets during configuration (especially XRLayerLineArrow)
-                group.enter()
-                DispatchQueue.main.async { [weak self] in
-                    self?.delegate?.update(dataSets: dataSets)
-                    group.leave()
-                }
-                // Wait for dataSets update to complete before loading layers
-                group.wait()
-
-                let layers = try readLayers(sqliteStore: sqliteStore)
-                group.enter()
-                DispatchQueue.main.async { [weak self] in
-                    self?.delegate?.update(layers: layers)
-                    group.leave()
-                }
-                // Wait for layers update to complete before calling completion
-                group.wait()
-                completion(.success(true))
-            } catch {
-                completion(.failure(error))
+            let result = Result { try loadStages() }
+            DispatchQueue.main.async {
+                completion(result.map { _ in true })
+            }
+        }
+    }
+
+    private func loadStages() throws {
+        let start = ContinuousClock.now
+        let sqliteStore = try validateStore()
+        var report = LoadReport()
+
+        let tableNames = try report.measure(.tableNames) { try tableNames(sqliteStore: sqliteStore) }
+        deliver { $0.update(tableNames: tableNames) }
+        if let windowSize = try report.measure(.windowSize, { try optional { try windowSize(sqliteStore: sqliteStore) } }) {
+            deliver { $0.update(windowSize: windowSize) }
+        }
+        if let geometry = try report.measure(.geometry, { try optional { try geometry(sqliteStore: sqliteStore) } }) {
+            deliver { $0.update(geometry: geometry) }
+        }
+
+        // The layer rows are read here, as the in-memory store's connection is only used from
+        // one thread at a time. Layers do not need the data sets until they are attached on the
+        // main queue, so they are built while the data set values are read.
+        let layerStart = ContinuousClock.now
+        let layerRows = try readLayerRows(sqliteStore: sqliteStore)
+        let layerReadDuration = ContinuousClock.now - layerStart
+        var layers: Result<[XRLayer], Error> = .success([])
+        var layerDuration: Duration = .zero
+        let layersBuilt = DispatchGroup()
+        DispatchQueue.global(qos: .userInitiated).async(group: layersBuilt) { [self] in
+            let buildStart = ContinuousClock.now
+            layers = Result { try createXRLayers(layerRows) }
+            layerDuration = layerReadDuration + (ContinuousClock.now - buildStart)
+        }
+        let dataSets = Result { try report.measure(.dataSets) { try readDataSets(sqliteStore: sqliteStore) } }
+        layersBuilt.wait()
+
+        var loaded = try dataSets.get()
+        let loadedLayers = try layers.get()
+        if loaded.readers == 0 {
+            // Deferred; read the values the layers need before they are attached, and leave the rest
+            let listing = report.durations[.dataSets] ?? .zero
+            loaded.readers = report.measure(.dataSets) {
+                loadValues(of: loaded.dataSets, referencedBy: loadedLayers)
+            }
+            report.durations[.dataSets, default: .zero] += listing
+        }
+        deliver { $0.update(dataSets: loaded.dataSets) }
+        // The main queue is serial, so the layers are attached after the data sets are set
+        deliver { $0.update(layers: loadedLayers) }
+
+        report.durations[.layers] = layerDuration
+        report.dataSetCount = loaded.dataSets.count
+        report.deferredDataSetCount = loaded.dataSets.filter { !$0.hasLoadedValues() }.count
+        report.dataSetReaders = loaded.readers
+        report.layerCount = loadedLayers.count
+        report.total = ContinuousClock.now - start
+        DispatchQueue.main.async { [weak self] in
+            self?.lastLoadReport = report
+        }
+        Logger.memoryStoreLogger.debug(
+            "Loaded \(report.dataSetCount) data sets on \(report.dataSetReaders) connections and \(report.layerCount) layers in \(String(describing: report.total))"
+        )
+    }
+
+    private func deliver(_ update: @escaping (InMemoryStoreDelegate) -> Void) {
+        DispatchQueue.main.async { [weak self] in
+            if let delegate = self?.delegate {
+                update(delegate)
             }
         }
     }
@@ -212,7 +415,8 @@ class InMemoryStore: NSObject {
             "sqlite_master",
             "sqlite_sequence"
         ]
-        return tables.filter { !nonDataTableNames.contains($0.name) }
+        // sqlite_master also lists indexes, such as covering indexes built for data set predicates
+        return tables.filter { $0.type == "table" && !nonDataTableNames.contains($0.name) }
     }
 
     // MARK: - BEGIN READING TABLES
@@ -220,23 +424,153 @@ class InMemoryStore: NSObject {
     // MARK: - Read Table Names
 
     private func dataSets(sqliteStore: OpaquePointer) throws -> [XRDataSet] {
+        try readDataSets(sqliteStore: sqliteStore).dataSets
+    }
+
+    /// Reads every data set, returning them with the number of connections that read values,
+    /// which is zero when they were deferred.
+    ///
+    /// When the document file still matches the store, the data sets are deferred if
+    /// `defersDataSetValues` is set, and no values are read. Otherwise values are read on up to
+    /// `maximumDataSetReaders` read-only connections to that file, each on its own thread.
+    /// Otherwise they are read one at a time from the in-memory store.
+    private func readDataSets(sqliteStore: OpaquePointer) throws -> (dataSets: [XRDataSet], readers: Int) {
         let sets: [DataSet] = try interface.executeCodableQuery(
             sqlite: sqliteStore,
             query: DataSet.storedValues()
         )
-        return try sets.map { set in
-            let values = try dataSetValues(for: set)
-            let data = Data(bytes: values, count: MemoryLayout<Float>.size * values.count)
-            return XRDataSet(
-                id: Int32(set._id ?? -1),
-                name: set.NAME ?? "Unnamed",
-                tableName: set.TABLENAME ?? "Unnamed",
-                column: set.COLUMNNAME ?? "Unnamed",
-                predicate: set.PREDICATE ?? "",
-                comments: set.decodedComments() ?? NSMutableAttributedString(),
-                data: data
-            )
+        if defersDataSetValues, fileForConcurrentReads(of: sets) != nil, let documentStamp {
+            let source = deferredValues ?? DeferredDataSetValues(
+                document: documentStamp,
+                interface: interface,
+                columnCache: columnCache
+            ) { [weak self] set in
+                guard let self else {
+                    throw InMemoryStoreError.databaseDoesNotExist
+                }
+                return try dataSetValues(for: set)
+            }
+            source.relocate(to: documentStamp)
+            source.countsSectorsInStore = countsSectorsInDocument
+            source.evictUnderMemoryPressure()
+            deferredValues = source
+            return (sets.map(source.makeDataSet), 0)
+        }
+        let schemas = columnCache == nil ? [:] : try Dictionary(
+            tableMetadata(sqliteStore: sqliteStore).map { ($0.name, $0.sql) },
+            uniquingKeysWith: { first, _ in first }
+        )
+        let sources = sets.map { set in
+            columnCacheSource(for: set, schema: set.TABLENAME.flatMap { schemas[$0] })
+        }
+        guard let path = fileForConcurrentReads(of: sets), sets.count > 1, maximumDataSetReaders > 1 else {
+            let dataSets = try zip(sets, sources).map { set, source in
+                try makeDataSet(set, source: source, sqlite: sqliteStore)
+            }
+            return (dataSets, 1)
+        }
+
+        let readers = min(maximumDataSetReaders, sets.count)
+        var results = [Result<XRDataSet, Error>?](repeating: nil, count: sets.count)
+        results.withUnsafeMutableBufferPointer { buffer in
+            // Each reader writes only its own slots
+            DispatchQueue.concurrentPerform(iterations: readers) { [buffer] reader in
+                let assigned = stride(from: reader, to: sets.count, by: readers)
+                do {
+                    let connection = try interface.openReadOnlyDatabase(path: path)
+                    defer { closeFile(file: connection) }
+                    for index in assigned {
+                        buffer[index] = Result { try makeDataSet(sets[index], source: sources[index], sqlite: connection) }
+                    }
+                } catch {
+                    for index in assigned {
+                        buffer[index] = .failure(error)
+                    }
+                }
+            }
         }
+        return try (results.map { try $0!.get() }, readers)
+    }
+
+    /// Reads the values of the deferred data sets that data and line arrow layers draw, on up to
+    /// `maximumDataSetReaders` threads. Data layers are skipped when sectors are counted in the store.
+    /// - returns: The number of threads that read values
+    @discardableResult
+    private func loadValues(of dataSets: [XRDataSet], referencedBy layers: [XRLayer]) -> Int {
+        let referenced = Set(layers.compactMap { layer -> Int32? in
+            if let dataLayer = layer as? XRLayerData {
+                return countsSectorsInDocument ? nil : dataLayer.datasetId()
+            }
+            return (layer as? XRLayerLineArrow)?.datasetId()
+        })
+        let needed = dataSets.filter { referenced.contains($0.setId()) && !$0.hasLoadedValues() }
+        guard !needed.isEmpty else {
+            return 0
+        }
+        let readers = max(1, min(maximumDataSetReaders, needed.count))
+        DispatchQueue.concurrentPerform(iterations: readers) { reader in
+            for index in stride(from: reader, to: needed.count, by: readers) {
+                needed[index].loadValues()
+            }
+        }
+        return readers
+    }
+
+    /// The loaded document file, if the data set tables in the store are still identical to it
+    private func fileForConcurrentReads(of sets: [DataSet]) -> String? {
+        guard let documentStamp,
+              ColumnValueCache.DocumentStamp(path: documentStamp.path) == documentStamp,
+              !sets.contains(where: { changeTracker.dirtyTables.contains($0.TABLENAME ?? "") })
+        else {
+            return nil
+        }
+        return documentStamp.path
+    }
+
+    private func makeDataSet(_ set: DataSet, source: ColumnValueCache.Source?, sqlite: OpaquePointer) throws -> XRDataSet {
+        let data = try dataSetValueData(for: set, source: source, sqlite: sqlite)
+        let dataSet = XRDataSet(
+            id: Int32(set._id ?? -1),
+            name: set.NAME ?? "Unnamed",
+            tableName: set.TABLENAME ?? "Unnamed",
+            column: set.COLUMNNAME ?? "Unnamed",
+            predicate: set.PREDICATE ?? "",
+            comments: set.decodedComments() ?? NSMutableAttributedString(),
+            valuesNoCopy: data
+        )
+        // The table keeps the original floats, so either compact storage is rebuilt from them
+        if set.angleStorage != .float {
+            dataSet.storeAnglesAsHundredths(losslessly: set.angleStorage == .hundredths)
+        }
+        return dataSet
+    }
+
+    /// The values of a data set as Float32 data, mapped from `columnCache` when its file is current
+    private func dataSetValueData(for set: DataSet, source: ColumnValueCache.Source?, sqlite: OpaquePointer) throws -> Data {
+        guard let source, let columnCache else {
+            let values = try dataSetValues(for: set, sqlite: sqlite)
+            return values.withUnsafeBufferPointer { Data(buffer: $0) }
+        }
+        return try Data(referencing: columnCache.values(for: source) { try dataSetValues(for: set, sqlite: sqlite) })
+    }
+
+    private func columnCacheSource(for set: DataSet, schema: String?) -> ColumnValueCache.Source? {
+        guard columnCache != nil,
+              let documentStamp,
+              let schema,
+              let table = set.TABLENAME,
+              let column = set.COLUMNNAME,
+              !changeTracker.dirtyTables.contains(table)
+        else {
+            return nil
+        }
+        return ColumnValueCache.Source(
+            document: documentStamp,
+            table: table,
+            column: column,
+            predicate: set.PREDICATE ?? "",
+            schema: schema
+        )
     }
 
     // MARK: - Read Window Size
@@ -323,6 +657,9 @@ class InMemoryStore: NSObject {
     func store(windowSize: CGSize) throws {
         let sqliteStore = try validateStore()
         let size = WindowControllerSize(width: windowSize.width, height: windowSize.height)
+        guard try changeTracker.updateTable(WindowControllerSize.tableName, contents: snapshotEncoder.encode(size)) else {
+            return
+        }
         _ = try interface.executeQuery(
             sqlite: sqliteStore, query: WindowControllerSize.deleteAllRecords()
         ) // No primary key exists
@@ -334,27 +671,20 @@ class InMemoryStore: NSObject {
     // MARK: - Data Sets
 
     func dataSetValues(for dataSet: DataSet) throws -> [Float] {
-        let sqliteStore = try validateStore()
+        try dataSetValues(for: dataSet, sqlite: validateStore())
+    }
+
+    private func dataSetValues(for dataSet: DataSet, sqlite: OpaquePointer) throws -> [Float] {
         guard let columnName = dataSet.COLUMNNAME else {
             throw InMemoryStoreError.databaseDoesNotExist
         }
-        let values = try interface.executeQuery(
-            sqlite: sqliteStore,
-            query: dataSet.dataQuery()
+        let hasRowID = interface.hasRowID(table: dataSet.TABLENAME ?? "", sqlite: sqlite)
+        return try interface.readColumn(
+            columnName,
+            as: Float.self,
+            sqlite: sqlite,
+            query: dataSet.dataQuery(orderedByRowID: hasRowID)
         )
-        return try values.compactMap { value in
-            guard let value = value[columnName] else {
-                return nil
-            }
-            if let stringValue = value as? String {
-                return Float(stringValue)
-            }
-            // swiftlint:disable:next legacy_objc_type
-            if let number = value as? NSNumber {
-                return Float(truncating: number)
-            }
-            throw InMemoryStoreError.unknownType
-        }
     }
 
     func valueColumnNames(for table: String) throws -> [String] {
@@ -370,19 +700,8 @@ class InMemoryStore: NSObject {
     }
 
     func store(dataSetWithName name: String, tableName: String, columnName: String) throws -> XRDataSet {
-        let sqliteStore = try validateStore()
         let dataSet = DataSet(NAME: name, TABLENAME: tableName, COLUMNNAME: columnName, PREDICATE: nil, COMMENTS: nil)
-        var query = DataSet.insertQuery()
-        query.bindings = try [dataSet.valueBindables(keys: DataSet.allKeys())]
-        _ = try interface.executeQuery(sqlite: sqliteStore, query: query)
-
-        // Retrieve the auto-assigned row ID
-        let rowResult = try interface.executeQuery(
-            sqlite: sqliteStore,
-            query: Query(sql: "SELECT last_insert_rowid() AS rowid;")
-        )
-        // SQLiteIntegerColumn returns Int32 via sqlite3_column_int
-        let insertedID = rowResult.first?["rowid"] as? Int32 ?? -1
+        let insertedID = try insert(dataSet: dataSet)
 
         let values = try dataSetValues(for: dataSet)
         let data = Data(bytes: values, count: MemoryLayout<Float>.size * values.count)
@@ -397,11 +716,46 @@ class InMemoryStore: NSObject {
         )
     }
 
+    /// Adds a `_datasets` record for values already in the store, without reading them back
+    /// - returns: The row ID assigned to the record
+    @discardableResult
+    func insert(dataSet: DataSet) throws -> Int32 {
+        let sqliteStore = try validateStore()
+        var query = DataSet.insertQuery()
+        query.bindings = try [dataSet.valueBindables(keys: DataSet.allKeys())]
+        _ = try interface.executeQuery(sqlite: sqliteStore, query: query)
+        changeTracker.markTableDirty(DataSet.tableName)
+
+        // Retrieve the auto-assigned row ID
+        let rowResult = try interface.executeQuery(
+            sqlite: sqliteStore,
+            query: Query(sql: "SELECT last_insert_rowid() AS rowid;")
+        )
+        // SQLiteIntegerColumn returns Int32 via sqlite3_column_int
+        return rowResult.first?["rowid"] as? Int32 ?? -1
+    }
+
+    /// Records how a data set stores its angles, adding the `ANGLESTORAGE` column to documents
+    /// that predate it
+    func store(angleStorage: XRDataSetAngleStorage, forDataSetID id: Int32) throws {
+        let sqliteStore = try validateStore()
+        let columns = try interface.columns(sqlite: sqliteStore, table: DataSet.tableName)
+        if !columns.contains(where: { $0.name == "ANGLESTORAGE" }) {
+            try addColumn(to: DataSet.tableName, columnDefinition: DataSet.angleStorageColumnDefinition)
+        }
+        let update = DataSet.updateAngleStorageQuery(angleStorage, id: id)
+        _ = try interface.executeQuery(sqlite: sqliteStore, query: update)
+        changeTracker.markTableDirty(DataSet.tableName)
+    }
+
     // MARK: - Geometry
 
     func store(geometryController: XRGeometryController) throws {
         let sqliteStore = try validateStore()
         let geometry = storageLayerFactory.storageGeometry(from: geometryController)
+        guard try changeTracker.updateTable(Geometry.tableName, contents: snapshotEncoder.encode(geometry)) else {
+            return
+        }
         _ = try interface.executeQuery(sqlite: sqliteStore, query: Geometry.deleteAllRecords())
         var query = Geometry.insertQuery()
         query.bindings = try [geometry.valueBindables(keys: Geometry.allKeys())]
@@ -411,28 +765,22 @@ class InMemoryStore: NSObject {
     func configure(geometryController: XRGeometryController) throws {
         let sqliteStore = try validateStore()
         let geometry = try geometry(sqliteStore: sqliteStore)
-        geometryController.configureIsEqualArea(
-            geometry.isEqualArea,
-            isPercent: geometry.isPercent,
-            maxCount: Int32(geometry.MAXCOUNT),
-            maxPercent: geometry.MAXPERCENT,
-            hollowCore: geometry.HOLLOWCORE,
-            sectorSize: geometry.SECTORSIZE,
-            startingAngle: geometry.STARTINGANGLE,
-            sectorCount: Int32(geometry.SECTORCOUNT),
-            relativeSize: geometry.RELATIVESIZE
-        )
+        storageLayerFactory.configure(geometryController, from: geometry)
     }
 
     // MARK: - Colors
 
     private func storeColors(sqliteStore: OpaquePointer) throws {
+        let colors = storageLayerFactory.colors
+        guard try changeTracker.updateTable(Color.tableName, contents: snapshotEncoder.encode(colors)) else {
+            return
+        }
         _ = try interface.executeQuery(
             sqlite: sqliteStore,
             query: Color.deleteAllRecords()
         )
         var query = Color.insertQuery()
-        query.bindings = try storageLayerFactory.colors.map { color in
+        query.bindings = try colors.map { color in
             try color.valueBindables(keys: Color.allKeys())
         }
         _ = try interface.executeQuery(
@@ -443,78 +791,123 @@ class InMemoryStore: NSObject {
 
     // MARK: - Storing Layers
 
+    /// Stores the layers, writing only the rows that differ from the last stored layers.
+    ///
+    /// Each layer's rows use its index as `LAYERID`. Tables that have not been stored since the
+    /// store was loaded are cleared and rewritten.
     func store(layers: [XRLayer]) throws {
         let sqliteStore = try validateStore()
         storageLayerFactory.clearColors()
-        try deleteAllLayers(sqliteStore: sqliteStore)
+        var rowsByTable: [String: [Int: TableRepresentable]] = [:]
         for (index, layer) in layers.enumerated() {
-            try store(layer: layer, at: index, in: sqliteStore)
+            for storageLayer in storageLayerFactory.storageLayers(from: layer, at: index) {
+                rowsByTable[type(of: storageLayer).tableName, default: [:]][index] = storageLayer
+            }
+        }
+        for layerType in layerTypes {
+            let rows = rowsByTable[layerType.tableName] ?? [:]
+            let encodedRows = try rows.mapValues { try snapshotEncoder.encode($0) }
+            if let changes = changeTracker.updateRows(in: layerType.tableName, rows: encodedRows) {
+                try store(changes: changes, rows: rows, of: layerType, in: sqliteStore)
+            } else {
+                _ = try interface.executeQuery(sqlite: sqliteStore, query: layerType.deleteAllRecords())
+                try insert(rows: rows.keys.sorted().compactMap { rows[$0] }, of: layerType, in: sqliteStore)
+            }
         }
         try storeColors(sqliteStore: sqliteStore)
     }
 
-    private func store(layer: XRLayer, at index: Int, in sqliteStore: OpaquePointer) throws {
-        try storageLayerFactory.storageLayers(from: layer, at: index)
-            .forEach { storageLayer in
-                let layerType = type(of: storageLayer)
-                var query = layerType.insertQuery()
-                query.bindings = try [storageLayer.valueBindables(keys: layerType.allKeys())]
-                _ = try interface.executeQuery(sqlite: sqliteStore, query: query)
-            }
+    private func store(
+        changes: StoreChangeTracker.RowChanges,
+        rows: [Int: TableRepresentable],
+        of layerType: TableRepresentable.Type,
+        in sqliteStore: OpaquePointer
+    ) throws {
+        guard !changes.isEmpty else {
+            return
+        }
+        let layerIDs = changes.changed.union(changes.removed).sorted()
+        let delete = Query(
+            sql: "DELETE FROM \(layerType.tableName) WHERE LAYERID = ?;",
+            bindings: layerIDs.map { [$0] }
+        )
+        _ = try interface.executeQuery(sqlite: sqliteStore, query: delete)
+        try insert(rows: changes.changed.sorted().compactMap { rows[$0] }, of: layerType, in: sqliteStore)
     }
 
-    private func deleteAllLayers(sqliteStore: OpaquePointer) throws {
-        let deleteQueries = [
-            Layer.deleteAllRecords(),
-            LayerText.deleteAllRecords(),
-            LayerLineArrow.deleteAllRecords(),
-            LayerCore.deleteAllRecords(),
-            LayerGrid.deleteAllRecords(),
-            LayerData.deleteAllRecords()
-        ]
-        try deleteQueries.forEach { query in
-            _ = try interface.executeQuery(sqlite: sqliteStore, query: query)
+    private func insert(rows: [TableRepresentable], of layerType: TableRepresentable.Type, in sqliteStore: OpaquePointer) throws {
+        guard !rows.isEmpty else {
+            return
         }
+        var query = layerType.insertQuery()
+        query.bindings = try rows.map { try $0.valueBindables(keys: layerType.allKeys()) }
+        _ = try interface.executeQuery(sqlite: sqliteStore, query: query)
     }
 
     // MARK: - Reading Layers
 
     func readLayers(sqliteStore: OpaquePointer) throws -> [XRLayer] {
+        try createXRLayers(readLayerRows(sqliteStore: sqliteStore))
+    }
+
+    /// Each `_layers` row with its typed row, and the colors they use, ready for `createXRLayers`
+    private func readLayerRows(sqliteStore: OpaquePointer) throws -> [(Layer, LayerIdentifiable)] {
         let sqliteStore = try validateStore()
         let layers = try readLayerTable(sqliteStore: sqliteStore)
-        var typeLayers: [String: [LayerIdentifiable]] = [:]
-        let layerTexts = try readLayerTextTable(sqliteStore: sqliteStore)
-        typeLayers["XRLayerText"] = layerTexts
-        let layerLineArrows = try readLayerLineArrowTable(sqliteStore: sqliteStore)
-        typeLayers["XRLayerLineArrow"] = layerLineArrows
-        let layerCores = try readLayerCoreTable(sqliteStore: sqliteStore)
-        typeLayers["XRLayerCore"] = layerCores
-        let layerGrids = try readLayerGridTable(sqliteStore: sqliteStore)
-        typeLayers["XRLayerGrid"] = layerGrids
-        let layerDatas = try readLayerDataTable(sqliteStore: sqliteStore)
-        typeLayers["XRLayerData"] = layerDatas
+        var typeLayers: [String: [Int: LayerIdentifiable]] = [:]
+        typeLayers["XRLayerText"] = try indexed(readLayerTextTable(sqliteStore: sqliteStore))
+        typeLayers["XRLayerLineArrow"] = try indexed(readLayerLineArrowTable(sqliteStore: sqliteStore))
+        typeLayers["XRLayerCore"] = try indexed(readLayerCoreTable(sqliteStore: sqliteStore))
+        typeLayers["XRLayerGrid"] = try indexed(readLayerGridTable(sqliteStore: sqliteStore))
+        typeLayers["XRLayerData"] = try indexed(readLayerDataTable(sqliteStore: sqliteStore))
         let colors = try readColors(sqliteStore: sqliteStore)
         storageLayerFactory.set(colors: colors)
-        var xrLayers: [XRLayer] = []
-        for layer in layers {
-            guard
-                let typeLayerArray = typeLayers[layer.TYPE],
-                let typeLayer = typeLayerArray.first(where: { $0.LAYERID == layer.LAYERID })
-            else {
+        return try layers.map { layer in
+            guard let typeLayer = typeLayers[layer.TYPE]?[layer.LAYERID] else {
                 throw InMemoryStoreError.invalidLayersStore
             }
-            let newLayer = try storageLayerFactory.createXRLayer(baseLayer: layer, targetLayer: typeLayer)
-            xrLayers.append(newLayer)
+            return (layer, typeLayer)
         }
-        return xrLayers
+    }
+
+    /// Typed layer rows by `LAYERID`; the first row wins if an ID repeats
+    private func indexed(_ rows: [LayerIdentifiable]) -> [Int: LayerIdentifiable] {
+        Dictionary(rows.map { ($0.LAYERID, $0) }, uniquingKeysWith: { first, _ in first })
+    }
+
+    /// Layer counts from which `createXRLayers` spreads the work over several threads
+    static let concurrentLayerDecodeThreshold = 256
+
+    /// Builds the layers in order; the factory only reads its colors here, so large documents
+    /// build them on several threads
+    private func createXRLayers(_ pairs: [(Layer, LayerIdentifiable)]) throws -> [XRLayer] {
+        guard pairs.count >= Self.concurrentLayerDecodeThreshold else {
+            return try pairs.map { try storageLayerFactory.createXRLayer(baseLayer: $0.0, targetLayer: $0.1) }
+        }
+        let factory = storageLayerFactory
+        let chunks = min(ProcessInfo.processInfo.activeProcessorCount, pairs.count / 64)
+        var results = [Result<XRLayer, Error>?](repeating: nil, count: pairs.count)
+        results.withUnsafeMutableBufferPointer { buffer in
+            DispatchQueue.concurrentPerform(iterations: chunks) { [buffer] chunk in
+                let range = (pairs.count * chunk / chunks) ..< (pairs.count * (chunk + 1) / chunks)
+                for index in range {
+                    buffer[index] = Result { try factory.createXRLayer(baseLayer: pairs[index].0, targetLayer: pairs[index].1) }
+                }
+            }
+        }
+        return try results.map { try $0!.get() }
     }
 
     // MARK: - Table Manipulation
 
     @objc func renameTable(from: String, toName: String) throws {
         let sqliteStore = try validateStore()
+        deferredValues?.detach(readingTable: from)
         let query = Query(sql: "ALTER TABLE \(from) RENAME TO \(toName)")
         _ = try interface.executeQuery(sqlite: sqliteStore, query: query)
+        interface.invalidateStatements(sqlite: sqliteStore)
+        changeTracker.markTableDirty(from)
+        changeTracker.markTableDirty(toName)
 
         // Notify delegate of updated table names
         let updatedTableNames = try tableNames(sqliteStore: sqliteStore)
@@ -525,14 +918,42 @@ class InMemoryStore: NSObject {
 
     @objc func addColumn(to table: String, columnDefinition: String) throws {
         let sqliteStore = try validateStore()
+        deferredValues?.detach(readingTable: table)
         let query = Query(sql: "ALTER TABLE \(table) ADD COLUMN \(columnDefinition)")
         _ = try interface.executeQuery(sqlite: sqliteStore, query: query)
+        interface.invalidateStatements(sqlite: sqliteStore)
+        changeTracker.markTableDirty(table)
     }
 
     @objc func drop(table: String) throws {
         let sqliteStore = try validateStore()
+        deferredValues?.detach(readingTable: table)
         let query = Query(sql: "DROP TABLE \(table)")
         _ = try interface.executeQuery(sqlite: sqliteStore, query: query)
+        interface.invalidateStatements(sqlite: sqliteStore)
+        changeTracker.markTableDirty(table)
+    }
+
+    /// Indexes the columns a data set's predicate filters on, followed by its value column,
+    /// so the data set can be read from the index without visiting the table
+    ///
+    /// Words the predicate quotes that are not columns of the table are string literals and are left
+    /// out. Data set queries order by rowid, so values keep their table order. The index changes the
+    /// table's schema, so the next save copies the table and its indexes.
+    /// - returns: false if the data set has no predicate column, or its predicate could not be compiled
+    @discardableResult
+    func createCoveringIndex(for dataSet: DataSet) throws -> Bool {
+        let sqliteStore = try validateStore()
+        guard let compiled = dataSet.compiledQuery() else {
+            return false
+        }
+        let columns = try interface.columns(sqlite: sqliteStore, table: DataSetQuery.quoted(compiled.table))
+        guard let index = compiled.restricted(to: columns.map(\.name)).coveringIndexQuery() else {
+            return false
+        }
+        _ = try interface.executeQuery(sqlite: sqliteStore, query: index)
+        interface.invalidateStatements(sqlite: sqliteStore)
+        return true
     }
 
     /// Creates a user data table and inserts all rows in a single transaction.
@@ -555,6 +976,29 @@ class InMemoryStore: NSObject {
         }
     }
 
+    /// Creates a user data table and inserts the rows returned by `nextRow` in a single transaction.
+    /// One prepared insert is reused for every row, so rows are never held in memory together.
+    /// Rolls back and rethrows on any failure, including an error thrown by `nextRow`.
+    /// - returns: The number of rows inserted
+    @discardableResult
+    func createUserTable(
+        createSQL: String,
+        insertSQL: String,
+        nextRow: () throws -> [Bindable?]?
+    ) throws -> Int {
+        let database = try validateStore()
+        _ = try interface.executeQuery(sqlite: database, query: Query(sql: "BEGIN"))
+        do {
+            _ = try interface.executeQuery(sqlite: database, query: Query(sql: createSQL))
+            let count = try interface.executeEach(sqlite: database, sql: insertSQL, nextRow: nextRow)
+            _ = try interface.executeQuery(sqlite: database, query: Query(sql: "COMMIT"))
+            return count
+        } catch {
+            _ = try? interface.executeQuery(sqlite: database, query: Query(sql: "ROLLBACK"))
+            throw error
+        }
+    }
+
     /// Copies selected tables from a source .XRose file into the in-memory store.
     /// Rolls back and rethrows on any failure.
     func copyTables(
@@ -565,6 +1009,8 @@ class InMemoryStore: NSObject {
         let attachSQL = "ATTACH DATABASE \"\(sourceURL.path.sqliteEscaped)\" AS source"
         _ = try interface.executeQuery(sqlite: database, query: Query(sql: attachSQL))
         defer {
+            // Statements that name the attached database are not reusable once it is detached
+            interface.invalidateStatements(sqlite: database)
             _ = try? interface.executeQuery(sqlite: database, query: Query(sql: "DETACH DATABASE source"))
         }
         _ = try interface.executeQuery(sqlite: database, query: Query(sql: "BEGIN"))
@@ -580,6 +1026,7 @@ class InMemoryStore: NSObject {
                 let src = pair.original.sqliteEscaped
                 let copySQL = "INSERT INTO main.\"\(dst)\" SELECT * FROM source.\"\(src)\""
                 _ = try interface.executeQuery(sqlite: database, query: Query(sql: copySQL))
+                changeTracker.markTableDirty(pair.destination)
             }
             _ = try interface.executeQuery(sqlite: database, query: Query(sql: "COMMIT"))
         } catch {
@@ -613,6 +1060,125 @@ class InMemoryStore: NSObject {
         return sql.replacingOccurrences(of: sourceName, with: escapedDst, options: .caseInsensitive)
     }
 
+    // MARK: - Incremental Save
+
+    private func saveIncrementally(to filePath: String) throws -> SaveReport {
+        let database = try validateStore()
+        let target = Self.saveTarget
+        let attachSQL = "ATTACH DATABASE \"\(filePath.sqliteEscaped)\" AS \(target)"
+        _ = try interface.executeQuery(sqlite: database, query: Query(sql: attachSQL))
+        defer {
+            interface.invalidateStatements(sqlite: database)
+            _ = try? interface.executeQuery(sqlite: database, query: Query(sql: "DETACH DATABASE \(target)"))
+        }
+
+        let mainSchema = try schemaSignatures(database: database, schema: "main")
+        let targetSchema = try schemaSignatures(database: database, schema: target)
+        // Tables whose definition or indexes differ were created, renamed or altered since the last save
+        let changedSchemas = Set(mainSchema.keys).union(targetSchema.keys).filter { mainSchema[$0] != targetSchema[$0] }
+        let tables = changeTracker.dirtyTables.union(changedSchemas)
+
+        _ = interface.pagesWritten(sqlite: database, reset: true)
+        _ = try interface.executeQuery(sqlite: database, query: Query(sql: "BEGIN"))
+        var rowsWritten = 0
+        do {
+            for table in tables.sorted() {
+                try copyTable(table, database: database, exists: mainSchema[table] != nil)
+            }
+            for (table, changes) in changeTracker.dirtyRows where !tables.contains(table) {
+                rowsWritten += try copyRows(changes.changed.union(changes.removed), of: table, database: database)
+            }
+            _ = try interface.executeQuery(sqlite: database, query: Query(sql: "COMMIT"))
+        } catch {
+            _ = try? interface.executeQuery(sqlite: database, query: Query(sql: "ROLLBACK"))
+            throw error
+        }
+        let pageSize = try pragmaValue("\(target).page_size", sqlite: database)
+        return SaveReport(
+            mode: .incremental,
+            bytesWritten: interface.pagesWritten(sqlite: database, reset: false) * pageSize,
+            tablesWritten: tables.sorted(),
+            rowsWritten: rowsWritten
+        )
+    }
+
+    /// Table and index definitions in a schema, keyed by table name
+    private func schemaSignatures(database: OpaquePointer, schema: String) throws -> [String: String] {
+        let entries: [TableSchema] = try interface.executeCodableQuery(
+            sqlite: database,
+            query: Query(sql: """
+            SELECT * FROM \(schema).sqlite_master
+            WHERE type IN ('table', 'index') AND sql IS NOT NULL AND name NOT LIKE 'sqlite_%';
+            """)
+        )
+        var signatures: [String: String] = [:]
+        // sqlite_master stores definitions without a schema qualifier, so they compare across databases
+        for entry in entries.sorted(by: { ($0.type, $0.name) > ($1.type, $1.name) }) {
+            signatures[entry.tbl_name, default: ""] += entry.sql + ";"
+        }
+        return signatures
+    }
+
+    private func copyTable(_ table: String, database: OpaquePointer, exists: Bool) throws {
+        let target = Self.saveTarget
+        let name = "\"\(table.sqliteEscaped)\""
+        _ = try interface.executeQuery(sqlite: database, query: Query(sql: "DROP TABLE IF EXISTS \(target).\(name)"))
+        guard exists else {
+            return
+        }
+        let query = Query(
+            sql: "SELECT * FROM main.sqlite_master WHERE tbl_name = ? AND type IN ('table', 'index') AND sql IS NOT NULL;",
+            bindings: [[table as Bindable?]]
+        )
+        let entries: [TableSchema] = try interface.executeCodableQuery(sqlite: database, query: query)
+        // Rows are copied before the indexes are built
+        for entry in entries where entry.type == "table" {
+            _ = try interface.executeQuery(sqlite: database, query: Query(sql: qualify(entry, schema: target)))
+        }
+        _ = try interface.executeQuery(
+            sqlite: database,
+            query: Query(sql: "INSERT INTO \(target).\(name) SELECT * FROM main.\(name)")
+        )
+        for entry in entries where entry.type != "table" {
+            _ = try interface.executeQuery(sqlite: database, query: Query(sql: qualify(entry, schema: target)))
+        }
+    }
+
+    private func copyRows(_ layerIDs: Set<Int>, of table: String, database: OpaquePointer) throws -> Int {
+        guard !layerIDs.isEmpty else {
+            return 0
+        }
+        let target = Self.saveTarget
+        let bindings: [[Bindable?]] = layerIDs.sorted().map { [$0] }
+        _ = try interface.executeQuery(
+            sqlite: database,
+            query: Query(sql: "DELETE FROM \(target).\(table) WHERE LAYERID = ?;", bindings: bindings)
+        )
+        _ = try interface.executeQuery(
+            sqlite: database,
+            query: Query(
+                sql: "INSERT INTO \(target).\(table) SELECT * FROM main.\(table) WHERE LAYERID = ?;",
+                bindings: bindings
+            )
+        )
+        return layerIDs.count
+    }
+
+    /// Adds a schema qualifier to a definition read from sqlite_master, which stores
+    /// `CREATE TABLE name ...` or `CREATE [UNIQUE] INDEX name ON ...`
+    private func qualify(_ entry: TableSchema, schema: String) -> String {
+        let keyword = entry.type.uppercased() + " "
+        guard let range = entry.sql.range(of: keyword) else {
+            return entry.sql
+        }
+        return entry.sql.replacingCharacters(in: range, with: keyword + schema + ".")
+    }
+
+    private func pragmaValue(_ pragma: String, sqlite: OpaquePointer) throws -> Int {
+        let values: [Int] = try interface.executeCodableQuery(sqlite: sqlite, query: Query(sql: "PRAGMA \(pragma);"))
+        return values.first ?? 0
+    }
+
     @discardableResult
     private func validateStore() throws -> OpaquePointer {
         guard let sqliteStore else {
@@ -630,6 +1196,8 @@ class InMemoryStore: NSObject {
         switch info.type {
         case .fromFile:
             try interface.backup(source: file, destination: store)
+            // The loaded file replaces the schema the cached statements were prepared against
+            interface.invalidateStatements(sqlite: store)
 
         case .toFile:
             try interface.backup(source: store, destination: file)
@@ -504,6 +504,39 @@ struct InMemoryStoreIntegrationTest {
         try store.store(layers: layers)
     }
 
+    @Test(
+        "Benchmark storing many layers with and without the statement cache",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkStoreLayers() throws {
+        let layerCount = 500
+        let layers = (0 ..< layerCount).map { index -> XRLayer in
+            switch index % 3 {
+            case 0:
+                XRLayerGrid.stub()
+
+            case 1:
+                XRLayerCore.stub()
+
+            default:
+                XRLayerText.stub()
+            }
+        }
+        let uncachedStore = try InMemoryStore(interface: SQLiteInterface(statementCache: nil))
+        let uncached = try Benchmark.measure("store \(layerCount) layers, prepare per insert") {
+            try uncachedStore.store(layers: layers)
+        }
+        let cache = SQLiteStatementCache()
+        let cachedStore = try InMemoryStore(interface: SQLiteInterface(statementCache: cache))
+        cache.resetStatistics()
+        let cached = try Benchmark.measure("store \(layerCount) layers, statement cache") {
+            try cachedStore.store(layers: layers)
+        }
+        print("[benchmark] statement cache \(cache.statistics), speedup \(Benchmark.seconds(uncached) / Benchmark.seconds(cached))x")
+        #expect(cache.statistics.hits > cache.statistics.misses)
+    }
+
     // MARK: - Read From Store
 
     // swiftlint:disable object_literal
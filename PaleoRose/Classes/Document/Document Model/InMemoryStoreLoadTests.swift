@@ -0,0 +1,262 @@
+//
+// InMemoryStoreLoadTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import AppKit
+import CodableSQLiteNonThread
+import Foundation
+@testable import PaleoRose
+import Testing
+
+@Suite(
+    "InMemory Store Load",
+    .tags(.integration),
+    .serialized
+)
+struct InMemoryStoreLoadTests {
+
+    /// Records the order in which the store delivered each part of the document
+    private final class RecordingDelegate: InMemoryStoreDelegate {
+        private(set) var events: [String] = []
+        private(set) var dataSets: [XRDataSet] = []
+        private(set) var layers: [XRLayer] = []
+
+        func update(tableNames _: [String]) {
+            events.append("tableNames")
+        }
+
+        func update(windowSize _: CGSize) {
+            events.append("windowSize")
+        }
+
+        func update(dataSets: [XRDataSet]) {
+            events.append("dataSets")
+            self.dataSets = dataSets
+        }
+
+        func update(layers: [XRLayer]) {
+            events.append("layers")
+            self.layers = layers
+        }
+
+        func update(geometry _: Geometry) {
+            events.append("geometry")
+        }
+    }
+
+    // MARK: - Test Setup
+
+    private func load(_ store: InMemoryStore) async throws -> Bool {
+        try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Bool, Error>) in
+            store.readFromStore { result in
+                continuation.resume(with: result)
+            }
+        }
+    }
+
+    // MARK: - Tests
+
+    @Test("Data sets reach the delegate before the layers, and completion comes last")
+    @MainActor
+    func deliveryOrder() async throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let store = try InMemoryStore(interface: SQLiteInterface())
+        let delegate = RecordingDelegate()
+        store.delegate = delegate
+        try store.load(from: InMemoryStore.sampleDocument(in: directory))
+
+        #expect(try await load(store))
+
+        #expect(delegate.events.count == 5)
+        #expect(delegate.events.prefix(3).sorted() == ["geometry", "tableNames", "windowSize"])
+        #expect(Array(delegate.events.suffix(2)) == ["dataSets", "layers"])
+        #expect(delegate.layers.count == 3)
+    }
+
+    @Test("Every stage is timed")
+    func loadReport() async throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let store = try InMemoryStore(interface: SQLiteInterface())
+        try store.load(from: InMemoryStore.sampleDocument(in: directory, dataSetCount: 3))
+
+        _ = try await load(store)
+
+        let report = try #require(store.lastLoadReport)
+        #expect(Set(report.durations.keys) == Set(InMemoryStore.LoadReport.Stage.allCases))
+        #expect(report.dataSetCount == 4)
+        #expect(report.layerCount == 3)
+        #expect(report.total >= report.durations[.dataSets] ?? .zero)
+    }
+
+    @Test("Data sets read on several connections match a serial read", arguments: [2, 4, 16])
+    func concurrentReadsMatchSerial(readers: Int) throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let path = try InMemoryStore.sampleDocument(in: directory, dataSetCount: 6)
+
+        let serial = try InMemoryStore(interface: SQLiteInterface())
+        serial.maximumDataSetReaders = 1
+        serial.defersDataSetValues = false
+        try serial.load(from: path)
+        let concurrent = try InMemoryStore(interface: SQLiteInterface())
+        concurrent.maximumDataSetReaders = readers
+        concurrent.defersDataSetValues = false
+        try concurrent.load(from: path)
+
+        let expected = try serial.readSnapshot().dataSets
+        let dataSets = try concurrent.readSnapshot().dataSets
+
+        #expect(dataSets.map { $0.setId() } == expected.map { $0.setId() })
+        #expect(dataSets.map { $0.name() } == expected.map { $0.name() })
+        #expect(InMemoryStore.values(of: dataSets) == InMemoryStore.values(of: expected))
+    }
+
+    @Test("A changed data table is read from the in-memory store")
+    func changedTableReadsSerially() async throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let store = try InMemoryStore(interface: SQLiteInterface())
+        store.maximumDataSetReaders = 4
+        try store.load(from: InMemoryStore.sampleDocument(in: directory, dataSetCount: 3))
+        try store.addColumn(to: "set1", columnDefinition: "note TEXT")
+
+        _ = try await load(store)
+
+        #expect(store.lastLoadReport?.dataSetReaders == 1)
+        #expect(store.lastLoadReport?.dataSetCount == 4)
+    }
+
+    @Test("Unchanged documents read their data sets concurrently")
+    func unchangedDocumentReadsConcurrently() async throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let store = try InMemoryStore(interface: SQLiteInterface())
+        store.maximumDataSetReaders = 3
+        store.defersDataSetValues = false
+        try store.load(from: InMemoryStore.sampleDocument(in: directory, dataSetCount: 5))
+
+        _ = try await load(store)
+
+        #expect(store.lastLoadReport?.dataSetReaders == 3)
+    }
+
+    @Test(
+        "Angle storage is recorded in documents that predate it and applied when they are opened",
+        arguments: [false, true]
+    )
+    func angleStorageIsReapplied(defers: Bool) throws {
+        let directory = try InMemoryStore.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let store = try InMemoryStore(interface: SQLiteInterface())
+        store.defersDataSetValues = false
+        try store.load(from: InMemoryStore.sampleDocument(in: directory, dataSetCount: 2))
+        let dataSets = try store.readSnapshot().dataSets
+        let storage: [String: XRDataSetAngleStorage] = ["Set 0": .hundredths, "Set 1": .roundedHundredths]
+        for dataSet in dataSets {
+            if let angleStorage = storage[dataSet.name()] {
+                try store.store(angleStorage: angleStorage, forDataSetID: dataSet.setId())
+            }
+        }
+        let path = directory.appendingPathComponent("saved.XRose").path
+        try store.save(to: path)
+
+        let reopened = try InMemoryStore(interface: SQLiteInterface())
+        reopened.defersDataSetValues = defers
+        try reopened.load(from: path)
+        let reloaded = try reopened.readSnapshot().dataSets
+
+        // Deferred data sets take their storage when their values are read
+        #expect(InMemoryStore.values(of: reloaded) == InMemoryStore.values(of: dataSets))
+        #expect(reloaded.map { $0.angleStorage() } == dataSets.map { storage[$0.name()] ?? .float })
+    }
+
+    // MARK: - Benchmark
+
+    @Test(
+        "Benchmark: data set loading scales with the number of data sets",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkConcurrentLoad() throws {
+        let cores = ProcessInfo.processInfo.activeProcessorCount
+        for dataSetCount in [1, 2, 4, 8] where dataSetCount <= max(cores, 2) {
+            let directory = try InMemoryStore.temporaryDirectory()
+            defer { try? FileManager.default.removeItem(at: directory) }
+            let path = try InMemoryStore.sampleDocument(in: directory, dataSetCount: dataSetCount, rows: 1_000_000)
+
+            var timings: [Int: Duration] = [:]
+            for readers in [1, dataSetCount] {
+                let store = try InMemoryStore(interface: SQLiteInterface())
+                store.maximumDataSetReaders = readers
+                store.defersDataSetValues = false
+                try store.load(from: path)
+                timings[readers] = try Benchmark.measure("\(dataSetCount) x 1M values, \(readers) connection(s)") {
+                    _ = try store.readSnapshot()
+                }
+            }
+            let speedup = try Benchmark.seconds(#require(timings[1])) / Benchmark.seconds(#require(timings[dataSetCount]))
+            print("[benchmark] \(dataSetCount) data sets: \(String(format: "%.2f", speedup))x")
+            if dataSetCount >= 4 {
+                #expect(speedup > Double(dataSetCount) / 2)
+            }
+        }
+    }
+
+    @Test(
+        "Benchmark: storing and reading layers scales linearly with the number of layers",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkLayerRoundTrip() throws {
+        var timings: [Int: Duration] = [:]
+        for layerCount in [1000, 10000] {
+            // Text and line layers, as scripts produce them, in a handful of colors
+            let palette: [NSColor] = (0 ..< 8).map {
+                NSColor(deviceHue: CGFloat($0) / 8, saturation: 1, brightness: 1, alpha: 1)
+            }
+            let layers: [XRLayer] = (0 ..< layerCount).map { index in
+                let color = palette[index % palette.count]
+                if index.isMultiple(of: 2) {
+                    return XRLayerText.stub(name: "Label \(index)", stroke: color)
+                }
+                return XRLayerLineArrow.stub(name: "Vector \(index)", stroke: color)
+            }
+            let store = try InMemoryStore(interface: SQLiteInterface())
+            var reread: [XRLayer] = []
+            timings[layerCount] = try Benchmark.measure("\(layerCount) layers stored and read", iterations: 1) {
+                try store.store(layers: layers)
+                reread = try store.readLayers(sqliteStore: store.sqlitePointer())
+            }
+            #expect(reread.count == layerCount)
+            #expect(reread.map { $0.layerName() } == layers.map { $0.layerName() })
+        }
+        let growth = try Benchmark.seconds(#require(timings[10000])) / Benchmark.seconds(#require(timings[1000]))
+        print("[benchmark] 10x the layers took \(String(format: "%.1f", growth))x as long")
+        #expect(growth < 30)
+    }
+}
@@ -0,0 +1,184 @@
+//
+// InMemoryStoreSaveTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import CodableSQLiteNonThread
+import Foundation
+@testable import PaleoRose
+import Testing
+
+@Suite(
+    "InMemory Store Save",
+    .tags(.integration)
+)
+struct InMemoryStoreSaveTests {
+    private func sampleFilePath() throws -> String {
+        guard
+            let bundle = Bundle(identifier: "PaleoTerra.Unit-Tests"),
+            let path = bundle.path(forResource: "rtest1", ofType: "XRose")
+        else {
+            Issue.record("Could not find test file")
+            throw SQLiteError.failedToOpen
+        }
+        return path
+    }
+
+    private func temporaryPath() -> String {
+        FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString)
+            .appendingPathExtension("XRose")
+            .path
+    }
+
+    /// Copies the sample document to a temporary file and loads it
+    private func loadedStore() throws -> (store: InMemoryStore, path: String) {
+        let path = temporaryPath()
+        try FileManager.default.copyItem(atPath: sampleFilePath(), toPath: path)
+        let store = try InMemoryStore(interface: SQLiteInterface())
+        try store.load(from: path)
+        return (store, path)
+    }
+
+    private func fileSize(_ path: String) throws -> Int {
+        let attributes = try FileManager.default.attributesOfItem(atPath: path)
+        return try #require(attributes[.size] as? Int)
+    }
+
+    private func reload(_ path: String) throws -> InMemoryStore {
+        let store = try InMemoryStore(interface: SQLiteInterface())
+        try store.load(from: path)
+        return store
+    }
+
+    @Test("Given a new file, when saving, then the whole store is copied")
+    func firstSaveIsFull() throws {
+        let (store, _) = try loadedStore()
+        let path = temporaryPath()
+        defer { try? FileManager.default.removeItem(atPath: path) }
+
+        try store.save(to: path)
+
+        let report = try #require(store.lastSaveReport)
+        #expect(report.mode == .full)
+        #expect(try report.bytesWritten == fileSize(path))
+    }
+
+    @Test("Given a loaded document, when saving changed layers back to it, then only changed tables and rows are written")
+    func incrementalLayerSave() throws {
+        let (store, path) = try loadedStore()
+        defer { try? FileManager.default.removeItem(atPath: path) }
+        let layers: [XRLayer] = [XRLayerGrid.stub(), XRLayerCore.stub(), XRLayerText.stub()]
+
+        try store.store(layers: layers)
+        try store.save(to: path)
+        let first = try #require(store.lastSaveReport)
+        #expect(first.mode == .incremental)
+        #expect(first.tablesWritten.contains(Layer.tableName))
+        #expect(!first.tablesWritten.contains("rtest"))
+
+        layers[1].setLayerName("Moved")
+        try store.store(layers: layers)
+        try store.save(to: path)
+
+        let second = try #require(store.lastSaveReport)
+        #expect(second.mode == .incremental)
+        #expect(second.tablesWritten.isEmpty)
+        #expect(second.rowsWritten == 1)
+        #expect(try second.bytesWritten < fileSize(path))
+        let reloaded = try reload(path)
+        let storedLayers: [Layer] = try reloaded.interface.executeCodableQuery(
+            sqlite: reloaded.sqlitePointer(),
+            query: Layer.storedValues()
+        )
+        #expect(storedLayers.map(\.LAYER_NAME) == layers.map { $0.layerName() })
+    }
+
+    @Test("Given unchanged layers, when saving again, then nothing is written")
+    func unchangedSave() throws {
+        let (store, path) = try loadedStore()
+        defer { try? FileManager.default.removeItem(atPath: path) }
+        let layers: [XRLayer] = [XRLayerGrid.stub(), XRLayerCore.stub()]
+        try store.store(layers: layers)
+        try store.save(to: path)
+
+        try store.store(layers: layers)
+        #expect(!store.hasUnsavedChanges)
+        try store.save(to: path)
+
+        let report = try #require(store.lastSaveReport)
+        #expect(report == .init(mode: .incremental, bytesWritten: 0, tablesWritten: [], rowsWritten: 0))
+    }
+
+    @Test("Given a dropped data table, when saving incrementally, then the file no longer has it")
+    func incrementalDrop() throws {
+        let (store, path) = try loadedStore()
+        defer { try? FileManager.default.removeItem(atPath: path) }
+
+        try store.drop(table: "rtest")
+        try store.save(to: path)
+
+        #expect(store.lastSaveReport?.mode == .incremental)
+        #expect(store.lastSaveReport?.tablesWritten == ["rtest"])
+        let reloaded = try reload(path)
+        #expect(try reloaded.tableNames(sqliteStore: reloaded.sqlitePointer()).isEmpty)
+    }
+
+    @Test("Given an imported table, when saving incrementally, then the file has the new table and its rows")
+    func incrementalImport() throws {
+        let (store, path) = try loadedStore()
+        defer { try? FileManager.default.removeItem(atPath: path) }
+
+        try store.createUserTable(
+            createSQL: "CREATE TABLE imported (azimuth REAL)",
+            insertSQL: "INSERT INTO imported (azimuth) VALUES (?)",
+            rows: [[Float(12)], [Float(24)], [Float(36)]]
+        )
+        try store.save(to: path)
+
+        #expect(store.lastSaveReport?.mode == .incremental)
+        #expect(store.lastSaveReport?.tablesWritten == ["imported"])
+        let reloaded = try reload(path)
+        let dataSet = DataSet(_id: 1, NAME: "Imported", TABLENAME: "imported", COLUMNNAME: "azimuth", PREDICATE: nil, COMMENTS: nil)
+        #expect(try reloaded.dataSetValues(for: dataSet) == [12, 24, 36])
+    }
+
+    @Test("Given a loaded document, when saving to a different file, then the whole store is copied")
+    func saveElsewhereIsFull() throws {
+        let (store, path) = try loadedStore()
+        let otherPath = temporaryPath()
+        defer {
+            try? FileManager.default.removeItem(atPath: path)
+            try? FileManager.default.removeItem(atPath: otherPath)
+        }
+
+        #expect(!store.canSaveIncrementally(to: otherPath))
+        try store.save(to: otherPath)
+
+        #expect(store.lastSaveReport?.mode == .full)
+        #expect(store.canSaveIncrementally(to: otherPath))
+        #expect(!store.canSaveIncrementally(to: path))
+    }
+}
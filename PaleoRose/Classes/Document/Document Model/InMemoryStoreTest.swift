@@ -284,4 +284,24 @@ struct InMemoryStoreTest {
         // swiftlint:disable:next line_length
         #expect(sqlStrings.contains("INSERT INTO _layerData (LAYERID,DATASET,PLOTTYPE,TOTALCOUNT,DOTRADIUS) VALUES (?,?,?,?,?);"))
     }
+
+    // MARK: - Schema Changes
+
+    @Test("Given a schema change, then cached statements are invalidated")
+    func schemaChangesInvalidateStatements() throws {
+        let expectedPointer = try assignSqlitePointerToInterface()
+        defer {
+            do {
+                try closePointer(pointer: expectedPointer)
+            } catch {
+                Issue.record("Failed to close pointer: \(error)")
+            }
+        }
+        let store = try InMemoryStore(interface: sqliteInterface)
+        try store.renameTable(from: "rtest", toName: "rtest2")
+        try store.addColumn(to: "rtest2", columnDefinition: "newColumn TEXT")
+        try store.drop(table: "rtest2")
+
+        #expect(sqliteInterface.invalidateStatementsCallCount == 3)
+    }
 }
@@ -42,8 +42,17 @@ class MockSqliteInterface: StoreProtocol {
     var executeCodableQueryResult: [Any] = []
     var executeQueryCalled = false
     var executeCodableQueryCalled = false
+    var readColumnResult: [Float] = []
+    var readColumnCalled = false
+    var readColumnCapturedName: String?
     var queryAccumulator: [QueryProtocol] = []
 
+    var executeEachSQL: [String] = []
+    var executeEachRows: [[Bindable?]] = []
+
+    var invalidateStatementsCallCount = 0
+    var pagesWrittenResult = 0
+
     var closeError: Error?
     var closeCalled = false
 
@@ -102,6 +111,42 @@ class MockSqliteInterface: StoreProtocol {
         return executeCodableQueryResult.compactMap { $0 as? T }
     }
 
+    func readColumn<T: BinaryFloatingPoint & LosslessStringConvertible>(
+        _ column: String,
+        as _: T.Type,
+        sqlite: OpaquePointer,
+        query: any QueryProtocol
+    ) throws -> [T] {
+        readColumnCalled = true
+        readColumnCapturedName = column
+        queryAccumulator.append(query)
+        if let queryError {
+            throw queryError
+        }
+        return readColumnResult.map { T($0) }
+    }
+
+    func executeEach(sqlite _: OpaquePointer, sql: String, nextRow: () throws -> [Bindable?]?) throws -> Int {
+        executeEachSQL.append(sql)
+        if let queryError {
+            throw queryError
+        }
+        var count = 0
+        while let row = try nextRow() {
+            executeEachRows.append(row)
+            count += 1
+        }
+        return count
+    }
+
+    func invalidateStatements(sqlite _: OpaquePointer) {
+        invalidateStatementsCallCount += 1
+    }
+
+    func pagesWritten(sqlite _: OpaquePointer, reset _: Bool) -> Int {
+        pagesWrittenResult
+    }
+
     func close(store _: OpaquePointer) throws {
         closeCalled = true
         if let closeError {
@@ -121,6 +166,10 @@ class MockSqliteInterface: StoreProtocol {
         return pointer
     }
 
+    func openReadOnlyDatabase(path: String) throws -> OpaquePointer {
+        try openDatabase(path: path)
+    }
+
     func backup(source: OpaquePointer, destination: OpaquePointer) throws {
         backupCalled = true
     }
@@ -38,6 +38,8 @@ struct DataSet: TableRepresentable, Equatable {
     var COLUMNNAME: String?
     var PREDICATE: String?
     var COMMENTS: String? // Base 64 encoded
+    /// `XRDataSetAngleStorage` raw value; nil in documents saved before the column was added
+    var ANGLESTORAGE: Int?
 
     // MARK: - TableRepresentable
 
@@ -48,7 +50,7 @@ struct DataSet: TableRepresentable, Equatable {
 
     static func createTableQuery() -> any QueryProtocol {
         // swiftlint:disable:next line_length
-        Query(sql: "CREATE TABLE IF NOT EXISTS _datasets ( _id INTEGER PRIMARY KEY, NAME TEXT, TABLENAME TEXT, COLUMNNAME text, PREDICATE text, COMMENTS BLOB)")
+        Query(sql: "CREATE TABLE IF NOT EXISTS _datasets ( _id INTEGER PRIMARY KEY, NAME TEXT, TABLENAME TEXT, COLUMNNAME text, PREDICATE text, COMMENTS BLOB, ANGLESTORAGE INTEGER)")
     }
 
     static func insertQuery() -> any QueryProtocol {
@@ -62,6 +64,21 @@ struct DataSet: TableRepresentable, Equatable {
         Query(sql: "")
     }
 
+    /// Added to `_datasets` tables created before compact angle storage
+    static let angleStorageColumnDefinition = "ANGLESTORAGE INTEGER"
+
+    static func updateAngleStorageQuery(_ storage: XRDataSetAngleStorage, id: Int32) -> any QueryProtocol {
+        Query(
+            sql: "UPDATE _datasets SET ANGLESTORAGE = ? WHERE _id = ?;",
+            bindings: [[Int(storage.rawValue), id]]
+        )
+    }
+
+    /// The storage recorded for the data set, float when none was
+    var angleStorage: XRDataSetAngleStorage {
+        ANGLESTORAGE.flatMap { XRDataSetAngleStorage(rawValue: Int32($0)) } ?? .float
+    }
+
     static func deleteQuery() -> any QueryProtocol {
         Query(sql: "")
     }
@@ -89,11 +106,16 @@ struct DataSet: TableRepresentable, Equatable {
         COMMENTS = rtfData.base64EncodedString()
     }
 
-    func dataQuery() -> any QueryProtocol {
-        guard let tableName = TABLENAME else {
-            return Query(sql: "")
+    /// Selects only the value column, with the predicate's literals bound as parameters
+    /// - Parameter orderedByRowID: False if the data set's table is a view or has no rowid
+    func dataQuery(orderedByRowID: Bool = true) -> any QueryProtocol {
+        compiledQuery()?.query(orderedByRowID: orderedByRowID) ?? Query(sql: "")
+    }
+
+    func compiledQuery() -> DataSetQuery? {
+        guard let tableName = TABLENAME, let columnName = COLUMNNAME else {
+            return nil
         }
-        let predicate = PREDICATE ?? ""
-        return Query(sql: "SELECT * from \(tableName) \(predicate.isEmpty ? "" : "WHERE \(predicate)")")
+        return DataSetQuery(table: tableName, column: columnName, predicate: PREDICATE ?? "")
     }
 }
@@ -0,0 +1,352 @@
+//
+// DataSetQuery.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import CodableSQLiteNonThread
+import Foundation
+
+/// Compiles a data set's table, value column and predicate into a single-column, parameterized query
+///
+/// Literals in the predicate are lifted out into bindings, so data sets that differ only in their
+/// constants share one prepared statement. Predicates the tokenizer does not understand, such as
+/// function calls or subqueries, are kept verbatim and only the column list is narrowed.
+///
+/// Values are read in `rowid` order, so a covering index on the table does not reorder them.
+/// A verbatim predicate is the user's own SQL and may carry its own ordering, so it is left as written,
+/// and views and WITHOUT ROWID tables have no rowid to order by.
+struct DataSetQuery {
+    let table: String
+    let column: String
+    let predicate: String
+
+    /// The statement text, with `?` in place of each predicate literal
+    var sql: String {
+        query().sql
+    }
+
+    /// Values for the `?` placeholders, in order
+    let bindings: [Bindable?]
+    /// Columns the predicate refers to, in first-use order, or empty if it was not compiled
+    private(set) var predicateColumns: [String]
+    /// True unless the predicate had to be used verbatim
+    let isParameterized: Bool
+    /// Empty, or the compiled predicate with a leading ` WHERE `
+    private let whereClause: String
+
+    init(table: String, column: String, predicate: String = "") {
+        self.table = table
+        self.column = column
+        self.predicate = predicate
+
+        let trimmed = predicate.trimmingCharacters(in: .whitespacesAndNewlines)
+        if trimmed.isEmpty {
+            whereClause = ""
+            bindings = []
+            predicateColumns = []
+            isParameterized = true
+        } else if let compiled = PredicateCompiler(trimmed).compile() {
+            whereClause = " WHERE \(compiled.sql)"
+            bindings = compiled.bindings
+            predicateColumns = compiled.columns
+            isParameterized = true
+        } else {
+            whereClause = " WHERE \(trimmed)"
+            bindings = []
+            predicateColumns = []
+            isParameterized = false
+        }
+    }
+
+    /// - Parameter orderedByRowID: False for a table without a rowid, see `StoreProtocol.hasRowID`
+    func query(orderedByRowID: Bool = true) -> Query {
+        let selected = query(selecting: Self.quoted(column))
+        guard isParameterized, orderedByRowID else {
+            return selected
+        }
+        return Query(sql: selected.sql + " ORDER BY rowid", bindings: selected.bindings)
+    }
+
+    /// The same rows, in no particular order, with another result expression, such as an aggregate
+    /// of the value column
+    /// - Parameters:
+    /// - expression: The result column list
+    /// - leading: Values for placeholders in `expression`, which come before the predicate's
+    func query(selecting expression: String, bindings leading: [Bindable?] = []) -> Query {
+        let all = leading + bindings
+        return Query(
+            sql: "SELECT \(expression) FROM \(Self.quoted(table))\(whereClause)",
+            bindings: all.isEmpty ? [] : [all]
+        )
+    }
+
+    /// Columns of the covering index: the predicate columns followed by the value column
+    var indexColumns: [String] {
+        predicateColumns.contains(column) ? predicateColumns : predicateColumns + [column]
+    }
+
+    var coveringIndexName: String {
+        "_dataset_\(table)_\(indexColumns.joined(separator: "_"))"
+    }
+
+    /// The same query with only those predicate columns that are columns of the table
+    ///
+    /// A double-quoted word that names no column is a string literal to SQLite, as in `unit = "Kb"`,
+    /// and must not be indexed.
+    /// - Parameter tableColumns: The names of the table's columns
+    func restricted(to tableColumns: [String]) -> DataSetQuery {
+        let names = Set(tableColumns.map { $0.lowercased() })
+        var restricted = self
+        restricted.predicateColumns = predicateColumns.filter { names.contains($0.lowercased()) }
+        return restricted
+    }
+
+    /// An index that answers the query without touching the table, or nil if there is nothing to index
+    func coveringIndexQuery() -> Query? {
+        guard !predicateColumns.isEmpty else {
+            return nil
+        }
+        let columns = indexColumns.map(Self.quoted).joined(separator: ", ")
+        return Query(
+            sql: "CREATE INDEX IF NOT EXISTS \(Self.quoted(coveringIndexName)) ON \(Self.quoted(table)) (\(columns))"
+        )
+    }
+
+    static func quoted(_ identifier: String) -> String {
+        "\"\(identifier.replacingOccurrences(of: "\"", with: "\"\""))\""
+    }
+}
+
+extension StoreProtocol {
+    /// True if `table` is an ordinary table with a rowid
+    ///
+    /// Views are excluded outright, since newer SQLite builds no longer give them a rowid, and a
+    /// WITHOUT ROWID table is recognised by failing to select one.
+    func hasRowID(table: String, sqlite: OpaquePointer) -> Bool {
+        let type = Query(sql: "SELECT type FROM sqlite_master WHERE name = ?", bindings: [[table]])
+        guard (try? executeQuery(sqlite: sqlite, query: type))?.first?["type"] as? String == "table" else {
+            return false
+        }
+        let probe = Query(sql: "SELECT rowid FROM \(DataSetQuery.quoted(table)) LIMIT 0")
+        return (try? executeQuery(sqlite: sqlite, query: probe)) != nil
+    }
+}
+
+// MARK: - Predicate Compiler
+
+private struct PredicateCompiler {
+    struct Output {
+        var sql: String
+        var bindings: [Bindable?]
+        var columns: [String]
+    }
+
+    /// Keywords that may appear between operands of a simple predicate
+    private static let keywords: Set<String> = [
+        "AND", "OR", "NOT", "IS", "NULL", "ISNULL", "NOTNULL", "LIKE", "GLOB", "IN", "BETWEEN", "ESCAPE", "TRUE",
+        "FALSE"
+    ]
+    /// Keywords that introduce syntax the compiler does not model
+    private static let unsupported: Set<String> = [
+        "SELECT", "FROM", "WHERE", "CASE", "WHEN", "THEN", "ELSE", "END", "CAST", "COLLATE", "EXISTS", "MATCH",
+        "REGEXP", "ORDER", "BY", "GROUP", "HAVING", "LIMIT", "OFFSET", "UNION", "EXCEPT", "INTERSECT", "JOIN", "ON",
+        "AS", "DISTINCT", "ALL"
+    ]
+    /// Longer operators come first so `<=` is not read as `<` followed by `=`
+    private static let operators = [
+        "<=", ">=", "==", "!=", "<>", "||", "=", "<", ">", "+", "-", "*", "/", "%", "(", ")", ","
+    ]
+
+    private let scalars: [Unicode.Scalar]
+    private var position = 0
+
+    init(_ predicate: String) {
+        scalars = Array(predicate.unicodeScalars)
+    }
+
+    mutating func compile() -> Output? {
+        var tokens = [String]()
+        var output = Output(sql: "", bindings: [], columns: [])
+        while let scalar = nextScalar() {
+            switch scalar {
+            case "'":
+                guard let text = delimited(by: "'") else {
+                    return nil
+                }
+                tokens.append("?")
+                output.bindings.append(text)
+
+            case "\"", "`":
+                guard let name = delimited(by: scalar) else {
+                    return nil
+                }
+                tokens.append(DataSetQuery.quoted(name))
+                record(column: name, in: &output)
+
+            case "[":
+                guard let name = delimited(by: "[", closing: "]") else {
+                    return nil
+                }
+                tokens.append(DataSetQuery.quoted(name))
+                record(column: name, in: &output)
+
+            case "0" ... "9", ".":
+                guard let number = number() else {
+                    return nil
+                }
+                tokens.append("?")
+                output.bindings.append(number)
+
+            case "A" ... "Z", "a" ... "z", "_":
+                let word = identifier()
+                let upper = word.uppercased()
+                if Self.keywords.contains(upper) {
+                    tokens.append(upper)
+                } else if Self.unsupported.contains(upper) || nextNonWhitespace() == "(" {
+                    return nil
+                } else {
+                    tokens.append(word)
+                    record(column: word, in: &output)
+                }
+
+            default:
+                guard let symbol = symbol() else {
+                    return nil
+                }
+                tokens.append(symbol)
+            }
+        }
+        output.sql = tokens.joined(separator: " ")
+        return output
+    }
+
+    // MARK: - Tokens
+
+    /// Skips whitespace and returns the first scalar of the next token
+    private mutating func nextScalar() -> Unicode.Scalar? {
+        while let scalar = peek(), CharacterSet.whitespacesAndNewlines.contains(scalar) {
+            position += 1
+        }
+        return peek()
+    }
+
+    private func peek(_ offset: Int = 0) -> Unicode.Scalar? {
+        position + offset < scalars.count ? scalars[position + offset] : nil
+    }
+
+    private func nextNonWhitespace() -> Unicode.Scalar? {
+        var index = position
+        while index < scalars.count, CharacterSet.whitespacesAndNewlines.contains(scalars[index]) {
+            index += 1
+        }
+        return index < scalars.count ? scalars[index] : nil
+    }
+
+    /// Reads a quoted run, where a doubled closing delimiter stands for one literal delimiter
+    private mutating func delimited(by opening: Unicode.Scalar, closing: Unicode.Scalar? = nil) -> String? {
+        let closing = closing ?? opening
+        var text = String.UnicodeScalarView()
+        position += 1
+        while let scalar = peek() {
+            position += 1
+            if scalar == closing {
+                guard closing == opening, peek() == closing else {
+                    return String(text)
+                }
+                position += 1
+            }
+            text.append(scalar)
+        }
+        return nil
+    }
+
+    private mutating func identifier() -> String {
+        var text = String.UnicodeScalarView()
+        while let scalar = peek(), scalar == "_" || CharacterSet.alphanumerics.contains(scalar) {
+            text.append(scalar)
+            position += 1
+        }
+        return String(text)
+    }
+
+    private mutating func number() -> Bindable? {
+        var text = ""
+        var isInteger = true
+        while let scalar = peek() {
+            switch scalar {
+            case "0" ... "9":
+                text.unicodeScalars.append(scalar)
+
+            case ".":
+                isInteger = false
+                text.unicodeScalars.append(scalar)
+
+            case "e", "E":
+                isInteger = false
+                text.unicodeScalars.append(scalar)
+                if let sign = peek(1), sign == "+" || sign == "-" {
+                    position += 1
+                    text.unicodeScalars.append(sign)
+                }
+
+            default:
+                // A letter straight after digits is hex or a malformed literal; leave it to SQLite
+                if scalar == "_" || CharacterSet.letters.contains(scalar) {
+                    return nil
+                }
+                return Self.literal(text, isInteger: isInteger)
+            }
+            position += 1
+        }
+        return Self.literal(text, isInteger: isInteger)
+    }
+
+    private static func literal(_ text: String, isInteger: Bool) -> Bindable? {
+        if isInteger, let value = Int(text) {
+            return value
+        }
+        return Double(text)
+    }
+
+    private mutating func symbol() -> String? {
+        for candidate in Self.operators where matches(candidate) {
+            position += candidate.unicodeScalars.count
+            return candidate
+        }
+        return nil
+    }
+
+    private func matches(_ candidate: String) -> Bool {
+        for (offset, scalar) in candidate.unicodeScalars.enumerated() where peek(offset) != scalar {
+            return false
+        }
+        return true
+    }
+
+    private func record(column: String, in output: inout Output) {
+        if !output.columns.contains(column) {
+            output.columns.append(column)
+        }
+    }
+}
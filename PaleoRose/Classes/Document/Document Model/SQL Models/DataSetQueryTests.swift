@@ -0,0 +1,267 @@
+//
+// DataSetQueryTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import CodableSQLiteNonThread
+import Foundation
+@testable import PaleoRose
+import Testing
+
+@Suite("DataSetQuery")
+struct DataSetQueryTests {
+
+    // MARK: - Compiling
+
+    @Test("Given no predicate, then select only the quoted value column")
+    func selectsValueColumn() {
+        let sut = DataSetQuery(table: "strikes", column: "Azimuth")
+
+        #expect(sut.sql == "SELECT \"Azimuth\" FROM \"strikes\" ORDER BY rowid")
+        #expect(sut.bindings.isEmpty)
+        #expect(sut.isParameterized)
+        #expect(sut.coveringIndexQuery() == nil)
+    }
+
+    @Test("Given a predicate with literals, then each literal becomes a binding")
+    func bindsLiterals() throws {
+        let predicate = "dip >= 30 AND unit = 'Kb''s' OR depth < -1.5e2"
+        let sut = DataSetQuery(table: "strikes", column: "Azimuth", predicate: predicate)
+
+        #expect(
+            sut.sql == "SELECT \"Azimuth\" FROM \"strikes\" WHERE dip >= ? AND unit = ? OR depth < - ? ORDER BY rowid"
+        )
+        #expect(sut.bindings.count == 3)
+        #expect(try #require(sut.bindings[0] as? Int) == 30)
+        #expect(try #require(sut.bindings[1] as? String) == "Kb's")
+        #expect(try #require(sut.bindings[2] as? Double) == 150)
+        #expect(sut.predicateColumns == ["dip", "unit", "depth"])
+    }
+
+    @Test("Given predicates that differ only in constants, then they share one statement")
+    func sharesStatementText() {
+        let first = DataSetQuery(table: "t", column: "v", predicate: "site IN (1, 2) AND v BETWEEN 0 AND 90")
+        let second = DataSetQuery(table: "t", column: "v", predicate: "site in (3,4) and v between 180 and 270")
+
+        #expect(first.sql == second.sql)
+        #expect(first.predicateColumns == ["site", "v"])
+    }
+
+    @Test("Given quoted identifiers, then they are requoted and recorded as columns")
+    func quotedIdentifiers() {
+        let predicate = "[Rock Unit] = 'A' AND `Site` IS NOT NULL"
+        let sut = DataSetQuery(table: "my \"table\"", column: "Dip Direction", predicate: predicate)
+
+        #expect(sut.sql == #"""
+        SELECT "Dip Direction" FROM "my ""table""" WHERE "Rock Unit" = ? AND "Site" IS NOT NULL ORDER BY rowid
+        """#)
+        #expect(sut.predicateColumns == ["Rock Unit", "Site"])
+    }
+
+    @Test(
+        "Given a predicate the compiler does not model, then it is used verbatim",
+        arguments: [
+            "abs(dip) > 10", "dip > 0x10", "site = ?", "t.dip > 1", "dip > 1; DROP TABLE t", "dip > 1 ORDER BY dip"
+        ]
+    )
+    func fallsBackToVerbatim(predicate: String) {
+        let sut = DataSetQuery(table: "t", column: "v", predicate: predicate)
+
+        #expect(sut.sql == "SELECT \"v\" FROM \"t\" WHERE \(predicate)")
+        #expect(sut.bindings.isEmpty)
+        #expect(!sut.isParameterized)
+        #expect(sut.coveringIndexQuery() == nil)
+    }
+
+    @Test("Given a data set without a table or column, then its query is empty")
+    func incompleteDataSet() {
+        let dataSet = DataSet(NAME: "set", TABLENAME: "t", COLUMNNAME: nil, PREDICATE: nil, COMMENTS: nil)
+
+        #expect(dataSet.compiledQuery() == nil)
+        #expect(dataSet.dataQuery().sql.isEmpty)
+    }
+
+    // MARK: - Reading
+
+    @Test("Given a compiled predicate, when reading the data set, then only matching values are returned")
+    func readsMatchingValues() throws {
+        let store = try InMemoryStore()
+        try createWideTable(in: store, rows: 200, extraColumns: 2)
+        let dataSet = wideDataSet(predicate: "site = 3 AND dip > 45.5")
+
+        let values = try store.dataSetValues(for: dataSet)
+
+        let expected = (0 ..< 200).filter { $0 % 10 == 3 && Double($0 % 90) > 45.5 }.map { Float($0 % 360) }
+        #expect(values == expected)
+    }
+
+    @Test("Given a covering index, then the query plan reads the index instead of the table")
+    func coveringIndexIsUsed() throws {
+        let store = try InMemoryStore()
+        try createWideTable(in: store, rows: 200, extraColumns: 50)
+        let dataSet = wideDataSet(predicate: "site = 3")
+        let query = try #require(dataSet.compiledQuery())
+        let database = try store.sqlitePointer()
+
+        #expect(try plan(of: query, store: store).contains { $0.hasPrefix("SCAN") })
+
+        #expect(try store.createCoveringIndex(for: dataSet))
+
+        let details = try plan(of: query, store: store)
+        #expect(details.contains { $0.contains("USING COVERING INDEX \(query.coveringIndexName)") })
+        #expect(try !store.tableNames(sqliteStore: database).contains(query.coveringIndexName))
+    }
+
+    @Test("Given a covering index, then values keep their table order")
+    func coveringIndexKeepsOrder() throws {
+        let store = try InMemoryStore()
+        try createWideTable(in: store, rows: 200, extraColumns: 2)
+        let filtered = wideDataSet(predicate: "dip > 45")
+        let unfiltered = wideDataSet(predicate: "")
+        let before = try [filtered, unfiltered].map(store.dataSetValues(for:))
+
+        #expect(try store.createCoveringIndex(for: filtered))
+
+        // The index orders by dip, and also covers the unfiltered read
+        #expect(try [filtered, unfiltered].map(store.dataSetValues(for:)) == before)
+    }
+
+    @Test("Given a double-quoted word that is not a column, then it is read as a string and not indexed")
+    func quotedStringIsNotIndexed() throws {
+        let store = try InMemoryStore()
+        try createWideTable(in: store, rows: 20, extraColumns: 1)
+        let dataSet = wideDataSet(predicate: #"site = 3 AND c0 != "none""#)
+        let query = try #require(dataSet.compiledQuery())
+        #expect(query.predicateColumns == ["site", "c0", "none"])
+
+        #expect(try store.createCoveringIndex(for: dataSet))
+
+        let indexed = query.restricted(to: ["azimuth", "dip", "site", "c0"])
+        let details = try plan(of: query, store: store)
+        #expect(details.contains { $0.contains("COVERING INDEX \(indexed.coveringIndexName)") })
+        #expect(try store.dataSetValues(for: dataSet) == [3, 13])
+    }
+
+    @Test("Given a view or a table without a rowid, then values are read without ordering by rowid")
+    func readsTablesWithoutRowID() throws {
+        let store = try InMemoryStore()
+        try createWideTable(in: store, rows: 20, extraColumns: 0)
+        let database = try store.sqlitePointer()
+        for sql in [
+            "CREATE VIEW wide_view AS SELECT azimuth, site FROM wide",
+            "CREATE TABLE wide_keyed (site INTEGER, azimuth REAL, PRIMARY KEY (site, azimuth)) WITHOUT ROWID",
+            "INSERT INTO wide_keyed SELECT site, azimuth FROM wide"
+        ] {
+            _ = try store.interface.executeQuery(sqlite: database, query: Query(sql: sql))
+        }
+
+        for table in ["wide_view", "wide_keyed"] {
+            let dataSet = DataSet(
+                NAME: "set", TABLENAME: table, COLUMNNAME: "azimuth", PREDICATE: "site = 3", COMMENTS: nil
+            )
+            #expect(!store.interface.hasRowID(table: table, sqlite: database))
+            #expect(try store.dataSetValues(for: dataSet) == [3, 13])
+        }
+        #expect(store.interface.hasRowID(table: "wide", sqlite: database))
+    }
+
+    @Test("Given a data set without a predicate, then no index is created")
+    func noIndexWithoutPredicate() throws {
+        let store = try InMemoryStore()
+        try createWideTable(in: store, rows: 10, extraColumns: 0)
+        let dataSet = wideDataSet(predicate: "")
+
+        #expect(try !store.createCoveringIndex(for: dataSet))
+    }
+
+    // MARK: - Benchmark
+
+    @Test(
+        "Benchmark: SELECT * versus a parameterized single-column query on a 60 column table",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkWideTable() throws {
+        let store = try InMemoryStore()
+        try createWideTable(in: store, rows: 200_000, extraColumns: 60)
+        let database = try store.sqlitePointer()
+        let predicate = "site = 3 AND dip > 20"
+        let wildcard = Query(sql: "SELECT * from wide WHERE \(predicate)")
+        let compiled = DataSetQuery(table: "wide", column: "azimuth", predicate: predicate)
+        let read = { (query: Query) in
+            try store.interface.readColumn("azimuth", as: Float.self, sqlite: database, query: query)
+        }
+
+        var expected = [Float]()
+        let before = try Benchmark.measure("SELECT * with literal predicate", iterations: 10) {
+            expected = try read(wildcard)
+        }
+        var values = [Float]()
+        let after = try Benchmark.measure("single column, bound predicate", iterations: 10) {
+            values = try read(compiled.query())
+        }
+        try store.createCoveringIndex(for: wideDataSet(predicate: predicate))
+        let indexed = try Benchmark.measure("single column, covering index", iterations: 10) {
+            values = try read(compiled.query())
+        }
+        print(
+            "[benchmark] SELECT * \(String(format: "%.4f", Benchmark.seconds(before))) s,",
+            "column \(String(format: "%.4f", Benchmark.seconds(after))) s,",
+            "covering index \(String(format: "%.4f", Benchmark.seconds(indexed))) s"
+        )
+        #expect(values == expected)
+    }
+
+    // MARK: - Helpers
+
+    private func wideDataSet(predicate: String) -> DataSet {
+        DataSet(NAME: "set", TABLENAME: "wide", COLUMNNAME: "azimuth", PREDICATE: predicate, COMMENTS: nil)
+    }
+
+    /// Creates `wide` with azimuth, dip and site columns followed by `extraColumns` text columns
+    private func createWideTable(in store: InMemoryStore, rows: Int, extraColumns: Int) throws {
+        let extras = (0 ..< extraColumns).map { "c\($0)" }
+        let columns = ["azimuth REAL", "dip REAL", "site INTEGER"] + extras.map { "\($0) TEXT" }
+        let placeholders = Array(repeating: "?", count: 3 + extraColumns).joined(separator: ", ")
+        let names = (["azimuth", "dip", "site"] + extras).joined(separator: ", ")
+        var row = 0
+        try store.createUserTable(
+            createSQL: "CREATE TABLE wide (_id INTEGER PRIMARY KEY, \(columns.joined(separator: ", ")))",
+            insertSQL: "INSERT INTO wide (\(names)) VALUES (\(placeholders))"
+        ) {
+            guard row < rows else {
+                return nil
+            }
+            defer { row += 1 }
+            let values: [Bindable?] = [Double(row % 360), Double(row % 90), row % 10]
+            return values + extras.map { "\($0)-\(row)-padding" }
+        }
+    }
+
+    private func plan(of query: DataSetQuery, store: InMemoryStore) throws -> [String] {
+        let explain = Query(sql: "EXPLAIN QUERY PLAN \(query.sql)", bindings: [query.bindings])
+        return try store.interface.executeQuery(sqlite: store.sqlitePointer(), query: explain)
+            .compactMap { $0["detail"] as? String }
+    }
+}
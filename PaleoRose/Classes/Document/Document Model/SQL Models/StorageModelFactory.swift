@@ -34,17 +34,68 @@ class StorageModelFactory {
         case invalidLayerIdentifiable
     }
 
-    var colors: [Color] = []
+    /// Colors in the order they were read or created, as they are written to `_colors`
+    private(set) var colors: [Color] = []
     let defaultStrokeColor: NSColor = .init(red: 0, green: 0, blue: 0, alpha: 1)
     let defaultFillColor: NSColor = .init(red: 1, green: 1, blue: 1, alpha: 1)
 
+    /// Device RGB components rounded to the nearest thousandth, the tolerance colors are matched with
+    private struct ColorKey: Hashable {
+        let red: Int32
+        let green: Int32
+        let blue: Int32
+        let alpha: Int32
+
+        init(red: Float, green: Float, blue: Float, alpha: Float) {
+            self.red = Int32((red * 1000).rounded())
+            self.green = Int32((green * 1000).rounded())
+            self.blue = Int32((blue * 1000).rounded())
+            self.alpha = Int32((alpha * 1000).rounded())
+        }
+
+        init(_ color: Color) {
+            self.init(red: color.RED, green: color.GREEN, blue: color.BLUE, alpha: color.ALPHA)
+        }
+    }
+
+    // Indexes over `colors`, kept in step with it; the first color with an ID or key wins, as
+    // the linear searches they replace did
+    private var colorsByID: [Int: NSColor] = [:]
+    private var colorIDsByKey: [ColorKey: Int] = [:]
+    /// IDs of colors already matched, so layers sharing a color convert it to device RGB once
+    private var colorIDsByColor: [NSColor: Int] = [:]
+    private var nextColorID = 1
+
     func set(colors: [Color]) {
         clearColors()
-        self.colors = colors
+        for color in colors {
+            add(color)
+        }
     }
 
     func clearColors() {
         colors.removeAll()
+        colorsByID.removeAll()
+        colorIDsByKey.removeAll()
+        colorIDsByColor.removeAll()
+        nextColorID = 1
+    }
+
+    private func add(_ color: Color) {
+        colors.append(color)
+        if colorsByID[color.COLORID] == nil {
+            colorsByID[color.COLORID] = NSColor(
+                red: CGFloat(color.RED),
+                green: CGFloat(color.GREEN),
+                blue: CGFloat(color.BLUE),
+                alpha: CGFloat(color.ALPHA)
+            )
+        }
+        let key = ColorKey(color)
+        if colorIDsByKey[key] == nil {
+            colorIDsByKey[key] = color.COLORID
+        }
+        nextColorID = max(nextColorID, color.COLORID + 1)
     }
 
     func strokeColor(id: Int) -> NSColor {
@@ -62,21 +113,16 @@ class StorageModelFactory {
     }
 
     func color(id: Int) -> NSColor? {
-        guard let color = colors.first(where: { $0.COLORID == id }) else {
-            return nil
-        }
-        return NSColor(
-            red: CGFloat(color.RED),
-            green: CGFloat(color.GREEN),
-            blue: CGFloat(color.BLUE),
-            alpha: CGFloat(color.ALPHA)
-        )
+        colorsByID[id]
     }
 
     /// Find the color ID for a given NSColor, or create a new color entry if not found
     /// - Parameter nsColor: The NSColor to find or create
     /// - Returns: The color ID for the given color
     func findOrCreateColorID(for nsColor: NSColor) -> Int {
+        if let colorID = colorIDsByColor[nsColor] {
+            return colorID
+        }
         // Convert NSColor to RGB components (use calibrated RGB color space)
         guard let rgbColor = nsColor.usingColorSpace(.deviceRGB) else {
             // If conversion fails, return 1 (black - default color)
@@ -88,33 +134,24 @@ class StorageModelFactory {
         let blue = Float(rgbColor.blueComponent)
         let alpha = Float(rgbColor.alphaComponent)
 
-        // Try to find an existing color with the same components
-        // Use a small epsilon for floating point comparison
-        let epsilon: Float = 0.001
-        if
-            let existingColor = colors.first(where: { color in
-                abs(color.RED - red) < epsilon &&
-                    abs(color.GREEN - green) < epsilon &&
-                    abs(color.BLUE - blue) < epsilon &&
-                    abs(color.ALPHA - alpha) < epsilon
-            }) {
-            return existingColor.COLORID
+        // Colors within a thousandth in every component share an entry
+        let key = ColorKey(red: red, green: green, blue: blue, alpha: alpha)
+        let colorID: Int
+        if let existingID = colorIDsByKey[key] {
+            colorID = existingID
+        } else {
+            // Color not found - create a new one with the next available color ID
+            colorID = nextColorID
+            add(Color(
+                COLORID: colorID,
+                RED: red,
+                BLUE: blue,
+                GREEN: green,
+                ALPHA: alpha
+            ))
         }
-
-        // Color not found - create a new one
-        // Find the next available color ID
-        let nextID = (colors.map(\.COLORID).max() ?? 0) + 1
-
-        let newColor = Color(
-            COLORID: nextID,
-            RED: red,
-            BLUE: blue,
-            GREEN: green,
-            ALPHA: alpha
-        )
-        colors.append(newColor)
-
-        return nextID
+        colorIDsByColor[nsColor] = colorID
+        return colorID
     }
 
     // MARK: - Create Storage Layers
@@ -247,6 +284,20 @@ class StorageModelFactory {
         )
     }
 
+    func configure(_ geometryController: XRGeometryController, from geometry: Geometry) {
+        geometryController.configureIsEqualArea(
+            geometry.isEqualArea,
+            isPercent: geometry.isPercent,
+            maxCount: Int32(geometry.MAXCOUNT),
+            maxPercent: geometry.MAXPERCENT,
+            hollowCore: geometry.HOLLOWCORE,
+            sectorSize: geometry.SECTORSIZE,
+            startingAngle: geometry.STARTINGANGLE,
+            sectorCount: Int32(geometry.SECTORCOUNT),
+            relativeSize: geometry.RELATIVESIZE
+        )
+    }
+
     // MARK: - Create XRLayer Types
 
     func createXRLayer(baseLayer: Layer, targetLayer: LayerIdentifiable) throws -> XRLayer {
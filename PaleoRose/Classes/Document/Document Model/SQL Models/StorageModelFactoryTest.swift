@@ -24,6 +24,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+import AppKit
 @testable import PaleoRose
 import Testing
 
@@ -90,6 +91,37 @@ struct StorageModelFactoryTest {
         #expect(textLayer.compare(with: original, id: location))
     }
 
+    // MARK: - Colors
+
+    @Test("Given loaded colors, then matching colors reuse their IDs and new colors follow the highest ID")
+    func colorInterning() {
+        sut.set(colors: [
+            Color(COLORID: 3, RED: 1, BLUE: 0, GREEN: 0, ALPHA: 1),
+            Color(COLORID: 7, RED: 0, BLUE: 1, GREEN: 0, ALPHA: 1)
+        ])
+
+        #expect(sut.findOrCreateColorID(for: NSColor(deviceRed: 1, green: 0, blue: 0, alpha: 1)) == 3)
+        #expect(sut.findOrCreateColorID(for: NSColor(deviceRed: 0.9999, green: 0.0002, blue: 0, alpha: 1)) == 3)
+        #expect(sut.findOrCreateColorID(for: NSColor(deviceRed: 0, green: 1, blue: 0, alpha: 1)) == 8)
+        #expect(sut.findOrCreateColorID(for: NSColor(deviceRed: 0, green: 1, blue: 0, alpha: 1)) == 8)
+        #expect(sut.colors.map(\.COLORID) == [3, 7, 8])
+    }
+
+    @Test("Given colors sharing an ID, then the first is returned for it")
+    func colorLookupByID() throws {
+        sut.set(colors: [
+            Color(COLORID: 2, RED: 0.25, BLUE: 0.5, GREEN: 0.75, ALPHA: 1),
+            Color(COLORID: 2, RED: 1, BLUE: 1, GREEN: 1, ALPHA: 1)
+        ])
+
+        let color = try #require(sut.color(id: 2))
+        #expect(color.redComponent == 0.25)
+        #expect(color.greenComponent == 0.75)
+        #expect(color.blueComponent == 0.5)
+        #expect(sut.color(id: 5) == nil)
+        #expect(sut.fillColor(id: 5) == sut.defaultFillColor)
+    }
+
     // MARK: - XRLayer Type Creation
 
     @Test("Given a layer and layertext, then correctly create XRLayerText")
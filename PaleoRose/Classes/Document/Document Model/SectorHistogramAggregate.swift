@@ -0,0 +1,182 @@
+//
+// SectorHistogramAggregate.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import CodableSQLiteNonThread
+import Foundation
+import SQLite3
+
+/// `sector_histogram(value, startAngle, sectorSize, sectorCount, biDirectional)`, an SQLite aggregate
+/// that counts a data set column into rose diagram sectors without returning its values
+///
+/// Values are converted as `readColumn` converts them and counted by XRSectorHistogram in batches,
+/// so the counts are the same as those of the values read into memory. The result is a blob of
+/// `sectorCount` Int32 counts, or NULL when no rows matched.
+enum SectorHistogramAggregate {
+    static let name = "sector_histogram"
+
+    /// Values handed to XRSectorHistogram at a time
+    private static let batchSize = 4096
+    private static let transient = unsafeBitCast(-1, to: sqlite3_destructor_type.self)
+
+    private struct Row: Codable {
+        var counts: Data?
+    }
+
+    /// Counts the data set's values inside SQLite, so only the sector counts are returned
+    static func histogram(
+        of set: DataSet,
+        startAngle: Float,
+        sectorSize: Float,
+        sectorCount: Int32,
+        biDirectional: Bool,
+        interface: StoreProtocol,
+        sqlite: OpaquePointer
+    ) throws -> XRSectorHistogram {
+        guard let compiled = set.compiledQuery() else {
+            throw SQLiteError.columnNotFound(set.COLUMNNAME ?? "")
+        }
+        try register(on: sqlite)
+        let query = compiled.query(
+            selecting: "\(name)(\(DataSetQuery.quoted(compiled.column)), ?, ?, ?, ?) AS counts",
+            bindings: [Double(startAngle), Double(sectorSize), Int(sectorCount), biDirectional ? 1 : 0]
+        )
+        let rows: [Row] = try interface.executeCodableQuery(sqlite: sqlite, query: query)
+        var counts = [Int32](repeating: 0, count: max(Int(sectorCount), 0))
+        if let blob = rows.first?.counts, blob.count == counts.count * MemoryLayout<Int32>.stride {
+            counts.withUnsafeMutableBytes { _ = blob.copyBytes(to: $0) }
+        }
+        return counts.withUnsafeBufferPointer { buffer -> XRSectorHistogram in
+            XRSectorHistogram(
+                counts: buffer.baseAddress,
+                startAngle: startAngle,
+                sectorSize: sectorSize,
+                sectorCount: sectorCount,
+                biDirectional: biDirectional
+            )
+        }
+    }
+
+    static func register(on sqlite: OpaquePointer) throws {
+        let status = sqlite3_create_function_v2(
+            sqlite,
+            name,
+            5,
+            SQLITE_UTF8 | SQLITE_DETERMINISTIC,
+            nil,
+            nil,
+            { context, _, arguments in SectorHistogramAggregate.step(context, arguments: arguments) },
+            { context in SectorHistogramAggregate.finish(context) },
+            nil
+        )
+        try SQLiteError.checkSqliteStatus(status)
+    }
+
+    // MARK: - Aggregate Callbacks
+
+    private final class Accumulator {
+        let histogram: XRSectorHistogram
+        private var pending = [Float]()
+
+        init(histogram: XRSectorHistogram) {
+            self.histogram = histogram
+            pending.reserveCapacity(SectorHistogramAggregate.batchSize)
+        }
+
+        func append(_ value: Float) {
+            pending.append(value)
+            if pending.count == SectorHistogramAggregate.batchSize {
+                flush()
+            }
+        }
+
+        func flush() {
+            pending.withUnsafeBufferPointer { histogram.addValues($0.baseAddress, count: UInt($0.count)) }
+            pending.removeAll(keepingCapacity: true)
+        }
+    }
+
+    private static func step(_ context: OpaquePointer?, arguments: UnsafeMutablePointer<OpaquePointer?>?) {
+        guard let arguments, let accumulator = accumulator(context, arguments: arguments) else {
+            return
+        }
+        let value = arguments[0]
+        switch sqlite3_value_type(value) {
+        case SQLITE_INTEGER, SQLITE_FLOAT:
+            accumulator.append(Float(sqlite3_value_double(value)))
+
+        case SQLITE_TEXT:
+            if let text = sqlite3_value_text(value), let parsed = Float(String(cString: text)) {
+                accumulator.append(parsed)
+            }
+
+        default:
+            break
+        }
+    }
+
+    private static func finish(_ context: OpaquePointer?) {
+        guard let slot = slot(context, allocating: false), let pointer = slot.pointee else {
+            sqlite3_result_null(context)
+            return
+        }
+        slot.pointee = nil
+        let accumulator = Unmanaged<Accumulator>.fromOpaque(pointer).takeRetainedValue()
+        accumulator.flush()
+        let histogram = accumulator.histogram
+        let bytes = Int32(MemoryLayout<Int32>.stride * Int(histogram.sectorCount))
+        sqlite3_result_blob(context, histogram.counts(), bytes, transient)
+    }
+
+    /// The accumulator kept in the aggregate context, created from the geometry arguments on the first row
+    private static func accumulator(
+        _ context: OpaquePointer?,
+        arguments: UnsafeMutablePointer<OpaquePointer?>
+    ) -> Accumulator? {
+        guard let slot = slot(context, allocating: true) else {
+            return nil
+        }
+        if let existing = slot.pointee {
+            return Unmanaged<Accumulator>.fromOpaque(existing).takeUnretainedValue()
+        }
+        let histogram = XRSectorHistogram(
+            values: nil,
+            count: 0,
+            startAngle: Float(sqlite3_value_double(arguments[1])),
+            sectorSize: Float(sqlite3_value_double(arguments[2])),
+            sectorCount: sqlite3_value_int(arguments[3]),
+            biDirectional: sqlite3_value_int(arguments[4]) != 0
+        )
+        let accumulator = Accumulator(histogram: histogram)
+        slot.pointee = Unmanaged.passRetained(accumulator).toOpaque()
+        return accumulator
+    }
+
+    /// SQLite zeroes the context when it is first allocated, and returns nil before then when not allocating
+    private static func slot(_ context: OpaquePointer?, allocating: Bool) -> UnsafeMutablePointer<UnsafeMutableRawPointer?>? {
+        let size = allocating ? Int32(MemoryLayout<UnsafeMutableRawPointer?>.size) : 0
+        return sqlite3_aggregate_context(context, size)?.assumingMemoryBound(to: UnsafeMutableRawPointer?.self)
+    }
+}
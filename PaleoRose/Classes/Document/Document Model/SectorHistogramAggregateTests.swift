@@ -0,0 +1,278 @@
+//
+// SectorHistogramAggregateTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import CodableSQLiteNonThread
+import Foundation
+@testable import PaleoRose
+import Testing
+
+struct SectorHistogramAggregateTests {
+
+    // MARK: - Test Setup
+
+    /// Deterministic geometries and values, so a failing case can be reproduced
+    private struct SplitMix64: RandomNumberGenerator {
+        var state: UInt64
+
+        mutating func next() -> UInt64 {
+            state &+= 0x9E37_79B9_7F4A_7C15
+            var value = state
+            value = (value ^ (value >> 30)) &* 0xBF58_476D_1CE4_E5B9
+            value = (value ^ (value >> 27)) &* 0x94D0_49BB_1331_11EB
+            return value ^ (value >> 31)
+        }
+    }
+
+    private struct Geometry {
+        let startAngle: Float
+        let sectorSize: Float
+        let sectorCount: Int32
+        let biDir: Bool
+
+        static func random(using generator: inout SplitMix64) -> Geometry {
+            let sectorCount = Int32.random(in: 1 ... 120, using: &generator)
+            // Mostly sectors that tile the circle, sometimes ones that overlap or leave gaps
+            let sectorSize = Bool.random(using: &generator)
+                ? 360.0 / Float(sectorCount)
+                : Float(Int.random(in: 1 ... 720, using: &generator)) / 8.0
+            let startAngle = Bool.random(using: &generator)
+                ? Float(Int.random(in: 0 ..< 1440, using: &generator)) / 4.0
+                : Float.random(in: 0 ..< 360, using: &generator)
+            return Geometry(
+                startAngle: startAngle,
+                sectorSize: sectorSize,
+                sectorCount: sectorCount,
+                biDir: Bool.random(using: &generator)
+            )
+        }
+    }
+
+    /// Random azimuths, values on quarter-degree boundaries, out of range values, numeric text and NULLs
+    private func createSamples(in store: InMemoryStore, rows: Int, seed: UInt64) throws {
+        var generator = SplitMix64(state: seed)
+        var row = 0
+        try store.createUserTable(
+            createSQL: "CREATE TABLE samples (_id INTEGER PRIMARY KEY, azimuth, site INTEGER)",
+            insertSQL: "INSERT INTO samples (azimuth, site) VALUES (?, ?)"
+        ) {
+            guard row < rows else {
+                return nil
+            }
+            defer { row += 1 }
+            let azimuth: Bindable?
+            switch row % 10 {
+            case 0:
+                azimuth = Double(Int.random(in: 0 ... 1440, using: &generator)) / 4.0
+            case 1:
+                azimuth = Double.random(in: -360 ..< 720, using: &generator)
+            case 2:
+                azimuth = String(Float.random(in: 0 ..< 360, using: &generator))
+            case 3:
+                azimuth = row % 30 == 3 ? nil : Int.random(in: 0 ..< 360, using: &generator)
+            default:
+                azimuth = Double(Float.random(in: 0 ..< 360, using: &generator))
+            }
+            return [azimuth, row % 10]
+        }
+    }
+
+    private func dataSet(predicate: String = "") -> DataSet {
+        DataSet(NAME: "Samples", TABLENAME: "samples", COLUMNNAME: "azimuth", PREDICATE: predicate, COMMENTS: nil)
+    }
+
+    private func storeHistogram(_ set: DataSet, _ geometry: Geometry, store: InMemoryStore) throws -> XRSectorHistogram {
+        try SectorHistogramAggregate.histogram(
+            of: set,
+            startAngle: geometry.startAngle,
+            sectorSize: geometry.sectorSize,
+            sectorCount: geometry.sectorCount,
+            biDirectional: geometry.biDir,
+            interface: store.interface,
+            sqlite: store.sqlitePointer()
+        )
+    }
+
+    private func memoryHistogram(_ values: [Float], _ geometry: Geometry) throws -> XRSectorHistogram {
+        try #require(XRSectorHistogram(
+            values: values,
+            count: UInt(values.count),
+            startAngle: geometry.startAngle,
+            sectorSize: geometry.sectorSize,
+            sectorCount: geometry.sectorCount,
+            biDirectional: geometry.biDir
+        ))
+    }
+
+    private func counts(_ histogram: XRSectorHistogram) -> [Int32] {
+        Array(UnsafeBufferPointer(start: histogram.counts(), count: Int(histogram.sectorCount)))
+    }
+
+    // MARK: - Exactness
+
+    @Test("Given random geometries, then counts from SQLite match counts of the values read into memory")
+    func matchesInMemoryCounts() throws {
+        let store = try InMemoryStore()
+        try createSamples(in: store, rows: 5000, seed: 20)
+        var generator = SplitMix64(state: 2024)
+
+        for predicate in ["", "site < 7 AND azimuth >= 0"] {
+            let set = dataSet(predicate: predicate)
+            let values = try store.dataSetValues(for: set)
+            for _ in 0 ..< 100 {
+                let geometry = Geometry.random(using: &generator)
+                let expected = try memoryHistogram(values, geometry)
+
+                let histogram = try storeHistogram(set, geometry, store: store)
+
+                #expect(counts(histogram) == counts(expected), "\(geometry) \(predicate)")
+                #expect(histogram.totalCount == expected.totalCount)
+                #expect(histogram.maxCount == expected.maxCount)
+                #expect(histogram.matchesStartAngle(
+                    geometry.startAngle,
+                    sectorSize: geometry.sectorSize,
+                    sectorCount: geometry.sectorCount,
+                    biDirectional: geometry.biDir
+                ))
+            }
+        }
+    }
+
+    @Test("Given no matching rows, then every sector is empty")
+    func emptySelection() throws {
+        let store = try InMemoryStore()
+        try createSamples(in: store, rows: 100, seed: 3)
+        let geometry = Geometry(startAngle: 0, sectorSize: 10, sectorCount: 36, biDir: false)
+
+        let histogram = try storeHistogram(dataSet(predicate: "site > 100"), geometry, store: store)
+
+        #expect(counts(histogram) == Array(repeating: 0, count: 36))
+        #expect(histogram.totalCount == 0)
+    }
+
+    @Test("Given a counted histogram, when values are added, then they are counted as usual")
+    func histogramWithCountsAcceptsValues() throws {
+        let counts: [Int32] = [2, 0, 5, 1]
+        let histogram = try #require(counts.withUnsafeBufferPointer {
+            XRSectorHistogram(counts: $0.baseAddress, startAngle: 0, sectorSize: 90, sectorCount: 4, biDirectional: false)
+        })
+        #expect(histogram.totalCount == 8)
+        #expect(histogram.maxCount == 5)
+
+        let values: [Float] = [10, 100, 100, 350]
+        histogram.addValues(values, count: UInt(values.count))
+
+        #expect(self.counts(histogram) == [3, 2, 5, 2])
+        #expect(histogram.maxCount == 5)
+    }
+
+    // MARK: - Deferred Data Sets
+
+    @Test("Given a deferred data set, when counting sectors in the store, then its values are never read")
+    func deferredDataSetIsCountedInStore() throws {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let path = directory.appendingPathComponent("samples.XRose").path
+        let store = try InMemoryStore()
+        try createSamples(in: store, rows: 2000, seed: 7)
+        try store.save(to: path)
+        let document = try #require(ColumnValueCache.DocumentStamp(path: path))
+        let source = DeferredDataSetValues(
+            document: document,
+            interface: SQLiteInterface(),
+            columnCache: nil,
+            storeValues: store.dataSetValues(for:)
+        )
+        source.countsSectorsInStore = true
+        let deferred = source.makeDataSet(dataSet(predicate: "site = 4"))
+
+        let histogram = try #require(deferred.sectorHistogram(withStartAngle: 5, sectorSize: 10, sectorCount: 36, biDir: true))
+
+        #expect(!deferred.hasLoadedValues())
+        #expect(source.loadCount == 0)
+        #expect(source.storeHistogramCount == 1)
+        let values = try store.dataSetValues(for: dataSet(predicate: "site = 4"))
+        let geometry = Geometry(startAngle: 5, sectorSize: 10, sectorCount: 36, biDir: true)
+        #expect(try counts(histogram) == counts(memoryHistogram(values, geometry)))
+
+        // A second request is answered from the data set's cache
+        _ = deferred.sectorHistogram(withStartAngle: 5, sectorSize: 10, sectorCount: 36, biDir: true)
+        #expect(source.storeHistogramCount == 1)
+    }
+
+    @Test("Given a deferred summary, when the statistics description is read, then the summary is calculated")
+    func deferredSummaryIsCalculatedOnDemand() throws {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let path = directory.appendingPathComponent("samples.XRose").path
+        let store = try InMemoryStore()
+        try createSamples(in: store, rows: 500, seed: 11)
+        try store.save(to: path)
+        let document = try #require(ColumnValueCache.DocumentStamp(path: path))
+        let source = DeferredDataSetValues(
+            document: document,
+            interface: SQLiteInterface(),
+            columnCache: nil,
+            storeValues: store.dataSetValues(for:)
+        )
+        let deferred = source.makeDataSet(dataSet())
+        let values = try store.dataSetValues(for: dataSet())
+        let eager = try XRDataSet.stub(values: values, name: "Eager")
+        _ = eager.calculateCircularSummary(forBiDir: false, startAngle: 0, sectorSize: 10)
+
+        deferred.deferCircularSummary(forBiDir: false, startAngle: 0, sectorSize: 10)
+        #expect(!deferred.hasLoadedValues())
+
+        #expect(deferred.statisticsDescription() == eager.statisticsDescription())
+        #expect(deferred.circularSummary().count == eager.circularSummary().count)
+    }
+
+    @Test("Given a source that does not count in the store, then the values are read")
+    func storeCountingIsOptional() throws {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let path = directory.appendingPathComponent("samples.XRose").path
+        let store = try InMemoryStore()
+        try createSamples(in: store, rows: 200, seed: 9)
+        try store.save(to: path)
+        let document = try #require(ColumnValueCache.DocumentStamp(path: path))
+        let source = DeferredDataSetValues(
+            document: document,
+            interface: SQLiteInterface(),
+            columnCache: nil,
+            storeValues: store.dataSetValues(for:)
+        )
+        let deferred = source.makeDataSet(dataSet())
+
+        _ = deferred.sectorHistogram(withStartAngle: 0, sectorSize: 10, sectorCount: 36, biDir: false)
+
+        #expect(deferred.hasLoadedValues())
+        #expect(source.storeHistogramCount == 0)
+        #expect(source.loadCount == 1)
+    }
+}
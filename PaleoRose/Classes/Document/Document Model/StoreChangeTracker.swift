@@ -0,0 +1,140 @@
+//
+// StoreChangeTracker.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import Foundation
+
+/// Records what has changed in an `InMemoryStore` since it was last loaded from or saved to a file.
+///
+/// Tables are tracked by name and copied whole by an incremental save. Layer tables are also
+/// tracked per `LAYERID`: each stored row is kept as an encoded snapshot, and only rows whose
+/// encoding differs from the snapshot are marked for rewriting.
+struct StoreChangeTracker {
+    /// Rows to rewrite in one layer table
+    struct RowChanges: Equatable {
+        /// Rows that are new or whose content changed
+        var changed: Set<Int> = []
+        /// Rows that are no longer stored
+        var removed: Set<Int> = []
+
+        var isEmpty: Bool {
+            changed.isEmpty && removed.isEmpty
+        }
+    }
+
+    /// File the in-memory store last matched, or nil when it has never been loaded or saved
+    private(set) var baselinePath: String?
+
+    /// Tables whose contents changed and must be copied whole
+    private(set) var dirtyTables: Set<String> = []
+
+    /// Layer rows to rewrite, by table name
+    private(set) var dirtyRows: [String: RowChanges] = [:]
+
+    private var rowSnapshots: [String: [Int: Data]] = [:]
+    private var tableSnapshots: [String: Data] = [:]
+
+    var hasChanges: Bool {
+        !dirtyTables.isEmpty || dirtyRows.values.contains { !$0.isEmpty }
+    }
+
+    /// Whether the changes can be written into the file at `path` instead of replacing it
+    func canSaveIncrementally(to path: String) -> Bool {
+        guard let baselinePath else {
+            return false
+        }
+        return Self.standardized(baselinePath) == Self.standardized(path)
+    }
+
+    mutating func markTableDirty(_ name: String) {
+        dirtyTables.insert(name)
+        dirtyRows[name] = nil
+    }
+
+    /// Compares the encoded contents of a small table with what was last stored.
+    ///
+    /// - Returns: true, and marks the table dirty, when the contents changed
+    mutating func updateTable(_ name: String, contents: Data) -> Bool {
+        guard tableSnapshots[name] != contents else {
+            return false
+        }
+        tableSnapshots[name] = contents
+        markTableDirty(name)
+        return true
+    }
+
+    /// Compares the encoded rows of a layer table with the last stored rows.
+    ///
+    /// - Returns: The changed and removed rows, or nil when the table has no snapshot yet and
+    ///   must be rewritten whole. The table is marked dirty in that case.
+    mutating func updateRows(in table: String, rows: [Int: Data]) -> RowChanges? {
+        guard let snapshot = rowSnapshots[table] else {
+            rowSnapshots[table] = rows
+            markTableDirty(table)
+            return nil
+        }
+        var changes = RowChanges()
+        for (row, contents) in rows where snapshot[row] != contents {
+            changes.changed.insert(row)
+        }
+        changes.removed = Set(snapshot.keys).subtracting(rows.keys)
+        rowSnapshots[table] = rows
+        if !changes.isEmpty, !dirtyTables.contains(table) {
+            dirtyRows[table, default: RowChanges()].merge(changes)
+        }
+        return changes
+    }
+
+    /// Forgets the snapshots, for example after loading a different file into the store
+    mutating func reset(baselinePath path: String?) {
+        baselinePath = path
+        dirtyTables.removeAll()
+        dirtyRows.removeAll()
+        rowSnapshots.removeAll()
+        tableSnapshots.removeAll()
+    }
+
+    /// Clears the changes once they are in the file at `path`. Snapshots are kept.
+    mutating func markSaved(to path: String) {
+        baselinePath = path
+        dirtyTables.removeAll()
+        dirtyRows.removeAll()
+    }
+
+    private static func standardized(_ path: String) -> String {
+        URL(fileURLWithPath: path).standardizedFileURL.resolvingSymlinksInPath().path
+    }
+}
+
+extension StoreChangeTracker.RowChanges {
+    mutating func merge(_ other: Self) {
+        // A row removed and then stored again is a change; one changed and then removed is a removal
+        changed.subtract(other.removed)
+        removed.subtract(other.changed)
+        changed.formUnion(other.changed)
+        removed.formUnion(other.removed)
+    }
+}
@@ -0,0 +1,112 @@
+//
+// StoreChangeTrackerTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import Foundation
+@testable import PaleoRose
+import Testing
+
+struct StoreChangeTrackerTests {
+    private func rows(_ contents: [Int: String]) -> [Int: Data] {
+        contents.mapValues { Data($0.utf8) }
+    }
+
+    @Test("Given a table without a snapshot, when updating rows, then the whole table is dirty")
+    func firstUpdateMarksTableDirty() {
+        var sut = StoreChangeTracker()
+
+        let changes = sut.updateRows(in: "_layers", rows: rows([0: "grid", 1: "core"]))
+
+        #expect(changes == nil)
+        #expect(sut.dirtyTables == ["_layers"])
+        #expect(sut.dirtyRows.isEmpty)
+    }
+
+    @Test("Given stored rows, when one row changes and one is removed, then only those rows are dirty")
+    func changedAndRemovedRows() throws {
+        var sut = StoreChangeTracker()
+        _ = sut.updateRows(in: "_layers", rows: rows([0: "grid", 1: "core", 2: "text"]))
+        sut.markSaved(to: "/tmp/rose.XRose")
+
+        let changes = try #require(sut.updateRows(in: "_layers", rows: rows([0: "grid", 1: "moved core"])))
+
+        #expect(changes.changed == [1])
+        #expect(changes.removed == [2])
+        #expect(sut.dirtyTables.isEmpty)
+        #expect(sut.dirtyRows["_layers"] == changes)
+        #expect(sut.hasChanges)
+    }
+
+    @Test("Given unchanged rows, when updating, then nothing is dirty")
+    func unchangedRows() throws {
+        var sut = StoreChangeTracker()
+        _ = sut.updateRows(in: "_layers", rows: rows([0: "grid"]))
+        sut.markSaved(to: "/tmp/rose.XRose")
+
+        let changes = try #require(sut.updateRows(in: "_layers", rows: rows([0: "grid"])))
+
+        #expect(changes.isEmpty)
+        #expect(!sut.hasChanges)
+    }
+
+    @Test("Given a row removed and then stored again before saving, then it is a change, not a removal")
+    func mergeRowChanges() throws {
+        var sut = StoreChangeTracker()
+        _ = sut.updateRows(in: "_layers", rows: rows([0: "grid", 1: "core"]))
+        sut.markSaved(to: "/tmp/rose.XRose")
+        _ = sut.updateRows(in: "_layers", rows: rows([0: "grid"]))
+
+        _ = sut.updateRows(in: "_layers", rows: rows([0: "grid", 1: "new core"]))
+
+        let dirty = try #require(sut.dirtyRows["_layers"])
+        #expect(dirty.changed == [1])
+        #expect(dirty.removed.isEmpty)
+    }
+
+    @Test("Given small table contents, when unchanged, then the table is not dirty")
+    func tableContents() {
+        var sut = StoreChangeTracker()
+
+        #expect(sut.updateTable("_geometryController", contents: Data("a".utf8)))
+        sut.markSaved(to: "/tmp/rose.XRose")
+
+        #expect(!sut.updateTable("_geometryController", contents: Data("a".utf8)))
+        #expect(!sut.hasChanges)
+        #expect(sut.updateTable("_geometryController", contents: Data("b".utf8)))
+        #expect(sut.dirtyTables == ["_geometryController"])
+    }
+
+    @Test("Incremental saves are only possible to the baseline file")
+    func baselinePath() {
+        var sut = StoreChangeTracker()
+        #expect(!sut.canSaveIncrementally(to: "/tmp/rose.XRose"))
+
+        sut.reset(baselinePath: "/tmp/rose.XRose")
+
+        #expect(sut.canSaveIncrementally(to: "/tmp/./rose.XRose"))
+        #expect(!sut.canSaveIncrementally(to: "/tmp/other.XRose"))
+    }
+}
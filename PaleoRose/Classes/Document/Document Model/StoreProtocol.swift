@@ -32,8 +32,19 @@ protocol StoreProtocol {
     func createInMemoryStore(identifier: String) throws -> OpaquePointer
     func executeQuery(sqlite: OpaquePointer, query: QueryProtocol) throws -> [[String: Codable]]
     func executeCodableQuery<T: Codable>(sqlite: OpaquePointer, query: QueryProtocol) throws -> [T]
+    func readColumn<T: BinaryFloatingPoint & LosslessStringConvertible>(
+        _ column: String,
+        as type: T.Type,
+        sqlite: OpaquePointer,
+        query: QueryProtocol
+    ) throws -> [T]
+    @discardableResult
+    func executeEach(sqlite: OpaquePointer, sql: String, nextRow: () throws -> [Bindable?]?) throws -> Int
+    func invalidateStatements(sqlite: OpaquePointer)
+    func pagesWritten(sqlite: OpaquePointer, reset: Bool) -> Int
     func close(store: OpaquePointer) throws
     func openDatabase(path: String) throws -> OpaquePointer
+    func openReadOnlyDatabase(path: String) throws -> OpaquePointer
     func backup(source: OpaquePointer, destination: OpaquePointer) throws
     func columns(sqlite: OpaquePointer, table: String) throws -> [ColumnInformation]
 }
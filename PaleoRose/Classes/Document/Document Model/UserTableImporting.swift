@@ -32,6 +32,10 @@ protocol UserTableImporting: AnyObject {
     /// Parses `dataFrame` and creates a new SQLite user table named `tableName`.
     func importTable(_ dataFrame: DataFrame, named tableName: String) throws
 
+    /// Streams the delimited text file at `url` into a new user table described by `options`.
+    /// `progress` reports bytes read; cancelling it rolls the table back.
+    func importText(from url: URL, options: TextImportOptions, progress: Progress) throws
+
     /// Copies selected tables from a source `.XRose` file into the current document.
     func copyTables(
         from sourceURL: URL,
@@ -53,4 +53,26 @@ extension XRGeometryController {
         )
         return controller
     }
+
+    /// A 36 sector rose with a hollow core, laid out in a square `width` points across
+    static func laidOutStub(
+        isPercent: Bool = false,
+        isEqualArea: Bool = true,
+        maxCount: Int = 40,
+        width: Double = 600
+    ) -> XRGeometryController {
+        let controller = stub(
+            isEqualArea: isEqualArea,
+            isPercent: isPercent,
+            maxCount: maxCount,
+            maxPercent: 0.2,
+            hollowCore: 0.2,
+            sectorSize: 10,
+            startingAngle: 5,
+            sectorCount: 36,
+            relativeSize: 0.8
+        )
+        controller.resetGeometry(withBoundsRect: NSRect(x: 0, y: 0, width: width, height: width))
+        return controller
+    }
 }
@@ -29,6 +29,16 @@
 #define XRGeometryDidChangeIsPercent @"XRGeometryDidChangeIsPercent" //in this case, much has to be redrawn completely.. layers should pick this up
 #define XRGeometryDidChangeSectors @"XRGeometryDidChangeSectors" //in this case, much has to be redrawn completely.. layers should pick this up
 
+//what changed, in the userInfo of the geometry notifications under XRGeometryChangeMaskKey
+typedef NS_OPTIONS(NSUInteger, XRGeometryChange) {
+	XRGeometryChangeBounds = 1 << 0, //the plot moved or was resized; graphics only have to be rescaled
+	XRGeometryChangeScale = 1 << 1, //max count, max percent, hollow core or percent mode; radii change
+	XRGeometryChangeSectors = 1 << 2, //sector size, count or starting angle; data has to be counted again
+	XRGeometryChangeProjection = 1 << 3 //equal area or linear
+};
+#define XRGeometryChangeAll (XRGeometryChangeBounds | XRGeometryChangeScale | XRGeometryChangeSectors | XRGeometryChangeProjection)
+#define XRGeometryChangeMaskKey @"XRGeometryChangeMask"
+
 //defaults keys
 #define XRGeometryDefaultKeyEqualArea @"XRGeometryDefaultKeyEqualArea"
 #define XRGeometryDefaultKeyPercent @"XRGeometryDefaultKeyPercent"
@@ -52,9 +62,28 @@
 	float _startingAngle;
 	int _sectorCount;
 	NSUndoManager *theUndoManager;
+	//changes not yet posted
+	XRGeometryChange _pendingChanges;
+	BOOL _pendingPercentChange;
+	NSInteger _changeGroupDepth;
+	BOOL _flushScheduled;
 }
 
 @property (nonatomic, weak) id layersTableController;
+//for tests: changes made, and the notifications actually posted for them
+@property (nonatomic, readonly) NSUInteger geometryChangeCount;
+@property (nonatomic, readonly) NSUInteger geometryNotificationCount;
+
+//the change mask a geometry notification carries; notifications without one changed everything
++(XRGeometryChange)changeOfNotification:(NSNotification *)notification;
+
+//changes made between these are posted as one notification on the next pass of the main queue;
+//outside of them a change is posted at once, or joins a group's notification that has not gone out yet
+-(void)beginGeometryChanges;
+-(void)endGeometryChanges;
+//posts pending changes now rather than waiting for the run loop
+-(void)flushGeometryChanges;
+-(XRGeometryChange)pendingGeometryChanges;
 
 -(void)setUndoManager:(NSUndoManager *)aManager;
 
@@ -85,6 +85,16 @@
               startingAngle:(float)startingAngle
                 sectorCount:(int)sectorCount
                relativeSize:(float)relativeSize {
+    XRGeometryChange changes = 0;
+    if(_isPercent != isPercent || _geometryMaxCount != maxCount || _geometryMaxPercent != maxPercent || _hollowCoreSize != hollowCore)
+        changes |= XRGeometryChangeScale;
+    if(_isEqualArea != isEqualArea)
+        changes |= XRGeometryChangeProjection;
+    if(_sectorSize != sectorSize || _startingAngle != startingAngle || _sectorCount != sectorCount)
+        changes |= XRGeometryChangeSectors;
+    if(_relativeSizeOfCircleRect != relativeSize)
+        changes |= XRGeometryChangeBounds;
+    _pendingPercentChange = _pendingPercentChange || _isPercent != isPercent;
     _isPercent = isPercent;
     _isEqualArea = isEqualArea;
     _geometryMaxCount = maxCount;
@@ -94,7 +104,71 @@
     _startingAngle = startingAngle;
     _sectorCount = sectorCount;
     _relativeSizeOfCircleRect = relativeSize;
-    [[NSNotificationCenter defaultCenter] postNotificationName:XRGeometryDidChange object:self];
+    [self noteGeometryChange:changes];
+}
+
+#pragma mark - Change Notifications
+
++(XRGeometryChange)changeOfNotification:(NSNotification *)notification
+{
+	NSNumber *mask = [[notification userInfo] objectForKey:XRGeometryChangeMaskKey];
+	return mask ? (XRGeometryChange)[mask unsignedIntegerValue] : XRGeometryChangeAll;
+}
+
+-(void)beginGeometryChanges
+{
+	_changeGroupDepth++;
+}
+
+-(void)endGeometryChanges
+{
+	if(_changeGroupDepth == 0)
+		return;
+	_changeGroupDepth--;
+	if(_changeGroupDepth == 0 && _pendingChanges != 0 && !_flushScheduled)
+	{
+		//like the sector recompute scheduler, wait for the main queue so every group made in this pass is posted together
+		_flushScheduled = YES;
+		__weak XRGeometryController *weakSelf = self;
+		dispatch_async(dispatch_get_main_queue(), ^{
+			[weakSelf flushGeometryChanges];
+		});
+	}
+}
+
+-(XRGeometryChange)pendingGeometryChanges
+{
+	return _pendingChanges;
+}
+
+-(void)noteGeometryChange:(XRGeometryChange)changes
+{
+	if(changes == 0)
+		return;
+	_geometryChangeCount++;
+	_pendingChanges |= changes;
+	if(_changeGroupDepth == 0 && !_flushScheduled)
+		[self flushGeometryChanges];
+}
+
+//one notification for everything pending; a sector change is posted under XRGeometryDidChangeSectors so data
+//is counted again, and a switch between counts and percents under XRGeometryDidChangeIsPercent
+-(void)flushGeometryChanges
+{
+	_flushScheduled = NO;
+	XRGeometryChange changes = _pendingChanges;
+	BOOL percentChanged = _pendingPercentChange;
+	_pendingChanges = 0;
+	_pendingPercentChange = NO;
+	if(changes == 0)
+		return;
+	NSString *name = XRGeometryDidChange;
+	if(changes & XRGeometryChangeSectors)
+		name = XRGeometryDidChangeSectors;
+	else if(percentChanged)
+		name = XRGeometryDidChangeIsPercent;
+	_geometryNotificationCount++;
+	[[NSNotificationCenter defaultCenter] postNotificationName:name object:self userInfo:@{XRGeometryChangeMaskKey: @(changes)}];
 }
 
 -(void)setUndoManager:(NSUndoManager *)aManager
@@ -125,11 +199,13 @@
 
 -(void)resetGeometryWithBoundsRect:(NSRect)newBounds
 {
-
+	NSRect oldCircleRect = _circleRect;
+	BOOL boundsChanged = !NSEqualRects(_mainRect, newBounds);
 	_mainRect = newBounds;
 	_circleRect = NSInsetRect(_mainRect,_mainRect.size.width * (1.0 - _relativeSizeOfCircleRect),_mainRect.size.height * (1.0 - _relativeSizeOfCircleRect));
-	NSLog(@"XRGeometryController: resetGeometryWithBoundsRect - mainRect=%@, circleRect=%@, posting XRGeometryDidChange", NSStringFromRect(_mainRect), NSStringFromRect(_circleRect));
-	[[NSNotificationCenter defaultCenter] postNotificationName:XRGeometryDidChange object:self];
+	if(!boundsChanged && NSEqualRects(oldCircleRect, _circleRect))
+		return;
+	[self noteGeometryChange:XRGeometryChangeBounds];
 }
 
 -(BOOL)isEqualArea
@@ -147,7 +223,7 @@
 		else
 			[theUndoManager setActionName:@" Linear Rose"];
 		_isEqualArea = equal;
-		[[NSNotificationCenter defaultCenter] postNotificationName:XRGeometryDidChange object:self];
+		[self noteGeometryChange:XRGeometryChangeProjection];
 		
 	}
 }
@@ -172,7 +248,8 @@
 		else
 			[theUndoManager setActionName:@"Number Count"];
 		_isPercent = percent;
-		[[NSNotificationCenter defaultCenter] postNotificationName:XRGeometryDidChangeIsPercent object:self];
+		_pendingPercentChange = YES;
+		[self noteGeometryChange:XRGeometryChangeScale];
 	}
 }
 
@@ -194,7 +271,7 @@
 		[theUndoManager registerUndoWithTarget:self selector:@selector(setGeomentryMaxCountWithNumber:) object:[NSNumber numberWithInt:_geometryMaxCount]];
 		[theUndoManager setActionName:@"Max Count"];
 		_geometryMaxCount = newCount;
-		[[NSNotificationCenter defaultCenter] postNotificationName:XRGeometryDidChange object:self];
+		[self noteGeometryChange:XRGeometryChangeScale];
 	}
 }
 
@@ -232,7 +309,7 @@
 		[theUndoManager registerUndoWithTarget:self selector:@selector(setGeomentryMaxPercentWithNumber:) object:[NSNumber numberWithFloat:_geometryMaxPercent]];
 		[theUndoManager setActionName:@"Max Percent"];
 		_geometryMaxPercent = percent;
-		[[NSNotificationCenter defaultCenter] postNotificationName:XRGeometryDidChange object:self];
+		[self noteGeometryChange:XRGeometryChangeScale];
 	}
 }
 
@@ -253,7 +330,7 @@
 		[theUndoManager registerUndoWithTarget:self selector:@selector(setHollowCoreSizeWithNumber:) object:[NSNumber numberWithFloat:_hollowCoreSize]];
 		[theUndoManager setActionName:@"Hollow Core"];
 		_hollowCoreSize = newSize;
-		[[NSNotificationCenter defaultCenter] postNotificationName:XRGeometryDidChange object:self];
+		[self noteGeometryChange:XRGeometryChangeScale];
 	}
 }
 
@@ -274,7 +351,7 @@
 	_startingAngle = angle;
 	//NSLog(@"starting angle %f %f",_startingAngle,angle);
 	//requires updating counts and percents
-	[[NSNotificationCenter defaultCenter] postNotificationName:XRGeometryDidChangeSectors object:self];
+	[self noteGeometryChange:XRGeometryChangeSectors];
 }
 
 -(void)setStartingAngleWithNumber:(NSNumber *)aNumber
@@ -293,7 +370,7 @@
 	[theUndoManager setActionName:@"Sector Size"];
 	_sectorSize = angle;
 	//requires updating everythign
-	[[NSNotificationCenter defaultCenter] postNotificationName:XRGeometryDidChangeSectors object:self];
+	[self noteGeometryChange:XRGeometryChangeSectors];
 }
 
 -(void)setSectorSizeWithNumber:(NSNumber *)aNumber
@@ -311,7 +388,7 @@
 	[theUndoManager setActionName:@"Sector Count"];
 	_sectorSize = 360.0/(float)count;
 	_sectorCount = count;
-	[[NSNotificationCenter defaultCenter] postNotificationName:XRGeometryDidChangeSectors object:self];
+	[self noteGeometryChange:XRGeometryChangeSectors];
 }
 
 -(void)setSectorCountWithNumber:(NSNumber *)aNumber
@@ -352,36 +429,36 @@
 }
 
 
--(double)radiusOfRelativePercent:(double)percent
+//shared by radiusOfRelativePercent: and getRadii:ofRelativePercents:count: so both give the same radii
+static inline double XRRadiusOfRelativePercent(double percent, float hollowCoreSize, BOOL isEqualArea, CGFloat circleWidth)
 {
-	//this calculation exists to calculate the actual percentage.  Callers should estimate the percent of the largest value and send it to this method
-	double hollowSqr = _hollowCoreSize * _hollowCoreSize;
-	double percentRadius,relativeRadius,workPercent;
+	double hollowSqr = hollowCoreSize * hollowCoreSize;
+	double percentRadius;
 	double radius;
-	workPercent = percent;
+	double workPercent = percent;
 	if(workPercent>1.1)
 		workPercent = 1.1;
-	//double relativeRadius = ((1.0 - _hollowCoreSize) * percent)+(_hollowCoreSize);
-	radius = (_circleRect.size.width / 2.0);//full circle radius in pixels
-	if(_isEqualArea)
-	{
-		//double relativeRadius = ((1.0 - _hollowCoreSize) * percent)+(_hollowCoreSize);
-		percentRadius = ((1.0- hollowSqr) * workPercent) + hollowSqr;
-		relativeRadius = sqrt(percentRadius);
-		radius = radius * relativeRadius;
-										   
-		
-	}
-	else
-	{
-		//in linear terms, simply subtract the hollow core from the radius, multiply it by percent, re-add core;
+	radius = (circleWidth / 2.0);//full circle radius in pixels
+	//in linear terms, simply subtract the hollow core from the radius, multiply it by percent, re-add core;
+	percentRadius = ((1.0- hollowSqr) * workPercent) + hollowSqr;
+	if(isEqualArea)
+		return radius * sqrt(percentRadius);
+	return radius * percentRadius;
+}
 
-		percentRadius = ((1.0- hollowSqr) * workPercent) + hollowSqr;
-		radius = radius * percentRadius;
-	}
-	//NSLog(@"percent %f radius %f core size %f", percent, radius,_hollowCoreSize);
-	//NSLog(@"radius %f",radius);
-	return radius;
+-(double)radiusOfRelativePercent:(double)percent
+{
+	//this calculation exists to calculate the actual percentage.  Callers should estimate the percent of the largest value and send it to this method
+	return XRRadiusOfRelativePercent(percent, _hollowCoreSize, _isEqualArea, _circleRect.size.width);
+}
+
+-(void)getRadii:(double *)radii ofRelativePercents:(const double *)percents count:(NSUInteger)count
+{
+	float hollowCoreSize = _hollowCoreSize;
+	BOOL isEqualArea = _isEqualArea;
+	CGFloat circleWidth = _circleRect.size.width;
+	for(NSUInteger i=0;i<count;i++)
+		radii[i] = XRRadiusOfRelativePercent(percents[i], hollowCoreSize, isEqualArea, circleWidth);
 }
 
 -(double)unrestrictedRadiusOfRelativePercent:(double)percent
@@ -0,0 +1,157 @@
+//
+// XRGeometryControllerTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import Foundation
+@testable import PaleoRose
+import Testing
+
+@MainActor
+@Suite("XRGeometryController change notifications", .serialized)
+struct XRGeometryControllerTests {
+
+    // MARK: - Test Setup
+
+    private struct Received {
+        let name: String
+        let change: XRGeometryChange
+    }
+
+    private final class NotificationRecorder {
+        private(set) var received: [Received] = []
+        private var tokens: [NSObjectProtocol] = []
+
+        init(controller: XRGeometryController) {
+            for name in ["XRGeometryDidChange", "XRGeometryDidChangeIsPercent", "XRGeometryDidChangeSectors"] {
+                tokens.append(NotificationCenter.default.addObserver(
+                    forName: Notification.Name(rawValue: name),
+                    object: controller,
+                    queue: nil
+                ) { [weak self] notification in
+                    self?.received.append(Received(name: name, change: XRGeometryController.change(of: notification)))
+                })
+            }
+        }
+
+        deinit {
+            tokens.forEach(NotificationCenter.default.removeObserver)
+        }
+    }
+
+    // MARK: - Tests
+
+    @Test("A change outside a group is posted at once with its change mask")
+    func ungroupedChangePostsAtOnce() {
+        let controller = XRGeometryController.laidOutStub()
+        let recorder = NotificationRecorder(controller: controller)
+        let posted = controller.geometryNotificationCount
+
+        controller.setHollowCoreSize(0.3)
+        controller.setEqualArea(!controller.isEqualArea())
+
+        #expect(recorder.received.map(\.name) == ["XRGeometryDidChange", "XRGeometryDidChange"])
+        #expect(recorder.received.map(\.change) == [.scale, .projection])
+        #expect(controller.geometryNotificationCount == posted + 2)
+    }
+
+    @Test("Grouped changes are posted as one notification on the next pass of the main queue")
+    func groupedChangesCoalesce() async throws {
+        let controller = XRGeometryController.laidOutStub()
+        let recorder = NotificationRecorder(controller: controller)
+        let changes = controller.geometryChangeCount
+        let posted = controller.geometryNotificationCount
+
+        controller.beginGeometryChanges()
+        controller.resetGeometry(withBoundsRect: NSRect(x: 0, y: 0, width: 800, height: 800))
+        controller.beginGeometryChanges()
+        controller.setGeomentryMaxCount(60)
+        controller.setSectorCount(12)
+        controller.endGeometryChanges()
+        controller.setStartingAngle(5)
+        controller.endGeometryChanges()
+
+        #expect(recorder.received.isEmpty)
+        #expect(controller.pendingGeometryChanges() == [.bounds, .scale, .sectors])
+
+        try await Task.sleep(for: .milliseconds(50))
+
+        #expect(recorder.received.count == 1)
+        #expect(recorder.received.first?.name == "XRGeometryDidChangeSectors")
+        #expect(recorder.received.first?.change == [.bounds, .scale, .sectors])
+        #expect(controller.geometryChangeCount == changes + 4)
+        #expect(controller.geometryNotificationCount == posted + 1)
+        #expect(controller.pendingGeometryChanges().isEmpty)
+    }
+
+    @Test("Flushing posts a group without waiting and a switch to percents keeps its own notification")
+    func flushPostsPendingChanges() {
+        let controller = XRGeometryController.laidOutStub()
+        let recorder = NotificationRecorder(controller: controller)
+
+        controller.beginGeometryChanges()
+        controller.setPercent(true)
+        controller.setGeomentryMaxPercent(0.4)
+        controller.endGeometryChanges()
+        controller.flushGeometryChanges()
+
+        #expect(recorder.received.map(\.name) == ["XRGeometryDidChangeIsPercent"])
+        #expect(recorder.received.map(\.change) == [.scale])
+    }
+
+    @Test("Resetting to the same bounds posts nothing")
+    func unchangedBoundsAreSilent() {
+        let controller = XRGeometryController.laidOutStub()
+        let recorder = NotificationRecorder(controller: controller)
+        let changes = controller.geometryChangeCount
+
+        controller.resetGeometry(withBoundsRect: NSRect(x: 0, y: 0, width: 600, height: 600))
+
+        #expect(recorder.received.isEmpty)
+        #expect(controller.geometryChangeCount == changes)
+    }
+
+    @Test("A data layer rescales its graphics for a bounds change and rebuilds them for a scale change")
+    func dataLayerDoesTheLeastWork() throws {
+        let controller = XRGeometryController.laidOutStub()
+        let dataSet = try XRDataSet.stub(count: 500)
+        let layer = try #require(XRLayerData(geometryController: controller, with: dataSet))
+        let graphics = try #require(layer.graphicalObjects() as? [Graphic])
+        #expect(!graphics.isEmpty)
+        let hits = graphics.map(\.geometryCacheHits)
+
+        controller.resetGeometry(withBoundsRect: NSRect(x: 0, y: 0, width: 900, height: 900))
+
+        let resized = try #require(layer.graphicalObjects() as? [Graphic])
+        #expect(resized.count == graphics.count)
+        #expect(zip(resized, graphics).allSatisfy { $0 === $1 })
+        #expect(zip(resized, hits).allSatisfy { $0.geometryCacheHits == $1 + 1 })
+
+        controller.setGeomentryMaxCount(80)
+
+        let rebuilt = try #require(layer.graphicalObjects() as? [Graphic])
+        #expect(!zip(rebuilt, graphics).contains { $0 === $1 })
+    }
+}
@@ -142,6 +142,23 @@
     return YES;
 }
 
+-(BOOL)writeSafelyToURL:(NSURL *)url ofType:(NSString *)typeName forSaveOperation:(NSSaveOperationType)saveOperation error:(NSError * _Nullable __autoreleasing *)outError
+{
+    // An incremental save rewrites only changed tables inside one SQLite transaction, which is
+    // already atomic, so write the existing file in place rather than copying the whole store
+    // to a temporary file and swapping it in.
+    if(saveOperation == NSSaveOperation && [self.documentModel canSaveIncrementallyTo:url])
+    {
+        return [self writeToURL:url ofType:typeName error:outError];
+    }
+    if(![super writeSafelyToURL:url ofType:typeName forSaveOperation:saveOperation error:outError])
+        return NO;
+    // The file written through a temporary copy is now the baseline for incremental saves
+    if(saveOperation == NSSaveOperation || saveOperation == NSSaveAsOperation)
+        [self.documentModel didSaveTo:url];
+    return YES;
+}
+
 #pragma mark - Getting Document Metadata
 
 #pragma mark - Managing File Type Information
@@ -355,54 +372,27 @@
 // **** REFACTOR/MOVE
 -(NSString *)FTestStatisticsForSetNames:(NSArray *)setNames biDirectional:(BOOL)isBiDir
 {
-    XRDataSet *tempSet1 = [self dataSetWithName:[setNames objectAtIndex:0]];
-    XRDataSet *tempSet2 = [self dataSetWithName:[setNames objectAtIndex:1]];
-    XRDataSet *set1,*set2,*set3;
+    XRDataSet *set1 = [self dataSetWithName:[setNames objectAtIndex:0]];
+    XRDataSet *set2 = [self dataSetWithName:[setNames objectAtIndex:1]];
     NSMutableString *aString = [[NSMutableString alloc] init];
-    float R1,R2,Rp;
-    float FStatistic,n;
-
-    float kp;//kappa pooled
-        FStatistic = 0;
-    if(tempSet1)
-        set1= [[XRDataSet alloc] initWithData:[tempSet1 theData] withName:[setNames objectAtIndex:0]];
-    else
-        return nil;
-    if(tempSet2)
-        set2= [[XRDataSet alloc] initWithData:[tempSet2 theData] withName:[setNames objectAtIndex:1]];
-    else
+    float FStatistic;
+    if(!set1 || !set2)
         return nil;
-    set3 = [[XRDataSet alloc] initWithData:[tempSet1 theData] withName:[NSString stringWithFormat:@"Test Set for %@ and %@",[setNames objectAtIndex:0],[setNames objectAtIndex:1]]];
-    [set3 appendData:[tempSet2 theData]];
-    //generate all the stats
-    [set1 calculateStatisticObjectsForBiDir:isBiDir];
-    [set2 calculateStatisticObjectsForBiDir:isBiDir];
-    [set3 calculateStatisticObjectsForBiDir:isBiDir];
-    [aString appendFormat:@"\nData Set: %@",[set1 name]];
-    [aString appendFormat:@"\n%@",[set1 statisticsDescription]];
-    [aString appendFormat:@"\nData Set: %@",[set2 name]];
-    [aString appendFormat:@"\n%@",[set2 statisticsDescription]];
-    [aString appendFormat:@"\nData Set: %@",[set3 name]];
-    [aString appendFormat:@"\n%@",[set3 statisticsDescription]];
-    kp = [[set3 currentStatisticWithName:[NSString stringWithUTF8String:"κ (est)"]] floatValue];
-    n = (float)[[set3 currentStatisticWithName:@"N"] intValue];
-    R1 = [[set1 currentStatisticWithName:[NSString stringWithUTF8String:"R"]] floatValue];
-    R2 = [[set2 currentStatisticWithName:[NSString stringWithUTF8String:"R"]] floatValue];
-    Rp = [[set3 currentStatisticWithName:[NSString stringWithUTF8String:"R"]] floatValue];
-    if(kp >=10.0)
-    {
-        FStatistic = ((n - 2.0)*(R1 + R2 - Rp))/(n-R1-R2);
-
-    }
-    else if(kp>=2.0)
-    {
-        FStatistic = (1 + (3/(8*kp)))*((n - 2.0)*(R1 + R2 - Rp))/(n-R1-R2);
-        //NSLog(@"%f %f %f %f %f",FStatistic,kp,R1,R2,Rp);
-    }
-    if(kp<2.0)
+    //the pooled sample is summarized from the two sets' running sums; nothing is copied
+    XRCircularSummary summary1 = [set1 circularSummaryForBiDir:isBiDir];
+    XRCircularSummary summary2 = [set2 circularSummaryForBiDir:isBiDir];
+    XRCircularSummary pooled = XRCircularSummaryPooled(summary1, summary2, [XRDataSet vectorCalculationMethod]);
+    BOOL calculable = XRCircularSummaryFStatistic(summary1, summary2, pooled, &FStatistic);
+    [aString appendFormat:@"\nData Set: %@",[setNames objectAtIndex:0]];
+    [aString appendFormat:@"\n%@",[XRDataSet statisticsDescriptionForSummary:summary1]];
+    [aString appendFormat:@"\nData Set: %@",[setNames objectAtIndex:1]];
+    [aString appendFormat:@"\n%@",[XRDataSet statisticsDescriptionForSummary:summary2]];
+    [aString appendFormat:@"\nData Set: %@",[NSString stringWithFormat:@"Test Set for %@ and %@",[setNames objectAtIndex:0],[setNames objectAtIndex:1]]];
+    [aString appendFormat:@"\n%@",[XRDataSet statisticsDescriptionForSummary:pooled]];
+    if(!calculable)
         [aString appendFormat:@"\n%@",@"F-Statistic: Not Calculable.  Kappa below 2"];
     else
-        [aString appendFormat:@"\n%@",[NSString stringWithFormat:@"F-Statistic: \t%f \tdf1: = 1\tdf2 = %i",FStatistic,(int)n-2]];
+        [aString appendFormat:@"\n%@",[NSString stringWithFormat:@"F-Statistic: \t%f \tdf1: = 1\tdf2 = %i",FStatistic,pooled.count-2]];
 
     return aString;
 }
@@ -90,6 +90,11 @@ let GraphicTypeDotDeviation = "DotDeviation"
     @objc var drawsFill: Bool = false
     var needsDisplay: Bool = true
 
+    /// Times `cachedGeometry` reused, or had to build, this graphic's geometry.
+    private(set) var geometryCacheHits = 0
+    private(set) var geometryCacheMisses = 0
+    private var geometryCache: (key: GeometryCacheKey, scale: CGFloat, value: Any)?
+
     @objc var lineWidth: Float = 1.0 {
         didSet {
             drawingPath?.lineWidth = CGFloat(lineWidth)
@@ -115,10 +120,75 @@ let GraphicTypeDotDeviation = "DotDeviation"
         calculateGeometry()
     }
 
-    func calculateGeometry() {
+    @objc func calculateGeometry() {
         // Subclasses must override this method to set up the geometry of the graphic object
     }
 
+    // MARK: - Geometry Cache
+
+    /// Everything a graphic's geometry depends on except the size of the rose circle.
+    struct GeometryCacheKey: Hashable {
+        let isPercent: Bool
+        let isEqualArea: Bool
+        let hollowCore: Float
+        let startAngle: Float
+        let sectorSize: Float
+        let maxCount: Int32
+        let maxPercent: Float
+        /// The graphic's own inputs, such as its sector and value.
+        let shape: [Double]
+
+        init(controller: GraphicGeometrySource, shape: [Double]) {
+            isPercent = controller.isPercent()
+            isEqualArea = controller.isEqualArea()
+            hollowCore = controller.hollowCoreSize()
+            startAngle = controller.startingAngle()
+            sectorSize = controller.sectorSize()
+            maxCount = controller.geometryMaxCount()
+            maxPercent = controller.geometryMaxPercent()
+            self.shape = shape
+        }
+    }
+
+    /// Returns geometry from `build`, or rescales the last geometry built when only the circle size has changed.
+    ///
+    /// Every radius the controller hands out is proportional to the circle radius, which is
+    /// `unrestrictedRadius(ofRelativePercent: 1)`, and rotation is about the origin, so a resize is a
+    /// uniform scale of what was built before. Rescaling always starts from the built geometry so
+    /// repeated resizes do not accumulate error.
+    func cachedGeometry<T>(
+        shape: [Double],
+        build: (GraphicGeometrySource) -> T,
+        rescale: (T, CGFloat) -> T
+    ) -> T? {
+        guard let controller = geometryController else {
+            return nil
+        }
+        let key = GeometryCacheKey(controller: controller, shape: shape)
+        let scale = controller.unrestrictedRadius(ofRelativePercent: 1.0)
+        if let cache = geometryCache, cache.key == key, cache.scale > 0, scale > 0, let value = cache.value as? T {
+            geometryCacheHits += 1
+            return rescale(value, scale / cache.scale)
+        }
+        geometryCacheMisses += 1
+        let value = build(controller)
+        geometryCache = (key: key, scale: scale, value: value)
+        return value
+    }
+
+    /// `cachedGeometry` for a path; a cached path is copied before it is scaled.
+    func cachedPath(shape: [Double], build: (GraphicGeometrySource) -> NSBezierPath) -> NSBezierPath? {
+        cachedGeometry(shape: shape, build: build) { path, factor in
+            guard let scaled = path.copy() as? NSBezierPath else {
+                return path
+            }
+            if factor != 1.0 {
+                scaled.transform(using: AffineTransform(scale: factor))
+            }
+            return scaled
+        }
+    }
+
     func drawingRect() -> CGRect {
         drawingPath?.bounds ?? CGRect.zero
     }
@@ -37,11 +37,16 @@ import AppKit
         didSet { calculateGeometry() }
     }
 
+    /// True when the dots would overlap and the sector is drawn as one bar with its count beside it.
+    private(set) var isCollapsed = false
+
     // MARK: - Private State
 
     private var angleIncrement: Int = 0
     private var totalCount: Int = 0
     private var count: Int = 0
+    /// Where the count of a collapsed sector is drawn.
+    private var countLabelRect = CGRect.zero
 
     // MARK: - Init
 
@@ -76,26 +81,113 @@ import AppKit
         return CGFloat(controller.radius(ofCount: Int32(index)))
     }
 
+    /// Radii of the dots in `range`, from a single call when the controller can batch them.
+    ///
+    /// The relative percents are the divisions `radiusOfCount:` and `radiusOfPercentValue:` make,
+    /// so the batched radii are identical to asking for each dot.
+    private func radii(of range: Range<Int>, controller: GraphicGeometrySource) -> [Double] {
+        let isPercentMode = controller.isPercent()
+        let selector = #selector(GraphicGeometrySource.getRadii(_:ofRelativePercents:count:))
+        guard controller.responds(to: selector) else {
+            return range.map { Double(radiusForDot(index: $0, isPercentMode: isPercentMode)) }
+        }
+        let percents: [Double]
+        if isPercentMode {
+            let maxPercent = Double(controller.geometryMaxPercent())
+            percents = range.map { Double(CGFloat($0 + 1) / CGFloat(totalCount)) / maxPercent }
+        } else {
+            let maxCount = Double(controller.geometryMaxCount())
+            percents = range.map { Double($0) / maxCount }
+        }
+        var radii = [Double](repeating: 0, count: percents.count)
+        radii.withUnsafeMutableBufferPointer { buffer in
+            controller.getRadii?(buffer.baseAddress, ofRelativePercents: percents, count: UInt(percents.count))
+        }
+        return radii
+    }
+
+    private func overlaps(_ radii: [Double]) -> Bool {
+        zip(radii, radii.dropFirst()).contains { abs($1 - $0) < Double(dotSize) }
+    }
+
     // MARK: - Geometry
 
     @objc override func calculateGeometry() {
         guard let controller = geometryController else {
             return
         }
+        // Rotating the unit vector once gives the same products as rotating each dot's point
+        let direction = controller.rotation(of: CGPoint(x: 0.0, y: 1.0), byAngle: Double(centerAngleForSector()))
+        // Radii grow ever more slowly with the count, so the outermost dots are the closest pair
+        if count > 1, overlaps(radii(of: count - 2 ..< count, controller: controller)) {
+            collapse(controller: controller, direction: direction)
+            return
+        }
+        let radii = radii(of: 0 ..< count, controller: controller)
+        if overlaps(radii) {
+            collapse(controller: controller, direction: direction)
+            return
+        }
+        isCollapsed = false
+        let centers = radii.map { CGPoint(x: CGFloat($0) * direction.x, y: CGFloat($0) * direction.y) }
         let path = NSBezierPath()
-        let isPercentMode = controller.isPercent()
-        let centerAngle = centerAngleForSector()
-        for index in 0 ..< count {
-            let radius = radiusForDot(index: index, isPercentMode: isPercentMode)
-            var point = CGPoint(x: 0.0, y: radius)
-            point = controller.rotation(of: point, byAngle: Double(centerAngle))
-            let half = CGFloat(dotSize) * 0.5
+        let half = CGFloat(dotSize) * 0.5
+        for point in centers {
             let rect = CGRect(x: point.x - half, y: point.y - half, width: CGFloat(dotSize), height: CGFloat(dotSize))
             path.appendOval(in: rect)
         }
         drawingPath = path
     }
 
+    /// Replaces the dots with a bar a dot wide, from the innermost to the outermost dot,
+    /// and places the count just past its outer end.
+    private func collapse(controller: GraphicGeometrySource, direction: CGPoint) {
+        let inner = CGFloat(radii(of: 0 ..< 1, controller: controller)[0])
+        let outer = CGFloat(radii(of: count - 1 ..< count, controller: controller)[0])
+        let size = CGFloat(dotSize)
+        let half = size * 0.5
+        let bar = CGRect(x: -half, y: inner - half, width: size, height: outer - inner + size)
+        let path = NSBezierPath(roundedRect: bar, xRadius: half, yRadius: half)
+        // Maps (0, r) to r * direction, as the rotation of a dot's center does
+        path.transform(using: AffineTransform(
+            m11: direction.y, m12: -direction.x,
+            m21: direction.x, m22: direction.y,
+            tX: 0, tY: 0
+        ))
+        drawingPath = path
+        isCollapsed = true
+
+        let labelSize = countLabel().size()
+        let distance = outer + size + max(labelSize.width, labelSize.height) * 0.5
+        countLabelRect = CGRect(
+            x: distance * direction.x - labelSize.width * 0.5,
+            y: distance * direction.y - labelSize.height * 0.5,
+            width: labelSize.width,
+            height: labelSize.height
+        )
+    }
+
+    private func countLabel() -> NSAttributedString {
+        let attributes: [NSAttributedString.Key: Any] = [
+            .font: NSFont.systemFont(ofSize: max(CGFloat(dotSize) * 2.0, NSFont.smallSystemFontSize)),
+            .foregroundColor: strokeColor ?? NSColor.black
+        ]
+        return NSAttributedString(string: String(count), attributes: attributes)
+    }
+
+    // MARK: - Drawing
+
+    override func drawingRect() -> CGRect {
+        isCollapsed ? super.drawingRect().union(countLabelRect) : super.drawingRect()
+    }
+
+    override func draw(_ rect: CGRect) {
+        super.draw(rect)
+        if isCollapsed, rect.intersects(countLabelRect) {
+            countLabel().draw(in: countLabelRect)
+        }
+    }
+
     // MARK: - Settings
 
     @objc override func graphicSettings() -> [AnyHashable: Any] {
@@ -66,28 +66,35 @@ import AppKit
 
     // MARK: - Geometry
 
-    /// Helper to add a single dot to the path at radius/angle.
-    private func addDot(to path: NSBezierPath, dotSize: CGFloat, radius: CGFloat, angle: CGFloat, controller: GraphicGeometrySource) {
-        var point = CGPoint(x: 0.0, y: radius)
-        point = controller.rotation(of: point, byAngle: Double(angle))
-        let rect = CGRect(x: point.x - (dotSize * 0.5), y: point.y - (dotSize * 0.5), width: dotSize, height: dotSize)
-        path.appendOval(in: rect)
+    /// Helper to add the center of a single dot at radius/angle.
+    private func addDot(to centers: inout [CGPoint], radius: CGFloat, angle: CGFloat, controller: GraphicGeometrySource) {
+        let point = CGPoint(x: 0.0, y: radius)
+        centers.append(controller.rotation(of: point, byAngle: Double(angle)))
     }
 
     /// Recalculate all dot positions based on current state.
+    /// Dot centers are cached and rescaled on resize; the dots themselves keep `dotSize`.
     @objc override func calculateGeometry() {
-        guard let controller = geometryController else {
+        let shape = [Double(angleIncrement), Double(totalCount), Double(count), Double(mean)]
+        let cachedCenters = cachedGeometry(shape: shape) { controller -> [CGPoint] in
+            var centers: [CGPoint] = []
+            let angle = calculateDotAngle(controller: controller)
+            let deviationData = calculateDeviationData()
+            addDeviationDots(to: &centers, angle: angle, deviationData: deviationData, controller: controller)
+            return centers
+        } rescale: { centers, factor in
+            centers.map { CGPoint(x: $0.x * factor, y: $0.y * factor) }
+        }
+        guard let centers = cachedCenters else {
             return
         }
 
         let path = NSBezierPath()
         path.lineWidth = CGFloat(lineWidth)
-
-        let angle = calculateDotAngle(controller: controller)
-        let deviationData = calculateDeviationData()
-
-        addDeviationDots(to: path, angle: angle, deviationData: deviationData, controller: controller)
-
+        let size = CGFloat(dotSize)
+        for point in centers {
+            path.appendOval(in: CGRect(x: point.x - (size * 0.5), y: point.y - (size * 0.5), width: size, height: size))
+        }
         drawingPath = path
     }
 
@@ -121,31 +128,31 @@ import AppKit
         )
     }
 
-    private func addDeviationDots(to path: NSBezierPath, angle: CGFloat, deviationData: DeviationData, controller: GraphicGeometrySource) {
+    private func addDeviationDots(to centers: inout [CGPoint], angle: CGFloat, deviationData: DeviationData, controller: GraphicGeometrySource) {
         if controller.isPercent() {
-            addPercentDeviationDots(to: path, angle: angle, deviationData: deviationData, controller: controller)
+            addPercentDeviationDots(to: &centers, angle: angle, deviationData: deviationData, controller: controller)
         } else {
-            addCountDeviationDots(to: path, angle: angle, deviationData: deviationData, controller: controller)
+            addCountDeviationDots(to: &centers, angle: angle, deviationData: deviationData, controller: controller)
         }
     }
 
-    private func addPercentDeviationDots(to path: NSBezierPath, angle: CGFloat, deviationData: DeviationData, controller: GraphicGeometrySource) {
+    private func addPercentDeviationDots(to centers: inout [CGPoint], angle: CGFloat, deviationData: DeviationData, controller: GraphicGeometrySource) {
         if deviationData.isAboveMean {
-            addExcessPercentDots(to: path, angle: angle, excess: deviationData.excess, controller: controller)
+            addExcessPercentDots(to: &centers, angle: angle, excess: deviationData.excess, controller: controller)
         } else {
-            addShortfallPercentDots(to: path, angle: angle, shortfall: deviationData.shortfall, controller: controller)
+            addShortfallPercentDots(to: &centers, angle: angle, shortfall: deviationData.shortfall, controller: controller)
         }
     }
 
-    private func addCountDeviationDots(to path: NSBezierPath, angle: CGFloat, deviationData: DeviationData, controller: GraphicGeometrySource) {
+    private func addCountDeviationDots(to centers: inout [CGPoint], angle: CGFloat, deviationData: DeviationData, controller: GraphicGeometrySource) {
         if deviationData.isAboveMean {
-            addExcessCountDots(to: path, angle: angle, excess: deviationData.excess, controller: controller)
+            addExcessCountDots(to: &centers, angle: angle, excess: deviationData.excess, controller: controller)
         } else {
-            addShortfallCountDots(to: path, angle: angle, shortfall: deviationData.shortfall, controller: controller)
+            addShortfallCountDots(to: &centers, angle: angle, shortfall: deviationData.shortfall, controller: controller)
         }
     }
 
-    private func addExcessPercentDots(to path: NSBezierPath, angle: CGFloat, excess: Int, controller: GraphicGeometrySource) {
+    private func addExcessPercentDots(to centers: inout [CGPoint], angle: CGFloat, excess: Int, controller: GraphicGeometrySource) {
         guard excess > 0 else {
             return
         }
@@ -153,50 +160,50 @@ import AppKit
         for index in 0 ..< excess {
             let value = Double(Float(index + 1) + floor(mean)) / Double(totalCount)
             let radius = CGFloat(controller.radius(ofPercentValue: value))
-            addDot(to: path, dotSize: CGFloat(dotSize), radius: radius, angle: angle, controller: controller)
+            addDot(to: &centers, radius: radius, angle: angle, controller: controller)
         }
     }
 
-    private func addShortfallPercentDots(to path: NSBezierPath, angle: CGFloat, shortfall: Int, controller: GraphicGeometrySource) {
+    private func addShortfallPercentDots(to centers: inout [CGPoint], angle: CGFloat, shortfall: Int, controller: GraphicGeometrySource) {
         if shortfall > 0 {
             for index in 0 ..< shortfall {
                 let value = Double(Float(Int(ceil(mean)) - (index + 1))) / Double(totalCount)
                 let radius = CGFloat(controller.radius(ofPercentValue: value))
-                addDot(to: path, dotSize: CGFloat(dotSize), radius: radius, angle: angle, controller: controller)
+                addDot(to: &centers, radius: radius, angle: angle, controller: controller)
             }
         } else {
-            addSinglePercentDot(to: path, angle: angle, controller: controller)
+            addSinglePercentDot(to: &centers, angle: angle, controller: controller)
         }
     }
 
-    private func addExcessCountDots(to path: NSBezierPath, angle: CGFloat, excess: Int, controller: GraphicGeometrySource) {
+    private func addExcessCountDots(to centers: inout [CGPoint], angle: CGFloat, excess: Int, controller: GraphicGeometrySource) {
         guard excess > 0 else {
             return
         }
 
         for index in 0 ..< excess {
             let radius = CGFloat(controller.radius(ofCount: Int32(Float(index + 1) + floor(mean))))
-            addDot(to: path, dotSize: CGFloat(dotSize), radius: radius, angle: angle, controller: controller)
+            addDot(to: &centers, radius: radius, angle: angle, controller: controller)
         }
     }
 
-    private func addShortfallCountDots(to path: NSBezierPath, angle: CGFloat, shortfall: Int, controller: GraphicGeometrySource) {
+    private func addShortfallCountDots(to centers: inout [CGPoint], angle: CGFloat, shortfall: Int, controller: GraphicGeometrySource) {
         if shortfall > 0 {
             for index in 0 ..< shortfall {
                 let value = Int32(Int(ceil(mean)) - (index + 1))
                 let radius = CGFloat(controller.radius(ofCount: value))
-                addDot(to: path, dotSize: CGFloat(dotSize), radius: radius, angle: angle, controller: controller)
+                addDot(to: &centers, radius: radius, angle: angle, controller: controller)
             }
         } else {
             // NOTE: Preserving Objective-C behavior that used percent radius call here.
-            addSinglePercentDot(to: path, angle: angle, controller: controller)
+            addSinglePercentDot(to: &centers, angle: angle, controller: controller)
         }
     }
 
-    private func addSinglePercentDot(to path: NSBezierPath, angle: CGFloat, controller: GraphicGeometrySource) {
+    private func addSinglePercentDot(to centers: inout [CGPoint], angle: CGFloat, controller: GraphicGeometrySource) {
         let value = Double(Int(ceil(mean))) / Double(totalCount)
         let radius = CGFloat(controller.radius(ofPercentValue: value))
-        addDot(to: path, dotSize: CGFloat(dotSize), radius: radius, angle: angle, controller: controller)
+        addDot(to: &centers, radius: radius, angle: angle, controller: controller)
     }
 
     // MARK: - Settings
@@ -0,0 +1,132 @@
+//
+// GraphicDotLevelOfDetailTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import AppKit
+import Numerics
+@testable import PaleoRose
+import Testing
+
+@Suite("Dot plot level of detail")
+struct GraphicDotLevelOfDetailTests {
+
+    // MARK: - Test Setup
+
+    /// The dots as they were built before batching: one radius and one rotation per dot.
+    private func perDotPath(
+        controller: XRGeometryController,
+        increment: Int,
+        count: Int,
+        total: Int,
+        dotSize: CGFloat = 4
+    ) -> NSBezierPath {
+        let path = NSBezierPath()
+        let angle = CGFloat(controller.startingAngle()) + CGFloat(controller.sectorSize()) * (CGFloat(increment) + 0.5)
+        for index in 0 ..< count {
+            let radius = controller.isPercent()
+                ? CGFloat(controller.radius(ofPercentValue: Double(CGFloat(index + 1) / CGFloat(total))))
+                : CGFloat(controller.radius(ofCount: Int32(index)))
+            let point = controller.rotation(of: CGPoint(x: 0.0, y: radius), byAngle: Double(angle))
+            let half = dotSize * 0.5
+            path.appendOval(in: CGRect(x: point.x - half, y: point.y - half, width: dotSize, height: dotSize))
+        }
+        return path
+    }
+
+    // MARK: - Tests
+
+    @Test(
+        "Dots that do not touch are built exactly as one rotation per dot builds them",
+        arguments: [false, true], [false, true]
+    )
+    func separatedDotsMatchPerDotPath(isPercent: Bool, isEqualArea: Bool) throws {
+        let controller = XRGeometryController.laidOutStub(isPercent: isPercent, isEqualArea: isEqualArea, width: 2000)
+
+        for increment in [0, 7, 20, 35] {
+            let dot = try #require(
+                GraphicDot(controller: controller, forIncrement: Int32(increment), valueCount: 10, totalCount: 100)
+            )
+            let expected = perDotPath(controller: controller, increment: increment, count: 10, total: 100)
+
+            #expect(!dot.isCollapsed)
+            #expect(try #require(dot.drawingPath).getPoints() == expected.getPoints())
+            #expect(dot.drawingRect() == expected.bounds)
+        }
+    }
+
+    @Test("Dots that would overlap collapse into one bar covering the same span")
+    func overlappingDotsCollapse() throws {
+        let controller = XRGeometryController.laidOutStub(width: 300)
+        let dot = try #require(GraphicDot(controller: controller, forIncrement: 4, valueCount: 40, totalCount: 400))
+        let dots = perDotPath(controller: controller, increment: 4, count: 40, total: 400)
+
+        #expect(dot.isCollapsed)
+        let bounds = try #require(dot.drawingPath).bounds
+        #expect(bounds.minX.isApproximatelyEqual(to: dots.bounds.minX, absoluteTolerance: 0.01))
+        #expect(bounds.minY.isApproximatelyEqual(to: dots.bounds.minY, absoluteTolerance: 0.01))
+        #expect(bounds.maxX.isApproximatelyEqual(to: dots.bounds.maxX, absoluteTolerance: 0.01))
+        #expect(bounds.maxY.isApproximatelyEqual(to: dots.bounds.maxY, absoluteTolerance: 0.01))
+        // The count label lies past the outer end of the bar
+        #expect(dot.drawingRect().contains(bounds))
+        #expect(dot.drawingRect() != bounds)
+    }
+
+    @Test("Enlarging the plot until the dots separate restores the individual dots")
+    func resizeSeparatesDots() throws {
+        let controller = XRGeometryController.laidOutStub(width: 300)
+        let dot = try #require(GraphicDot(controller: controller, forIncrement: 2, valueCount: 12, totalCount: 100))
+        #expect(dot.isCollapsed)
+
+        controller.resetGeometry(withBoundsRect: NSRect(x: 0, y: 0, width: 3000, height: 3000))
+        dot.calculateGeometry()
+
+        #expect(!dot.isCollapsed)
+        let expected = perDotPath(controller: controller, increment: 2, count: 12, total: 100)
+        #expect(try #require(dot.drawingPath).getPoints() == expected.getPoints())
+    }
+
+    @Test(
+        "Benchmark dot plot geometry for 1k, 100k and 1M dots",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkDotCounts() throws {
+        let controller = XRGeometryController.laidOutStub(maxCount: 1_000_000)
+
+        for count: Int32 in [1000, 100_000, 1_000_000] {
+            let perDot = Benchmark.measure("per-dot path, \(count) dots") {
+                _ = perDotPath(controller: controller, increment: 3, count: Int(count), total: Int(count))
+            }
+            let current = try Benchmark.measure("GraphicDot, \(count) dots") {
+                _ = try #require(
+                    GraphicDot(controller: controller, forIncrement: 3, valueCount: count, totalCount: count)
+                )
+            }
+            let speedup = Benchmark.seconds(perDot) / Benchmark.seconds(current)
+            print("[benchmark] dot plot speedup at \(count) dots \(speedup)x")
+        }
+    }
+}
@@ -0,0 +1,176 @@
+//
+// GraphicGeometryCacheTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import AppKit
+import Numerics
+@testable import PaleoRose
+import Testing
+
+@Suite("Graphic geometry cache")
+struct GraphicGeometryCacheTests {
+
+    enum Kind: CaseIterable {
+        case petal
+        case histogram
+        case kite
+        case dotDeviation
+        case line
+    }
+
+    // MARK: - Test Setup
+
+    private let sectorCount = 36
+    private let counts: [Int32] = (0 ..< 36).map { Int32(($0 * 17) % 40 + 1) }
+
+    private func makeGraphics(_ kind: Kind, controller: XRGeometryController) throws -> [Graphic] {
+        switch kind {
+        case .petal:
+            return try counts.enumerated().map { index, count in
+                try #require(GraphicPetal(controller: controller, forIncrement: Int32(index), forValue: NSNumber(value: count)))
+            }
+
+        case .histogram:
+            return counts.enumerated().map { index, count in
+                GraphicHistogram(controller: controller, forIncrement: Int32(index), forValue: NSNumber(value: count))
+            }
+
+        case .kite:
+            let angles = (0 ..< sectorCount).map { Double($0) * 10 + 10 }
+            return try [#require(GraphicKite(controller: controller, angles: angles, values: counts.map(Double.init)))]
+
+        case .dotDeviation:
+            return try counts.enumerated().map { index, count in
+                try #require(GraphicDotDeviation(
+                    controller: controller,
+                    forIncrement: Int32(index),
+                    valueCount: count,
+                    totalCount: counts.reduce(0, +),
+                    statistics: ["mean": NSNumber(value: 20.5)]
+                ))
+            }
+
+        case .line:
+            return (0 ..< sectorCount).map { index in
+                let line = GraphicLine(controller: controller)
+                line.showTick = true
+                line.tickType = index % 3 == 0 ? GraphicLineTickType.major.rawValue : GraphicLineTickType.minor.rawValue
+                line.spokeAngle = Float(index) * 10
+                return line
+            }
+        }
+    }
+
+    private func expectSamePaths(_ cached: [Graphic], _ fresh: [Graphic]) throws {
+        #expect(cached.count == fresh.count)
+        for (lhs, rhs) in zip(cached, fresh) {
+            let cachedPoints = try #require(lhs.drawingPath).getPoints()
+            let freshPoints = try #require(rhs.drawingPath).getPoints()
+            #expect(cachedPoints.count == freshPoints.count)
+            for (point, expected) in zip(cachedPoints, freshPoints) {
+                #expect(point.x.isApproximatelyEqual(to: expected.x, absoluteTolerance: 1e-9))
+                #expect(point.y.isApproximatelyEqual(to: expected.y, absoluteTolerance: 1e-9))
+            }
+        }
+    }
+
+    // MARK: - Tests
+
+    @Test("A resize rescales the cached geometry to the paths a fresh build produces", arguments: Kind.allCases, [false, true])
+    func resizeMatchesFreshBuild(kind: Kind, isPercent: Bool) throws {
+        let controller = XRGeometryController.laidOutStub(isPercent: isPercent)
+        let graphics = try makeGraphics(kind, controller: controller)
+        let misses = graphics.map(\.geometryCacheMisses)
+
+        for width in [900.0, 250.0, 613.0] {
+            controller.resetGeometry(withBoundsRect: NSRect(x: 0, y: 0, width: width, height: width))
+            graphics.forEach { $0.calculateGeometry() }
+            try expectSamePaths(graphics, makeGraphics(kind, controller: controller))
+        }
+
+        #expect(graphics.map(\.geometryCacheMisses) == misses)
+        #expect(graphics.allSatisfy { $0.geometryCacheHits >= 3 })
+    }
+
+    @Test("Changing anything other than the circle size rebuilds the geometry", arguments: Kind.allCases)
+    func geometryChangeRebuilds(kind: Kind) throws {
+        let controller = XRGeometryController.laidOutStub()
+        let graphics = try makeGraphics(kind, controller: controller)
+        let misses = graphics.map(\.geometryCacheMisses)
+
+        controller.setHollowCoreSize(0.4)
+        graphics.forEach { $0.calculateGeometry() }
+
+        #expect(zip(graphics, misses).allSatisfy { $0.geometryCacheMisses == $1 + 1 })
+        try expectSamePaths(graphics, makeGraphics(kind, controller: controller))
+    }
+
+    @Test("Dot deviation dots keep their size when the plot is resized")
+    func dotSizeIsNotScaled() throws {
+        let controller = XRGeometryController.laidOutStub()
+        // One count above a mean of 20.5 gives a single dot.
+        let dot = try #require(GraphicDotDeviation(
+            controller: controller,
+            forIncrement: 3,
+            valueCount: 21,
+            totalCount: 100,
+            statistics: ["mean": NSNumber(value: 20.5)]
+        ))
+
+        controller.resetGeometry(withBoundsRect: NSRect(x: 0, y: 0, width: 1800, height: 1800))
+        dot.calculateGeometry()
+
+        let bounds = try #require(dot.drawingPath).bounds
+        #expect(dot.geometryCacheHits == 1)
+        #expect(bounds.width.isApproximatelyEqual(to: CGFloat(dot.dotSize), absoluteTolerance: 1e-6))
+        #expect(bounds.height.isApproximatelyEqual(to: CGFloat(dot.dotSize), absoluteTolerance: 1e-6))
+    }
+
+    @Test(
+        "Benchmark full plot regeneration under resize",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkResize() throws {
+        let controller = XRGeometryController.laidOutStub()
+        let widths = (0 ..< 200).map { 300.0 + Double($0) * 2.5 }
+        let graphics = try Kind.allCases.flatMap { try makeGraphics($0, controller: controller) }
+
+        let rebuilt = try Benchmark.measure("rebuild \(graphics.count) graphics x \(widths.count) resizes") {
+            for width in widths {
+                controller.resetGeometry(withBoundsRect: NSRect(x: 0, y: 0, width: width, height: width))
+                _ = try Kind.allCases.flatMap { try makeGraphics($0, controller: controller) }
+            }
+        }
+        let rescaled = Benchmark.measure("rescale \(graphics.count) graphics x \(widths.count) resizes") {
+            for width in widths {
+                controller.resetGeometry(withBoundsRect: NSRect(x: 0, y: 0, width: width, height: width))
+                graphics.forEach { $0.calculateGeometry() }
+            }
+        }
+        print("[benchmark] geometry cache speedup \(Benchmark.seconds(rebuilt) / Benchmark.seconds(rescaled))x")
+    }
+}
@@ -34,4 +34,8 @@
 - (double)radiusOfRelativePercent:(double)percent;
 - (CGFloat)unrestrictedRadiusOfRelativePercent:(double)percent;
 
+@optional
+// radiusOfRelativePercent: of every percent in one call, for graphics with many radii such as dot plots
+- (void)getRadii:(double *)radii ofRelativePercents:(const double *)percents count:(NSUInteger)count;
+
 @end
@@ -58,10 +58,12 @@ import AppKit
     // MARK: - Geometry Calculation
 
     @objc override func calculateGeometry() {
-        guard let controller = geometryController else {
-            return
-        }
+        let shape = [Double(histIncrement), Double(percent), Double(count)]
+        drawingPath = cachedPath(shape: shape, build: makePath)
+        drawingPath?.lineWidth = CGFloat(lineWidth)
+    }
 
+    private func makePath(_ controller: GraphicGeometrySource) -> NSBezierPath {
         let size = Float(controller.sectorSize())
         let start = Float(controller.startingAngle())
         let isPercent = controller.isPercent()
@@ -69,7 +71,7 @@ import AppKit
         var angle1 = (Float(histIncrement) * size) + (0.5 * size) + start
         angle1 = restrictAngle(toACircle: angle1)
 
-        drawingPath = NSBezierPath()
+        let path = NSBezierPath()
 
         // Calculate start point (center)
         let startRadius = isPercent ?
@@ -77,7 +79,7 @@ import AppKit
             CGFloat(controller.radius(ofCount: 0))
         let startPoint = CGPoint(x: 0.0, y: startRadius)
         let startTargetPoint = controller.rotation(of: startPoint, byAngle: Double(angle1))
-        drawingPath?.move(to: startTargetPoint)
+        path.move(to: startTargetPoint)
 
         // Calculate end point (data value)
         let endRadius = isPercent ?
@@ -85,9 +87,8 @@ import AppKit
             CGFloat(controller.radius(ofCount: Int32(count)))
         let endPoint = CGPoint(x: 0.0, y: endRadius)
         let endTargetPoint = controller.rotation(of: endPoint, byAngle: Double(angle1))
-        drawingPath?.line(to: endTargetPoint)
-
-        drawingPath?.lineWidth = CGFloat(lineWidth)
+        path.line(to: endTargetPoint)
+        return path
     }
 
     // MARK: - Settings Export
@@ -56,34 +56,36 @@ import AppKit
 
     @objc override func calculateGeometry() {
         precondition(angles.count == values.count, "angles and values must match")
-        let path = NSBezierPath()
-        drawingPath = path
-        drawKiteOutline()
-        drawHollowCoreIfNeeded()
+        drawingPath = cachedPath(shape: angles + values) { _ in
+            let path = NSBezierPath()
+            drawKiteOutline(in: path)
+            drawHollowCoreIfNeeded(in: path)
+            return path
+        }
     }
 
-    private func drawKiteOutline() {
+    private func drawKiteOutline(in path: NSBezierPath) {
         guard let lastValue = values.last, let lastAngle = angles.last else {
             return
         }
         var radius = radiusForValue(lastValue)
         let startPoint = point(radius: radius, atAngle: lastAngle)
-        drawingPath?.move(to: startPoint)
+        path.move(to: startPoint)
         for index in 0 ..< angles.count {
             radius = radiusForValue(values[index])
             let point = point(radius: radius, atAngle: angles[index])
-            drawingPath?.line(to: point)
+            path.line(to: point)
         }
     }
 
-    private func drawHollowCoreIfNeeded() {
+    private func drawHollowCoreIfNeeded(in path: NSBezierPath) {
         guard let controller = geometryController, controller.hollowCoreSize() > 0.0 else {
             return
         }
         let radius = radiusForValue(0.0)
         let centroid = CGPoint.zero
         let coreRect = CGRect(x: centroid.x - radius, y: centroid.y - radius, width: radius * 2.0, height: radius * 2.0)
-        drawingPath?.appendOval(in: coreRect)
+        path.appendOval(in: coreRect)
     }
 
     private func point(radius: Double, atAngle angle: Double) -> CGPoint {
@@ -162,21 +162,24 @@ import AppKit
     // MARK: - Geometry Calculation
 
     @objc override func calculateGeometry() {
-        guard let controller = geometryController else {
+        guard geometryController != nil else {
             return
         }
 
-        drawingPath = NSBezierPath()
-
-        // Calculate line from center to outer point
-        let innerRadius = CGFloat(controller.radius(ofRelativePercent: 0.0))
-        let outerRadius = calculateOuterRadius()
+        let shape = [Double(spokeAngle), Double(relativePercent), showTick ? 1 : 0, Double(tickTypeEnum.rawValue)]
+        drawingPath = cachedPath(shape: shape) { controller in
+            // Calculate line from center to outer point
+            let innerRadius = CGFloat(controller.radius(ofRelativePercent: 0.0))
+            let outerRadius = calculateOuterRadius()
 
-        let innerPoint = pointAtRadius(innerRadius, angle: CGFloat(spokeAngle))
-        let outerPoint = pointAtRadius(outerRadius, angle: CGFloat(spokeAngle))
+            let innerPoint = pointAtRadius(innerRadius, angle: CGFloat(spokeAngle))
+            let outerPoint = pointAtRadius(outerRadius, angle: CGFloat(spokeAngle))
 
-        drawingPath?.move(to: innerPoint)
-        drawingPath?.line(to: outerPoint)
+            let path = NSBezierPath()
+            path.move(to: innerPoint)
+            path.line(to: outerPoint)
+            return path
+        }
         drawingPath?.lineWidth = CGFloat(lineWidth)
 
         calculateLabelTransform()
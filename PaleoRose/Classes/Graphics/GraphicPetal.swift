@@ -78,10 +78,15 @@ import AppKit
 
     /// Recalculate geometry when external changes require it.
     @objc override func calculateGeometry() {
-        guard let controller = geometryController else {
+        let shape = [Double(petalIncrement), Double(percent), Double(count)]
+        guard let path = cachedPath(shape: shape, build: makePath) else {
             return
         }
+        path.lineWidth = CGFloat(lineWidth)
+        drawingPath = path
+    }
 
+    private func makePath(_ controller: GraphicGeometrySource) -> NSBezierPath {
         // step 1. find the angles
         let size = CGFloat(controller.sectorSize())
         let start = CGFloat(controller.startingAngle())
@@ -133,8 +138,7 @@ import AppKit
             endAngle: angle1Canvas,
             clockwise: false
         )
-
-        drawingPath = path
+        return path
     }
 
     /// Returns the graphic's settings merged with superclass settings.
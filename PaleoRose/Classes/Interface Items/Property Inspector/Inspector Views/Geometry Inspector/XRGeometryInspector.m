@@ -176,6 +176,8 @@
 		[_sectorCount setIntValue:count];
 		[_countStepper setIntValue:count];
 	}
+	//the sector count and a clamped start angle are counted once
+	[_object beginGeometryChanges];
 	[_object setSectorCount:[_sectorCount intValue]];
 	[_startAngleStepper setMaxValue:[_sectorAngle floatValue]];
 	if([_startAngleTextBox floatValue]>[_startAngleStepper maxValue])
@@ -184,6 +186,7 @@
 		[_startAngleTextBox setFloatValue:[_startAngleStepper floatValue]];
 		[_object setStartingAngle:[_startAngleStepper floatValue]];
 	}
+	[_object endGeometryChanges];
 	
 }
 
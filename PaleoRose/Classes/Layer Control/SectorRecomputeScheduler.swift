@@ -0,0 +1,242 @@
+//
+// SectorRecomputeScheduler.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import Foundation
+
+/// Recounts data layer sectors off the main thread when the rose geometry changes.
+///
+/// Layers ask to be recomputed from their `XRGeometryDidChangeSectors` handler. Requests made during one
+/// pass of the main run loop are coalesced into a batch, and the geometry is read once when the batch
+/// starts. The O(n) work — the sector histogram and the circular resultant behind the statistics — runs
+/// on `queue` with one operation per data set, so layers sharing a set do not count it twice. When the
+/// whole batch has finished, the histograms are applied to every layer in one main-queue pass, so the
+/// view never shows a mix of old and new sectors.
+///
+/// Starting a batch while another is in flight cancels the older one: its layers are folded into the
+/// new batch and its results are dropped, so dragging a geometry control only publishes the last value.
+@objc final class SectorRecomputeScheduler: NSObject {
+
+    struct Geometry: Equatable {
+        let startAngle: Float
+        let sectorSize: Float
+        let sectorCount: Int32
+
+        init(startAngle: Float, sectorSize: Float, sectorCount: Int32) {
+            self.startAngle = startAngle
+            self.sectorSize = sectorSize
+            self.sectorCount = sectorCount
+        }
+
+        init(_ controller: XRGeometryController) {
+            self.init(
+                startAngle: controller.startingAngle(),
+                sectorSize: controller.sectorSize(),
+                sectorCount: controller.sectorCount()
+            )
+        }
+    }
+
+    struct Statistics: Equatable {
+        var batches = 0
+        var published = 0
+        var cancelled = 0
+        var layersPublished = 0
+    }
+
+    /// Histograms for one batch, keyed by layer. Filled from the queue, read on the main thread.
+    final class Results {
+        private let lock = NSLock()
+        private var histograms: [ObjectIdentifier: XRSectorHistogram] = [:]
+
+        subscript(layer: XRLayerData) -> XRSectorHistogram? {
+            lock.lock()
+            defer { lock.unlock() }
+            return histograms[ObjectIdentifier(layer)]
+        }
+
+        var count: Int {
+            lock.lock()
+            defer { lock.unlock() }
+            return histograms.count
+        }
+
+        fileprivate func store(_ histogram: XRSectorHistogram, for layer: XRLayerData) {
+            lock.lock()
+            defer { lock.unlock() }
+            histograms[ObjectIdentifier(layer)] = histogram
+        }
+    }
+
+    private static let schedulers = NSMapTable<XRGeometryController, SectorRecomputeScheduler>.weakToStrongObjects()
+
+    /// The scheduler shared by every layer drawn with `controller`. Main thread only.
+    @objc(schedulerForGeometryController:)
+    static func scheduler(for controller: XRGeometryController) -> SectorRecomputeScheduler {
+        if let scheduler = schedulers.object(forKey: controller) {
+            return scheduler
+        }
+        let scheduler = SectorRecomputeScheduler(geometryController: controller)
+        schedulers.setObject(scheduler, forKey: controller)
+        return scheduler
+    }
+
+    let queue: OperationQueue
+    private(set) var statistics = Statistics()
+
+    private weak var geometryController: XRGeometryController?
+    private var pending: [XRLayerData] = []
+    private var inFlight: [XRLayerData] = []
+    private var generation = 0
+    private var isFlushScheduled = false
+
+    init(
+        geometryController: XRGeometryController?,
+        maxConcurrentOperationCount: Int = ProcessInfo.processInfo.activeProcessorCount
+    ) {
+        self.geometryController = geometryController
+        queue = OperationQueue()
+        queue.name = "PaleoRose.SectorRecompute"
+        queue.qualityOfService = .userInitiated
+        queue.maxConcurrentOperationCount = maxConcurrentOperationCount
+        super.init()
+    }
+
+    /// True while a batch is waiting to start or to be published.
+    var isBusy: Bool {
+        !pending.isEmpty || !inFlight.isEmpty
+    }
+
+    /// Adds `layer` to the next batch, which starts on the next pass of the main run loop.
+    @objc(scheduleLayer:)
+    func schedule(_ layer: XRLayerData) {
+        if !pending.contains(where: { $0 === layer }) {
+            pending.append(layer)
+        }
+        guard !isFlushScheduled else {
+            return
+        }
+        isFlushScheduled = true
+        DispatchQueue.main.async { [weak self] in
+            self?.flush()
+        }
+    }
+
+    /// Starts the coalesced batch now rather than on the next pass of the run loop.
+    @objc func flush() {
+        isFlushScheduled = false
+        guard !pending.isEmpty, let geometryController else {
+            return
+        }
+        if !inFlight.isEmpty {
+            queue.cancelAllOperations()
+            statistics.cancelled += 1
+        }
+        let layers = inFlight + pending.filter { layer in !inFlight.contains { $0 === layer } }
+        pending = []
+        inFlight = layers
+        generation += 1
+        statistics.batches += 1
+
+        let batch = generation
+        let results = Results()
+        let publish = BlockOperation {
+            DispatchQueue.main.async { [weak self] in
+                self?.publish(results, batch: batch)
+            }
+        }
+        let operations = makeOperations(for: layers, geometry: Geometry(geometryController), results: results)
+        operations.forEach(publish.addDependency)
+        queue.addOperations(operations + [publish], waitUntilFinished: false)
+    }
+
+    /// Counts every layer's sectors on the queue and waits for them, without publishing.
+    /// Used by tests and benchmarks; must not be called while a batch is in flight.
+    func computeHistograms(for layers: [XRLayerData], geometry: Geometry) -> Results {
+        let results = Results()
+        queue.addOperations(makeOperations(for: layers, geometry: geometry, results: results), waitUntilFinished: true)
+        return results
+    }
+
+    // MARK: - Private
+
+    /// One operation per data set; its layers are visited in order so each direction is counted once.
+    private func makeOperations(for layers: [XRLayerData], geometry: Geometry, results: Results) -> [Operation] {
+        var groups: [ObjectIdentifier: (dataSet: XRDataSet, layers: [(layer: XRLayerData, biDir: Bool)])] = [:]
+        var order: [ObjectIdentifier] = []
+        for layer in layers {
+            guard let dataSet = layer.dataSet() else {
+                continue
+            }
+            let key = ObjectIdentifier(dataSet)
+            if groups[key] == nil {
+                groups[key] = (dataSet: dataSet, layers: [])
+                order.append(key)
+            }
+            groups[key]?.layers.append((layer: layer, biDir: layer.isBiDirectional()))
+        }
+
+        return order.compactMap { groups[$0] }.map { group in
+            let operation = BlockOperation()
+            operation.addExecutionBlock { [unowned operation] in
+                for entry in group.layers {
+                    guard !operation.isCancelled else {
+                        return
+                    }
+                    let histogram = group.dataSet.sectorHistogram(
+                        withStartAngle: geometry.startAngle,
+                        sectorSize: geometry.sectorSize,
+                        sectorCount: geometry.sectorCount,
+                        biDir: entry.biDir
+                    )
+                    // Warms the running sums the statistics are built from when the batch is applied,
+                    // unless the counts came from the store and the values were never read
+                    if group.dataSet.hasLoadedValues() {
+                        _ = group.dataSet.circularResultant(entry.biDir)
+                    }
+                    if let histogram {
+                        results.store(histogram, for: entry.layer)
+                    }
+                }
+            }
+            return operation
+        }
+    }
+
+    private func publish(_ results: Results, batch: Int) {
+        // A newer batch has started, or is about to start and will include these layers
+        guard batch == generation, pending.isEmpty else {
+            return
+        }
+        let layers = inFlight
+        inFlight = []
+        for layer in layers {
+            layer.applySectorHistogram(results[layer])
+        }
+        statistics.published += 1
+        statistics.layersPublished += layers.count
+    }
+}
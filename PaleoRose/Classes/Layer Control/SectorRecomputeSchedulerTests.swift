@@ -0,0 +1,152 @@
+//
+// SectorRecomputeSchedulerTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import Foundation
+@testable import PaleoRose
+import Testing
+
+@MainActor
+@Suite("SectorRecomputeScheduler", .serialized)
+struct SectorRecomputeSchedulerTests {
+
+    // MARK: - Test Setup
+
+    private func buildLayers(
+        controller: XRGeometryController,
+        dataSets: [XRDataSet]
+    ) throws -> [XRLayerData] {
+        try dataSets.map { try #require(XRLayerData(geometryController: controller, with: $0)) }
+    }
+
+    private func waitUntilIdle(_ scheduler: SectorRecomputeScheduler) async throws {
+        let deadline = ContinuousClock.now + .seconds(10)
+        while scheduler.isBusy, ContinuousClock.now < deadline {
+            try await Task.sleep(for: .milliseconds(5))
+        }
+        #expect(!scheduler.isBusy)
+    }
+
+    private func expectCounts(
+        of layers: [XRLayerData],
+        match geometry: SectorRecomputeScheduler.Geometry
+    ) throws {
+        for layer in layers {
+            let histogram = try #require(layer.dataSet().sectorHistogram(
+                withStartAngle: geometry.startAngle,
+                sectorSize: geometry.sectorSize,
+                sectorCount: geometry.sectorCount,
+                biDir: layer.isBiDirectional()
+            ))
+            #expect(layer.maxCount() == histogram.maxCount)
+            #expect(layer.totalCount() == histogram.totalCount)
+        }
+    }
+
+    // MARK: - Tests
+
+    @Test("Sector changes in one run loop pass are published as a single batch")
+    func coalescesSectorChanges() async throws {
+        let controller = XRGeometryController.stub(sectorSize: 10, sectorCount: 36)
+        let dataSets = try (0 ..< 4).map { try XRDataSet.stub(count: 5000, seed: $0) }
+        let layers = try buildLayers(controller: controller, dataSets: dataSets)
+        let scheduler = SectorRecomputeScheduler.scheduler(for: controller)
+
+        controller.setSectorCount(12)
+        controller.setStartingAngle(5)
+        try await waitUntilIdle(scheduler)
+
+        #expect(scheduler.statistics.batches == 1)
+        #expect(scheduler.statistics.published == 1)
+        #expect(scheduler.statistics.layersPublished == layers.count)
+        try expectCounts(of: layers, match: .init(startAngle: 5, sectorSize: 30, sectorCount: 12))
+    }
+
+    @Test("A newer batch cancels the one in flight and only the last geometry is published")
+    func cancelsStaleBatch() async throws {
+        let controller = XRGeometryController.stub(sectorSize: 10, sectorCount: 36)
+        let dataSets = try (0 ..< 3).map { try XRDataSet.stub(count: 5000, seed: $0) }
+        let layers = try buildLayers(controller: controller, dataSets: dataSets)
+        let scheduler = SectorRecomputeScheduler.scheduler(for: controller)
+
+        controller.setSectorCount(18)
+        scheduler.flush()
+        controller.setSectorCount(8)
+        scheduler.flush()
+        try await waitUntilIdle(scheduler)
+
+        #expect(scheduler.statistics.batches == 2)
+        #expect(scheduler.statistics.cancelled == 1)
+        #expect(scheduler.statistics.published == 1)
+        try expectCounts(of: layers, match: .init(startAngle: 0, sectorSize: 45, sectorCount: 8))
+    }
+
+    @Test("Layers sharing a data set each get the histogram for their own direction")
+    func sharedDataSet() throws {
+        let controller = XRGeometryController.stub(sectorSize: 10, sectorCount: 36)
+        let dataSet = try XRDataSet.stub(count: 5000, seed: 1)
+        let layers = try buildLayers(controller: controller, dataSets: [dataSet, dataSet])
+        layers[1].setBiDirectional(true)
+        let scheduler = SectorRecomputeScheduler(geometryController: controller)
+        let geometry = SectorRecomputeScheduler.Geometry(startAngle: 3, sectorSize: 20, sectorCount: 18)
+
+        let results = scheduler.computeHistograms(for: layers, geometry: geometry)
+
+        let unidirectional = try #require(results[layers[0]])
+        let bidirectional = try #require(results[layers[1]])
+        #expect(results.count == 2)
+        #expect(bidirectional.totalCount == 2 * unidirectional.totalCount)
+    }
+
+    @Test(
+        "Benchmark sector recomputation across threads",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkThreadScaling() throws {
+        let controller = XRGeometryController.stub(sectorSize: 10, sectorCount: 36)
+        let dataSets = try (0 ..< 20).map { try XRDataSet.stub(count: 500_000, seed: $0) }
+        let layers = try buildLayers(controller: controller, dataSets: dataSets)
+        let cores = ProcessInfo.processInfo.activeProcessorCount
+        let widths = Array(Set([1, 2, 4, 8, cores].filter { $0 <= cores })).sorted()
+
+        var startAngle: Float = 0
+        var serial: Duration?
+        for width in widths {
+            let scheduler = SectorRecomputeScheduler(geometryController: controller, maxConcurrentOperationCount: width)
+            let elapsed = Benchmark.measure("20 layers x 500k values, \(width) thread(s)") {
+                // A new start angle each run, off the 0.01 degree bin edges for the first 100 runs, so every
+                // histogram is counted from the values rather than taken from the cache or the fine-angle counts
+                startAngle += 0.1237
+                let geometry = SectorRecomputeScheduler.Geometry(startAngle: startAngle, sectorSize: 10, sectorCount: 36)
+                _ = scheduler.computeHistograms(for: layers, geometry: geometry)
+            }
+            let baseline = serial ?? elapsed
+            serial = baseline
+            print("[benchmark] \(width) thread(s): \(Benchmark.seconds(baseline) / Benchmark.seconds(elapsed))x")
+        }
+    }
+}
@@ -74,9 +74,12 @@
 -(NSImage *)colorImage;
 -(void)generateGraphics;
 -(void)drawRect:(NSRect)rect;
+-(NSArray *)graphicalObjects;
 //notification responses.. implemented by subclasses
 -(void)geometryDidChange:(NSNotification *)notification;
 -(void)geometryDidChangePercent:(NSNotification *)notification;
+//only the plot moved or was resized; rebuilds the graphics unless a subclass can rescale them
+-(void)geometryDidChangeBounds;
 -(int)maxCount;
 -(float)maxPercent;
 -(void)setLineWeight:(float)lineWeight;
@@ -288,13 +288,27 @@
 {
 }
 
+//what drawRect: draws from; for exporters that walk the graphics instead of drawing them
+-(NSArray *)graphicalObjects
+{
+	return [NSArray arrayWithArray:_graphicalObjects];
+}
+
 -(void)geometryDidChange:(NSNotification *)notification
 {
-	[self generateGraphics];
+	if([XRGeometryController changeOfNotification:notification] == XRGeometryChangeBounds)
+		[self geometryDidChangeBounds];
+	else
+		[self generateGraphics];
 
 	[[NSNotificationCenter defaultCenter] postNotificationName:XRLayerRequiresRedraw object:self];
 }
 
+-(void)geometryDidChangeBounds
+{
+	[self generateGraphics];
+}
+
 -(void)geometryDidChangePercent:(NSNotification *)notification
 {
 	[self generateGraphics];
@@ -38,6 +38,7 @@
 #define XRLayerDataDefaultKeyType @"XRLayerDataDefaultKeyType"
 #define XRLayerDataStatisticsDidChange @"XRLayerDataStatisticsDidChange"
 @class XRDataSet;
+@class XRSectorHistogram;
 @interface XRLayerData : XRLayer {
 	XRDataSet *_theSet;
 	int _datasetId;  // Stored separately so we can find the dataset before _theSet is set
@@ -69,6 +70,9 @@
 -(void)setPlotType:(int)newType;
 -(int)plotType;
 -(void)calculateSectorValues;
+-(void)calculateSectorValuesWithHistogram:(XRSectorHistogram *)histogram;
+//main thread only; used by SectorRecomputeScheduler to publish a batch
+-(void)applySectorHistogram:(XRSectorHistogram *)histogram;
 -(int)totalCount;
 -(void)setDotRadius:(float)radius;
 -(float)dotRadius;
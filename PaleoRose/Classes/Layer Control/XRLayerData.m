@@ -30,6 +30,7 @@
 #import "XRDataSet.h"
 #import "XRGeometryController.h"
 #import "XRStatistic.h"
+#import "XRSectorHistogram.h"
 #import <PaleoRose-Swift.h>
 
 @implementation XRLayerData
@@ -51,6 +52,7 @@
 	if(self)
 	{
 		_theSet = aSet; //note: not retained by this object
+		[self observeDataSet:_theSet];
 		if(_theSet)
 			[self setLayerName:[aSet name]];
 		_sectorValues = [[NSMutableArray alloc] init];
@@ -77,6 +79,7 @@
 		
 		
 		_theSet = aSet; //note: not retained by this object
+		[self observeDataSet:_theSet];
 		//[self setLayerName:[aSet name]];
 		_sectorValues = [[NSMutableArray alloc] init];
 		_sectorValuesCount = [[NSMutableArray alloc] init];
@@ -154,15 +157,14 @@
 
 -(void)calculateSectorValues
 {
-	float angle1,angle2,sectorSize,startAngle;
-	int sectorCount,aCount,maxCount,totalCount;
-	//NSLog(@"calculate values");
-	
-	sectorSize = [geometryController sectorSize];
-	startAngle = [geometryController startingAngle];
-	//NSLog(@"size %f angle %f",sectorSize,startAngle);
-	sectorCount = [geometryController sectorCount];
-	//NSLog(@"count %f %f",(double)sectorCount,((double)360.0/(double)sectorSize));
+	//one pass over the data set for all sectors; shared with the chi-squared and mean count statistics
+	XRSectorHistogram *histogram = [_theSet sectorHistogramWithStartAngle:[geometryController startingAngle] sectorSize:[geometryController sectorSize] sectorCount:[geometryController sectorCount] biDir:_isBiDir];
+	[self calculateSectorValuesWithHistogram:histogram];
+}
+
+-(void)calculateSectorValuesWithHistogram:(XRSectorHistogram *)histogram
+{
+	int maxCount,totalCount;
 	
 	[_sectorValues removeAllObjects];
 	[_sectorValuesCount removeAllObjects];
@@ -171,27 +173,9 @@
 	//NSLog(@"count %i",sectorCount);
 	if(!_theSet)
 		return;
-	for(int i = 0;i<sectorCount; i++)
-	{
-		angle1 = ((float)i * sectorSize) + startAngle;
-
-		angle2 = angle1 + sectorSize;
-
-		if(angle1 >= 360.0)
-			angle1 = angle1- 360.0;
-		if(angle2 >= 360.0)
-			angle2 = angle2- 360.0;
-		//NSLog(@"calculate values0.1");
-		aCount = [_theSet valueCountFromAngle:angle1 toAngle2:angle2 biDir:_isBiDir];
-		//NSLog(@"calculate values %i", aCount);
-		if(aCount>maxCount)
-			maxCount = aCount;
-		totalCount += aCount;
-		//NSLog(@"calculate values %i", totalCount);
-		[_sectorValuesCount addObject:[NSNumber numberWithInt:aCount]];
-
-		
-	}
+	maxCount = [histogram maxCount];
+	totalCount = [histogram totalCount];
+	[_sectorValuesCount addObjectsFromArray:[histogram countArray]];
 	//NSLog(@"calculate values1");
 	_totalCount = totalCount;
 	_maxCount = maxCount;
@@ -419,12 +403,42 @@
 }
 
 
--(void)geometryDidChangeSectors:(NSNotification *)notification
+-(void)observeDataSet:(XRDataSet *)aSet
+{
+	if(aSet)
+		[[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(dataSetDidAppendValues:) name:XRDataSetDidAppendValuesNotification object:aSet];
+}
+
+//the data set keeps its histograms and vector sums current, so this does not rescan its values
+-(void)dataSetDidAppendValues:(NSNotification *)notification
 {
-	
 	[self calculateSectorValues];
 	[self generateGraphics];
-	[[NSNotificationCenter defaultCenter] postNotificationName:XRLayerRequiresRedraw object:self];
+}
+
+//the histogram is counted off the main thread and applied with every other layer's in one pass
+-(void)geometryDidChangeSectors:(NSNotification *)notification
+{
+	if(!geometryController)
+	{
+		[self calculateSectorValues];
+		[self generateGraphics];
+		return;
+	}
+	[[SectorRecomputeScheduler schedulerForGeometryController:geometryController] scheduleLayer:self];
+}
+
+//the graphics cache their geometry and rescale it, so nothing is rebuilt or counted again
+-(void)geometryDidChangeBounds
+{
+	for(Graphic *aGraphic in _graphicalObjects)
+		[aGraphic calculateGeometry];
+}
+
+-(void)applySectorHistogram:(XRSectorHistogram *)histogram
+{
+	[self calculateSectorValuesWithHistogram:histogram];
+	[self generateGraphics];
 }
 
 -(void)didChangeValueForKey:(NSString *)key
@@ -504,21 +518,22 @@
 
 -(void)setStatisticsArray
 {
-	if(_statistics)
-		[_statistics removeAllObjects];
+	//the data set builds its statistic objects only when the inspector asks for them
+	_statistics = nil;
+	//the summary needs every value, which a histogram counted in the store did not read
+	if([_theSet hasLoadedValues])
+		[_theSet calculateCircularSummaryForBiDir:_isBiDir startAngle:[geometryController startingAngle] sectorSize:[geometryController sectorSize]];
 	else
-		_statistics = [[NSMutableArray alloc] init];
-	
-	//[_statistics addObjectsFromArray:[_theSet calculateStatisticObjectsForBiDir:_isBiDir]];
-	[_statistics addObjectsFromArray:[_theSet calculateStatisticObjectsForBiDir:_isBiDir startAngle:[geometryController startingAngle] sectorSize:[geometryController sectorSize]]];
+		[_theSet deferCircularSummaryForBiDir:_isBiDir startAngle:[geometryController startingAngle] sectorSize:[geometryController sectorSize]];
 
-	
 	[[NSNotificationCenter defaultCenter] postNotificationName:XRLayerDataStatisticsDidChange object:self];
 	
 }
 
 -(NSMutableArray *)statisticsArray
 {
+	if(!_statistics)
+		_statistics = [[NSMutableArray alloc] initWithArray:[_theSet currentStatistics]];
 	return _statistics;
 }
 
@@ -551,7 +566,10 @@
 
 -(void)setDataSet:(XRDataSet *)aSet
 {
+	if(_theSet)
+		[[NSNotificationCenter defaultCenter] removeObserver:self name:XRDataSetDidAppendValuesNotification object:_theSet];
 	_theSet = aSet;
+	[self observeDataSet:_theSet];
 	[self calculateSectorValues];
 	[self generateGraphics];
 }
@@ -128,6 +128,7 @@ ringPercentIncrement:(float)ringPercentIncrement
 -(BOOL)showLabels;
 -(int)fixedRingCount;
 -(BOOL)ringsVisible;
+-(BOOL)spokesVisible;
 -(int)ringCountIncrement;
 -(float)ringPercentIncrement;
 -(float)ringLabelAngle;
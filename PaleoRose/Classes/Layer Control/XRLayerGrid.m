@@ -768,6 +768,10 @@
     return _ringsVisible;
 }
 
+-(BOOL)spokesVisible {
+    return _spokesVisible;
+}
+
 -(int)ringCountIncrement {
     return _ringCountIncrement;
 }
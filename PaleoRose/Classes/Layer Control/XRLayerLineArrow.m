@@ -28,7 +28,6 @@
 
 #import "XRLayerLineArrow.h"
 #import "XRDataSet.h"
-#import "XRStatistic.h"
 #import "XRGeometryController.h"
 #import "PaleoRose-Swift.h"
 #import <Cocoa/Cocoa.h>
@@ -124,19 +123,11 @@
     float errorAngle = 0.0;
     ArrowHead *anArrow;
     NSBezierPath *aPath;
-    NSArray *stats = [_theSet currentStatistics];
-    NSEnumerator *anEnum = [stats objectEnumerator];
-    XRStatistic *theStat;
+    XRCircularSummary summary = [_theSet circularSummary];
     [_graphicalObjects removeAllObjects];
-    while(theStat = [anEnum nextObject])
-    {
-        if([theStat.statisticName isEqualToString:[NSString stringWithUTF8String:"θ̅"]])
-            vector = [theStat floatValue];
-        if([theStat.statisticName isEqualToString:[NSString stringWithUTF8String:"R̅"]])
-            vectorStrength = [theStat floatValue];
-        if([theStat.statisticName isEqualToString:[NSString stringWithUTF8String:"θ̅± (95%)"]])
-            errorAngle = [theStat floatValue];
-    }
+    vector = summary.meanDirection;
+    vectorStrength = summary.meanResultantLength;
+    errorAngle = summary.confidenceInterval;
     switch(_type)
     {
 
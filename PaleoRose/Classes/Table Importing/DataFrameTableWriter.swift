@@ -41,8 +41,25 @@ struct DataFrameTableWriter: DataFrameTableWriting {
     }
 
     func createSQL(for dataFrame: DataFrame, named tableName: String) -> String {
+        createSQL(columns: dataFrame.columns.map { (name: $0.name, affinity: affinity(for: $0)) }, named: tableName)
+    }
+
+    func insertSQL(for dataFrame: DataFrame, named tableName: String) -> String {
+        insertSQL(columnNames: dataFrame.columns.map(\.name), named: tableName)
+    }
+
+    func bindingRows(for dataFrame: DataFrame) -> [[Bindable?]] {
+        (0 ..< dataFrame.rows.count).map { rowIndex in
+            dataFrame.columns.map { bindable(from: $0, at: rowIndex) }
+        }
+    }
+
+    // MARK: - Column SQL
+
+    /// CREATE TABLE for explicit column names and affinities; shared with the streaming text importer.
+    func createSQL(columns: [(name: String, affinity: String)], named tableName: String) -> String {
         let escapedName = tableName.sqliteEscaped
-        let columnDefs = dataFrame.columns.map { col in "\"\(col.name.sqliteEscaped)\" \(affinity(for: col))" }
+        let columnDefs = columns.map { col in "\"\(col.name.sqliteEscaped)\" \(col.affinity)" }
             .joined(separator: ",\n\t")
         return """
         CREATE TABLE "\(escapedName)" (
@@ -52,22 +69,17 @@ struct DataFrameTableWriter: DataFrameTableWriting {
         """
     }
 
-    func insertSQL(for dataFrame: DataFrame, named tableName: String) -> String {
+    /// Parameterised INSERT for explicit column names; shared with the streaming text importer.
+    func insertSQL(columnNames: [String], named tableName: String) -> String {
         let escapedName = tableName.sqliteEscaped
-        let cols = dataFrame.columns
-            .map { "\"\($0.name.sqliteEscaped)\"" }
+        let cols = columnNames
+            .map { "\"\($0.sqliteEscaped)\"" }
             .joined(separator: ", ")
-        let placeholders = Array(repeating: "?", count: dataFrame.columns.count)
+        let placeholders = Array(repeating: "?", count: columnNames.count)
             .joined(separator: ", ")
         return "INSERT INTO \"\(escapedName)\" (\(cols)) VALUES (\(placeholders))"
     }
 
-    func bindingRows(for dataFrame: DataFrame) -> [[Bindable?]] {
-        (0 ..< dataFrame.rows.count).map { rowIndex in
-            dataFrame.columns.map { bindable(from: $0, at: rowIndex) }
-        }
-    }
-
     // MARK: - Private
 
     // swiftlint:disable switch_case_on_newline
@@ -0,0 +1,197 @@
+//
+// DelimitedTextReader.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import Foundation
+
+/// Reads a delimited text file one record at a time through a fixed-size buffer,
+/// so memory use depends on the chunk size rather than the file size.
+///
+/// Fields may be wrapped in double quotes to hold the delimiter, line breaks or `""` escaped quotes.
+/// Blank lines are skipped. Only encodings that share ASCII's byte values for the delimiter,
+/// quotes and line breaks can be read this way; see `supports(delimiter:encoding:)`.
+final class DelimitedTextReader {
+
+    static let defaultChunkSize = 1 << 16
+
+    private static let asciiCompatibleEncodings: Set<String.Encoding> = [
+        .utf8, .ascii, .isoLatin1, .isoLatin2, .macOSRoman,
+        .windowsCP1250, .windowsCP1251, .windowsCP1252, .windowsCP1253, .windowsCP1254
+    ]
+
+    private static let quote = UInt8(ascii: "\"")
+    private static let lineFeed = UInt8(ascii: "\n")
+    private static let carriageReturn = UInt8(ascii: "\r")
+
+    /// File size in bytes, for progress reporting.
+    let totalBytes: Int
+
+    /// Bytes read from the file so far. Advances one chunk at a time.
+    private(set) var bytesRead = 0
+
+    private let handle: FileHandle
+    private let delimiter: UInt8
+    private let encoding: String.Encoding
+    private let chunkSize: Int
+    private var buffer: [UInt8] = []
+    private var position = 0
+    private var field: [UInt8] = []
+
+    static func supports(delimiter: Character, encoding: String.Encoding) -> Bool {
+        guard let byte = delimiter.asciiValue else {
+            return false
+        }
+        return ![quote, lineFeed, carriageReturn].contains(byte) && asciiCompatibleEncodings.contains(encoding)
+    }
+
+    init(
+        url: URL,
+        delimiter: Character,
+        encoding: String.Encoding,
+        chunkSize: Int = defaultChunkSize
+    ) throws {
+        guard Self.supports(delimiter: delimiter, encoding: encoding), let byte = delimiter.asciiValue else {
+            throw TableImportError.unsupportedFileFormat(url.pathExtension)
+        }
+        handle = try FileHandle(forReadingFrom: url)
+        let attributes = try FileManager.default.attributesOfItem(atPath: url.path)
+        totalBytes = (attributes[.size] as? NSNumber)?.intValue ?? 0
+        self.delimiter = byte
+        self.encoding = encoding
+        self.chunkSize = max(chunkSize, 1)
+        try skipByteOrderMark()
+    }
+
+    deinit {
+        try? handle.close()
+    }
+
+    /// Returns the fields of the next record, or nil at the end of the file.
+    func nextRecord() throws -> [String]? {
+        var fields: [String] = []
+        var inQuotes = false
+        var quoted = false
+        var hasContent = false
+        field.removeAll(keepingCapacity: true)
+
+        while let byte = try nextByte() {
+            if inQuotes {
+                if byte != Self.quote {
+                    field.append(byte)
+                } else if try peekByte() == Self.quote {
+                    position += 1
+                    field.append(byte)
+                } else {
+                    inQuotes = false
+                }
+                continue
+            }
+
+            switch byte {
+            case Self.quote where field.isEmpty && !quoted:
+                inQuotes = true
+                quoted = true
+                hasContent = true
+
+            case delimiter:
+                fields.append(decodeField())
+                quoted = false
+                hasContent = true
+
+            case Self.lineFeed, Self.carriageReturn:
+                if byte == Self.carriageReturn, try peekByte() == Self.lineFeed {
+                    position += 1
+                }
+                guard hasContent else {
+                    continue
+                }
+                fields.append(decodeField())
+                return fields
+
+            default:
+                field.append(byte)
+                hasContent = true
+            }
+        }
+
+        guard hasContent else {
+            return nil
+        }
+        fields.append(decodeField())
+        return fields
+    }
+
+    // MARK: - Private
+
+    private func decodeField() -> String {
+        defer {
+            field.removeAll(keepingCapacity: true)
+        }
+        if encoding == .utf8 {
+            return String(decoding: field, as: UTF8.self)
+        }
+        return String(bytes: field, encoding: encoding) ?? String(decoding: field, as: UTF8.self)
+    }
+
+    private func nextByte() throws -> UInt8? {
+        guard try fillBuffer() else {
+            return nil
+        }
+        defer {
+            position += 1
+        }
+        return buffer[position]
+    }
+
+    private func peekByte() throws -> UInt8? {
+        guard try fillBuffer() else {
+            return nil
+        }
+        return buffer[position]
+    }
+
+    /// Reads the next chunk once the current one is used up. Returns false at the end of the file.
+    private func fillBuffer() throws -> Bool {
+        if position < buffer.count {
+            return true
+        }
+        guard let data = try handle.read(upToCount: chunkSize), !data.isEmpty else {
+            return false
+        }
+        buffer.removeAll(keepingCapacity: true)
+        buffer.append(contentsOf: data)
+        position = 0
+        bytesRead += data.count
+        return true
+    }
+
+    private func skipByteOrderMark() throws {
+        let byteOrderMark: [UInt8] = [0xEF, 0xBB, 0xBF]
+        if encoding == .utf8, try fillBuffer(), buffer.starts(with: byteOrderMark) {
+            position = byteOrderMark.count
+        }
+    }
+}
@@ -0,0 +1,206 @@
+//
+// StreamingTableImporter.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import CodableSQLiteNonThread
+import Foundation
+
+/// Receives a user table whose rows are pulled one at a time while they are inserted.
+protocol UserTableSink {
+    @discardableResult
+    func createUserTable(createSQL: String, insertSQL: String, nextRow: () throws -> [Bindable?]?) throws -> Int
+}
+
+extension InMemoryStore: UserTableSink {}
+
+/// Imports a delimited text file into a user table without loading the file into memory.
+///
+/// Column names come from the header row, or `Column 0`, `Column 1`, … as TabularData names them.
+/// Column types are inferred from the first `sampleSize` records, which are held until the insert
+/// starts; the rest of the file streams through the sink's reused insert statement. Peak memory is
+/// set by `chunkSize` and `sampleSize`, not by the file size.
+struct StreamingTableImporter {
+
+    enum ColumnType: Equatable {
+        case integer
+        case double
+        case boolean
+        case text
+
+        var affinity: String {
+            self == .text ? "TEXT" : "NUMERIC"
+        }
+    }
+
+    let options: TextImportOptions
+    var chunkSize = DelimitedTextReader.defaultChunkSize
+    var sampleSize = 1000
+    var writer = DataFrameTableWriter()
+
+    /// False when the delimiter or encoding needs the DataFrame import path.
+    static func canImport(_ options: TextImportOptions) -> Bool {
+        DelimitedTextReader.supports(delimiter: options.delimiter, encoding: options.encoding)
+    }
+
+    /// Creates `options.tableName` in `sink` and inserts every record of the file in one transaction.
+    ///
+    /// `progress` counts bytes read and is checked for cancellation once per chunk, as is the current task.
+    /// - returns: The number of rows inserted
+    /// - throws: `CancellationError` when cancelled, `TableImportError.emptyDataFrame` when the file
+    ///   has no records, or the sink's error. The sink rolls the table back on any error.
+    @discardableResult
+    func importTable(from url: URL, into sink: UserTableSink, progress: Progress = Progress()) throws -> Int {
+        let reader = try DelimitedTextReader(
+            url: url,
+            delimiter: options.delimiter,
+            encoding: options.encoding,
+            chunkSize: chunkSize
+        )
+        progress.totalUnitCount = Int64(reader.totalBytes)
+
+        let header = options.hasColumnHeaders ? try reader.nextRecord() : nil
+        var sample: [[String]] = []
+        while sample.count < sampleSize, let record = try reader.nextRecord() {
+            sample.append(record)
+        }
+        guard !sample.isEmpty else {
+            throw TableImportError.emptyDataFrame
+        }
+
+        let columnCount = max(header?.count ?? 0, sample.map(\.count).max() ?? 0)
+        let names = Self.columnNames(header: header, count: columnCount)
+        let types = (0 ..< columnCount).map { column in
+            Self.inferType(sample.lazy.map { column < $0.count ? $0[column] : "" })
+        }
+        let createSQL = writer.createSQL(
+            columns: zip(names, types).map { (name: $0, affinity: $1.affinity) },
+            named: options.tableName
+        )
+        let insertSQL = writer.insertSQL(columnNames: names, named: options.tableName)
+
+        var sampleIndex = 0
+        var reportedBytes = -1
+        return try sink.createUserTable(createSQL: createSQL, insertSQL: insertSQL) {
+            if reader.bytesRead != reportedBytes {
+                reportedBytes = reader.bytesRead
+                progress.completedUnitCount = Int64(reportedBytes)
+                if progress.isCancelled || Task.isCancelled {
+                    throw CancellationError()
+                }
+            }
+            if sampleIndex < sample.count {
+                sampleIndex += 1
+                return Self.bindings(for: sample[sampleIndex - 1], types: types)
+            }
+            if !sample.isEmpty {
+                // Release the sample once it has been inserted
+                sample = []
+                sampleIndex = 0
+            }
+            return try reader.nextRecord().map { Self.bindings(for: $0, types: types) }
+        }
+    }
+
+    // MARK: - Type inference
+
+    /// The narrowest type that parses every non-empty value; integer, then double, then boolean, else text.
+    static func inferType(_ values: some Sequence<String>) -> ColumnType {
+        var candidates: [ColumnType] = [.integer, .double, .boolean]
+        var hasValue = false
+        for value in values where !value.isEmpty {
+            hasValue = true
+            candidates.removeAll { !parses(value, as: $0) }
+            if candidates.isEmpty {
+                return .text
+            }
+        }
+        return hasValue ? candidates[0] : .text
+    }
+
+    /// Binds each field as its column type. Empty fields bind NULL; fields that do not parse
+    /// as the inferred type are stored as text rather than dropped.
+    static func bindings(for record: [String], types: [ColumnType]) -> [Bindable?] {
+        types.indices.map { column -> Bindable? in
+            guard column < record.count, !record[column].isEmpty else {
+                return nil
+            }
+            let value = record[column]
+            switch types[column] {
+            case .integer:
+                return Int(value).map { $0 as Bindable } ?? value
+
+            case .double:
+                return Double(value).map { $0 as Bindable } ?? value
+
+            case .boolean:
+                return boolean(value).map { $0 as Bindable } ?? value
+
+            case .text:
+                return value
+            }
+        }
+    }
+
+    // MARK: - Private
+
+    private static func columnNames(header: [String]?, count: Int) -> [String] {
+        (0 ..< count).map { column in
+            guard let header, column < header.count, !header[column].isEmpty else {
+                return "Column \(column)"
+            }
+            return header[column]
+        }
+    }
+
+    private static func parses(_ value: String, as type: ColumnType) -> Bool {
+        switch type {
+        case .integer:
+            Int(value) != nil
+
+        case .double:
+            Double(value) != nil
+
+        case .boolean:
+            boolean(value) != nil
+
+        case .text:
+            true
+        }
+    }
+
+    private static func boolean(_ value: String) -> Bool? {
+        switch value.lowercased() {
+        case "true":
+            true
+
+        case "false":
+            false
+
+        default:
+            nil
+        }
+    }
+}
@@ -0,0 +1,273 @@
+//
+// StreamingTableImporterTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import CodableSQLiteNonThread
+import Foundation
+@testable import PaleoRose
+import Testing
+
+@Suite("StreamingTableImporter")
+struct StreamingTableImporterTests {
+
+    /// Pulls every row without storing any, so only the reader's memory is measured.
+    private final class CountingSink: UserTableSink {
+        var createSQL: String?
+        var rows: [[Bindable?]] = []
+        var keepsRows = true
+        var rowCount = 0
+
+        func createUserTable(createSQL: String, insertSQL _: String, nextRow: () throws -> [Bindable?]?) throws -> Int {
+            self.createSQL = createSQL
+            while let row = try nextRow() {
+                rowCount += 1
+                if keepsRows {
+                    rows.append(row)
+                }
+            }
+            return rowCount
+        }
+    }
+
+    private func makeFile(_ contents: String) throws -> URL {
+        let url = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString)
+            .appendingPathExtension("txt")
+        try Data(contents.utf8).write(to: url)
+        return url
+    }
+
+    private func options(headers: Bool = true, delimiter: Character = ",") -> TextImportOptions {
+        TextImportOptions(tableName: "strikes", hasColumnHeaders: headers, delimiter: delimiter, encoding: .utf8)
+    }
+
+    private func records(in contents: String, chunkSize: Int) throws -> [[String]] {
+        let url = try makeFile(contents)
+        defer { try? FileManager.default.removeItem(at: url) }
+        let reader = try DelimitedTextReader(url: url, delimiter: ",", encoding: .utf8, chunkSize: chunkSize)
+        var result: [[String]] = []
+        while let record = try reader.nextRecord() {
+            result.append(record)
+        }
+        return result
+    }
+
+    // MARK: - Reader
+
+    @Test("splits quoted fields, escaped quotes and line endings across chunk boundaries", arguments: [1, 3, 4096])
+    func readerSplitsRecords(chunkSize: Int) throws {
+        let contents = "a,\"b,c\",\"say \"\"hi\"\"\"\r\n\n1,\"two\nlines\",\r3,,4"
+        let result = try records(in: contents, chunkSize: chunkSize)
+        #expect(result == [
+            ["a", "b,c", "say \"hi\""],
+            ["1", "two\nlines", ""],
+            ["3", "", "4"]
+        ])
+    }
+
+    @Test("skips a UTF-8 byte order mark")
+    func readerSkipsByteOrderMark() throws {
+        let result = try records(in: "\u{FEFF}Azimuth\n45", chunkSize: 4096)
+        #expect(result == [["Azimuth"], ["45"]])
+    }
+
+    @Test("rejects delimiters and encodings that cannot be split byte-wise")
+    func readerSupport() {
+        #expect(DelimitedTextReader.supports(delimiter: "\t", encoding: .utf8))
+        #expect(DelimitedTextReader.supports(delimiter: ";", encoding: .macOSRoman))
+        #expect(!DelimitedTextReader.supports(delimiter: ",", encoding: .utf16))
+        #expect(!DelimitedTextReader.supports(delimiter: "\"", encoding: .utf8))
+        #expect(!DelimitedTextReader.supports(delimiter: "°", encoding: .utf8))
+    }
+
+    // MARK: - Inference
+
+    @Test("infers the narrowest type that parses every sampled value")
+    func infersTypes() {
+        #expect(StreamingTableImporter.inferType(["1", "", "-20"]) == .integer)
+        #expect(StreamingTableImporter.inferType(["1", "2.5", "1e3"]) == .double)
+        #expect(StreamingTableImporter.inferType(["TRUE", "false"]) == .boolean)
+        #expect(StreamingTableImporter.inferType(["1", "north"]) == .text)
+        #expect(StreamingTableImporter.inferType(["", ""]) == .text)
+    }
+
+    @Test("values that do not match the inferred type are kept as text and empty fields are NULL")
+    func bindingsFallBackToText() {
+        let row = StreamingTableImporter.bindings(for: ["12", "n/a", ""], types: [.integer, .double, .text])
+        #expect(row.count == 3)
+        #expect(row[0] as? Int == 12)
+        #expect(row[1] as? String == "n/a")
+        #expect(row[2] == nil)
+    }
+
+    // MARK: - Import
+
+    @Test("creates the table from the header and inferred affinities")
+    func createsTable() throws {
+        let url = try makeFile("Azimuth,Dip,Label\n45,12.5,north\n90,,east\n")
+        defer { try? FileManager.default.removeItem(at: url) }
+        let sink = CountingSink()
+
+        let count = try StreamingTableImporter(options: options()).importTable(from: url, into: sink)
+
+        #expect(count == 2)
+        let createSQL = try #require(sink.createSQL)
+        #expect(createSQL.contains("\"Azimuth\" NUMERIC"))
+        #expect(createSQL.contains("\"Dip\" NUMERIC"))
+        #expect(createSQL.contains("\"Label\" TEXT"))
+        #expect(sink.rows[1][0] as? Int == 90)
+        #expect(sink.rows[1][1] == nil)
+    }
+
+    @Test("names headerless columns as TabularData does and pads short rows")
+    func headerlessColumns() throws {
+        let url = try makeFile("1\t2\n3\n")
+        defer { try? FileManager.default.removeItem(at: url) }
+        let sink = CountingSink()
+
+        try StreamingTableImporter(options: options(headers: false, delimiter: "\t")).importTable(from: url, into: sink)
+
+        let createSQL = try #require(sink.createSQL)
+        #expect(createSQL.contains("\"Column 0\" NUMERIC"))
+        #expect(createSQL.contains("\"Column 1\" NUMERIC"))
+        #expect(sink.rows.count == 2)
+        #expect(sink.rows[1][1] == nil)
+    }
+
+    @Test("rows after the sample prefix stream through in order")
+    func rowsAfterSample() throws {
+        let url = try makeFile("v\n" + (1 ... 50).map(String.init).joined(separator: "\n"))
+        defer { try? FileManager.default.removeItem(at: url) }
+        let sink = CountingSink()
+        var importer = StreamingTableImporter(options: options())
+        importer.sampleSize = 5
+        importer.chunkSize = 8
+
+        try importer.importTable(from: url, into: sink)
+
+        #expect(sink.rows.compactMap { $0[0] as? Int } == Array(1 ... 50))
+    }
+
+    @Test("throws emptyDataFrame for a file with only a header")
+    func emptyFile() throws {
+        let url = try makeFile("Azimuth\n")
+        defer { try? FileManager.default.removeItem(at: url) }
+        #expect(throws: TableImportError.emptyDataFrame) {
+            try StreamingTableImporter(options: options()).importTable(from: url, into: CountingSink())
+        }
+    }
+
+    @Test("progress reaches the file size")
+    func progressCompletes() throws {
+        let contents = "v\n" + (1 ... 200).map(String.init).joined(separator: "\n")
+        let url = try makeFile(contents)
+        defer { try? FileManager.default.removeItem(at: url) }
+        let progress = Progress()
+        var importer = StreamingTableImporter(options: options())
+        importer.chunkSize = 64
+
+        try importer.importTable(from: url, into: CountingSink(), progress: progress)
+
+        #expect(progress.totalUnitCount == Int64(contents.utf8.count))
+        #expect(progress.completedUnitCount == progress.totalUnitCount)
+    }
+
+    @Test("cancelling progress rolls the table back", .tags(.integration))
+    func cancellationRollsBack() throws {
+        let url = try makeFile("v\n" + (1 ... 200).map(String.init).joined(separator: "\n"))
+        defer { try? FileManager.default.removeItem(at: url) }
+        let store = try InMemoryStore()
+        let progress = Progress()
+        progress.cancel()
+
+        #expect(throws: CancellationError.self) {
+            try StreamingTableImporter(options: options()).importTable(from: url, into: store, progress: progress)
+        }
+        let names = try store.tableNames(sqliteStore: store.sqlitePointer())
+        #expect(!names.contains("strikes"))
+    }
+
+    @Test("imports into the in-memory store", .tags(.integration))
+    func importsIntoStore() throws {
+        let url = try makeFile("Azimuth,Label\n45,north\n90,east\n135,\n")
+        defer { try? FileManager.default.removeItem(at: url) }
+        let store = try InMemoryStore()
+
+        let count = try StreamingTableImporter(options: options()).importTable(from: url, into: store)
+
+        let result = try store.interface.executeQuery(
+            sqlite: store.sqlitePointer(),
+            query: Query(sql: "SELECT sum(\"Azimuth\") AS total, count(\"Label\") AS labels FROM \"strikes\"")
+        )
+        #expect(count == 3)
+        #expect(result.first?["total"] as? Int32 == 270)
+        #expect(result.first?["labels"] as? Int32 == 2)
+    }
+
+    // MARK: - Memory
+
+    /// Peak resident size in bytes (`ru_maxrss` is reported in bytes on macOS).
+    private func peakResidentBytes() -> Int {
+        var usage = rusage()
+        getrusage(RUSAGE_SELF, &usage)
+        return Int(usage.ru_maxrss)
+    }
+
+    @Test(
+        "Benchmark streaming a multi-gigabyte file in bounded memory",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkBoundedMemory() throws {
+        let targetBytes = ProcessInfo.processInfo.environment["PALEOROSE_IMPORT_BYTES"].flatMap(Int.init) ?? 2 << 30
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).txt")
+        FileManager.default.createFile(atPath: url.path, contents: nil)
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        // Write the file a block at a time so generating it does not raise the peak either
+        let handle = try FileHandle(forWritingTo: url)
+        try handle.write(contentsOf: Data("Azimuth,Dip,Label\n".utf8))
+        let block = Data((0 ..< 20000).map { "\($0 % 360),\(Double($0 % 90) + 0.5),\"site \($0 % 17)\"\n" }.joined().utf8)
+        var written = 0
+        while written < targetBytes {
+            try handle.write(contentsOf: block)
+            written += block.count
+        }
+        try handle.close()
+
+        let sink = CountingSink()
+        sink.keepsRows = false
+        let baseline = peakResidentBytes()
+        let elapsed = try Benchmark.measure("stream \(written >> 20) MiB", iterations: 1) {
+            _ = try StreamingTableImporter(options: options()).importTable(from: url, into: sink)
+        }
+        let growth = peakResidentBytes() - baseline
+
+        print("[benchmark] \(sink.rowCount) rows, \(Double(written) / 1_048_576 / Benchmark.seconds(elapsed)) MiB/s, peak RSS growth \(growth >> 20) MiB")
+        #expect(sink.rowCount > 0)
+        #expect(growth < 64 << 20)
+    }
+}
@@ -32,6 +32,9 @@ import TabularData
     private weak var documentModel: (UserTableImporting & NSObject)?
     private weak var presentingWindow: NSWindow?
 
+    /// Byte progress of the current text import. Cancel it to abandon the import.
+    @objc private(set) var importProgress = Progress()
+
     init(documentModel: UserTableImporting & NSObject, window: NSWindow) {
         self.documentModel = documentModel
         presentingWindow = window
@@ -63,6 +66,12 @@ import TabularData
 
     private func importText(from url: URL) async throws {
         let options = try await showDelimiterSheet(for: url)
+        guard !StreamingTableImporter.canImport(options) else {
+            importProgress = Progress()
+            try documentModel?.importText(from: url, options: options, progress: importProgress)
+            return
+        }
+        // Delimiters and encodings the streaming reader cannot split byte-wise go through TabularData
         let csvOptions = CSVReadingOptions(hasHeaderRow: options.hasColumnHeaders, delimiter: options.delimiter)
         let dataFrame = try DataFrame(contentsOfCSVFile: url, options: csvOptions)
         try documentModel?.importTable(dataFrame, named: options.tableName)
@@ -32,6 +32,7 @@ import Testing
 
 final class MockUserTableImporting: NSObject, UserTableImporting {
     var importedFrames: [(DataFrame, String)] = []
+    var importedTexts: [(URL, TextImportOptions)] = []
     var copiedTables: [(URL, [(original: String, destination: String)])] = []
     var existingTableNames: [String] = []
     var shouldThrow: Error?
@@ -41,6 +42,11 @@ final class MockUserTableImporting: NSObject, UserTableImporting {
         importedFrames.append((dataFrame, tableName))
     }
 
+    func importText(from url: URL, options: TextImportOptions, progress _: Progress) throws {
+        if let error = shouldThrow { throw error }
+        importedTexts.append((url, options))
+    }
+
     func copyTables(from url: URL, selecting tables: [(original: String, destination: String)]) throws {
         if let error = shouldThrow { throw error }
         copiedTables.append((url, tables))
@@ -28,8 +28,14 @@
 
 #import <Foundation/Foundation.h>
 
+//lowercase hex with no line breaks
 NSString * encodeBase16(NSData *);
+//accepts either case and skips ASCII whitespace; nil for any other character or an odd digit count
 NSData * decodeBase16(NSString *);
+//writes 2 * length characters to output
+void LITMBase16EncodeBytes(const uint8_t *bytes, size_t length, char *output);
+//output must hold length / 2 bytes; returns the bytes written, or -1 for invalid input
+ssize_t LITMBase16DecodeBytes(const char *text, size_t length, uint8_t *output);
 NSString * encodeBase64(NSData *);
 NSData * decodeBase64(NSString *);
 NSData * decodeBase64WithEncoding(NSString * aString, unsigned int encoding);
@@ -28,122 +28,116 @@
 
 #import "LITMXMLBinaryEncoding.h"
 
-NSString * encodeBase16(NSData * data)
-{
-    static char base16lc[] = {"0123456789abcdef"};
-    
-    NSData *theDataObject;
-    NSMutableString *finalString = [[NSMutableString alloc] init];
-    int i;
-    int count = (int)[data length];
-    int groups = count * 2 / 80;
-    NSRange aRange;
-    char *theChars = (char *)malloc(sizeof(char) * count * 2);
-    unsigned char *theData = (unsigned char *)malloc(sizeof(unsigned char) * count);
+//two characters for each byte value, so each byte is encoded with one 16 bit store
+static uint16_t LITMBase16Pairs[256];
+//nibble value for each character; 0x10 marks whitespace and 0xFF anything else
+static uint8_t LITMBase16Nibbles[256];
+#define LITMBase16Whitespace 0x10
+#define LITMBase16Invalid 0xFF
 
-    //NSLog(@"data length %i",[data length]);
-    [data getBytes:theData length:sizeof(unsigned char) * count];
-    
-    for(i=0;i<count;i++)
-    {
-        unsigned p;
-        p = (theData[i] >> 4) & 0x0F;//shift the byte by 4 bits and mask out first 4 bits
-        theChars[(i*2)] = base16lc[p];
-        p = theData[i] & 0x0F;//mask out first 4 bits
-        theChars[(i*2)+1] = base16lc[p];
-        //NSLog(@"%i %c %c",i,theChars[(i*2)],theChars[(i*2)+1]);
-    }
-    //put in returns
-    theDataObject = [NSData dataWithBytes:theChars length:(count *2)];
-    aRange.length = 80;
-
-    for(i=0;i<groups;i++)
-    {
-        
-        aRange.location = 80 * i;
-        [finalString appendString:[[NSString alloc] initWithData:[theDataObject subdataWithRange:aRange] encoding:NSASCIIStringEncoding]];
-    }
-
-    if((groups*80)<[theDataObject length])
-    {
-        aRange.location = 80 * groups;
-        aRange.length = [theDataObject length] - aRange.location;
-        [finalString appendString:[[NSString alloc] initWithData:[theDataObject subdataWithRange:aRange] encoding:NSASCIIStringEncoding]];
-    }
-    
-    free(theData);
-    free(theChars);
-    return [NSString stringWithString:finalString];
+static void LITMBase16BuildTables(void)
+{
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        static const char base16lc[] = {"0123456789abcdef"};
+        for(int i=0;i<256;i++)
+        {
+            char pair[2] = {base16lc[i >> 4], base16lc[i & 0x0F]};
+            memcpy(&LITMBase16Pairs[i], pair, 2);
+        }
+        memset(LITMBase16Nibbles, LITMBase16Invalid, sizeof(LITMBase16Nibbles));
+        for(int i=0;i<10;i++)
+            LITMBase16Nibbles['0' + i] = i;
+        for(int i=0;i<6;i++)
+        {
+            LITMBase16Nibbles['a' + i] = 10 + i;
+            LITMBase16Nibbles['A' + i] = 10 + i;
+        }
+        const char *whitespace = " \t\n\r\f\v";
+        for(const char *c = whitespace; *c; c++)
+            LITMBase16Nibbles[(unsigned char)*c] = LITMBase16Whitespace;
+    });
 }
 
-NSData * decodeBase16(NSString * aString)
+void LITMBase16EncodeBytes(const uint8_t *bytes, size_t length, char *output)
 {
-    static char base16[] = {"0123456789ABCDEF"};
+    LITMBase16BuildTables();
+    for(size_t i=0;i<length;i++)
+        memcpy(output + (i * 2), &LITMBase16Pairs[bytes[i]], 2);
+}
 
-    static char base16lc[] = {"0123456789abcdef"};
-    unsigned char *theStringContents;
-    NSMutableString *workingString = [[NSMutableString alloc] init];
-    unsigned char *theData;
-    BOOL valid;
-    NSCharacterSet *theSet = [NSCharacterSet whitespaceCharacterSet];
-    NSScanner *theScanner = [NSScanner scannerWithString:aString];
-    NSString *temp;
-    NSData *theFinalData;
-    int i,j,k;
-    
-    while(![theScanner isAtEnd])
-    {
-        [theScanner scanUpToCharactersFromSet:theSet intoString:&temp];
-        [workingString appendString:temp];
-        [theScanner scanCharactersFromSet:theSet intoString:nil];
-    }
-    
-    //check to make sure we have 2 bytes for each value
-    if(([workingString length]/2*2)!=[workingString length])
-    {
-        //NSLog(@"invalid data");
-        return nil;
-    }
-    valid = YES;
-    //if we're here, we have valid data
-    theStringContents = (unsigned char *)malloc(sizeof(unsigned char)*[workingString length]);
-    theData = (unsigned char *)malloc(sizeof(unsigned char)*[workingString length]/2);
-    [[workingString dataUsingEncoding:NSASCIIStringEncoding] getBytes:theStringContents length:sizeof(unsigned char)*[workingString length]/2];
-    //now all data are allocated
-    for(i=0;i<([workingString length]);i++)
+ssize_t LITMBase16DecodeBytes(const char *text, size_t length, uint8_t *output)
+{
+    LITMBase16BuildTables();
+    const unsigned char *characters = (const unsigned char *)text;
+    size_t written = 0;
+    size_t i = 0;
+    while(i < length)
     {
-        k = -1;
-        for(j=0;j<16;j++)
+        //fast path: two digits in a row, the common case between line breaks
+        if(i + 1 < length)
         {
-            if((theStringContents[i]==base16[j])||(theStringContents[i]==base16lc[j]))
+            uint8_t high = LITMBase16Nibbles[characters[i]];
+            uint8_t low = LITMBase16Nibbles[characters[i+1]];
+            if((high | low) < LITMBase16Whitespace)
             {
-                k = 0;
-                theStringContents[i] = (unsigned char)j;
-                j = 16;
+                output[written++] = (uint8_t)((high << 4) | low);
+                i += 2;
+                continue;
             }
         }
-        if(k==-1)
+        //slow path: a digit may be split from its partner by whitespace
+        uint8_t nibbles[2];
+        for(int n=0;n<2;n++)
         {
-            valid = NO;
-            //NSLog(@"invalid character");
+            uint8_t value = LITMBase16Whitespace;
+            while(i < length && (value = LITMBase16Nibbles[characters[i++]]) == LITMBase16Whitespace)
+                ;
+            if(value == LITMBase16Invalid)
+                return -1;
+            if(value == LITMBase16Whitespace)
+                return n == 0 ? (ssize_t)written : -1;//trailing whitespace, or an odd digit count
+            nibbles[n] = value;
         }
+        output[written++] = (uint8_t)((nibbles[0] << 4) | nibbles[1]);
     }
-    
-    if(!valid)
-    {
-        free(theStringContents);
-        free(theData);
+    return (ssize_t)written;
+}
+
+NSString * encodeBase16(NSData * data)
+{
+    NSUInteger length = [data length];
+    if(length == 0)
+        return @"";
+    char *characters = (char *)malloc(length * 2);
+    if(!characters)
         return nil;
-    }
-    for(i=0;i<[workingString length]/2;i++)
+    LITMBase16EncodeBytes((const uint8_t *)[data bytes], length, characters);
+    return [[NSString alloc] initWithBytesNoCopy:characters length:length * 2 encoding:NSASCIIStringEncoding freeWhenDone:YES];
+}
+
+NSData * decodeBase16(NSString * aString)
+{
+    if(!aString)
+        return nil;
+    //most strings read from XML are ASCII already and can be read in place
+    NSData *ascii = nil;
+    const char *text = CFStringGetCStringPtr((__bridge CFStringRef)aString, kCFStringEncodingASCII);
+    size_t length = text ? (size_t)CFStringGetLength((__bridge CFStringRef)aString) : 0;
+    if(!text)
     {
-        theData[i] = (theStringContents[(i*2)] << 4) | theStringContents[(i*2)+1];
+        ascii = [aString dataUsingEncoding:NSASCIIStringEncoding allowLossyConversion:NO];
+        if(!ascii)
+            return nil;
+        text = (const char *)[ascii bytes];
+        length = [ascii length];
     }
-    theFinalData = [NSData dataWithBytes:theData length:([workingString length]/2)];
-    free(theStringContents);
-    free(theData);
-    return theFinalData;
-    
+    NSMutableData *decoded = [[NSMutableData alloc] initWithLength:length / 2];
+    ssize_t written = LITMBase16DecodeBytes(text, length, (uint8_t *)[decoded mutableBytes]);
+    if(written < 0)
+        return nil;
+    [decoded setLength:(NSUInteger)written];
+    return decoded;
 }
 
 NSString * encodeBase64(NSData * data)
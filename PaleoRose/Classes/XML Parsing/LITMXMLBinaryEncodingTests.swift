@@ -0,0 +1,172 @@
+//
+// LITMXMLBinaryEncodingTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+import Foundation
+@testable import PaleoRose
+import Testing
+
+struct LITMXMLBinaryEncodingTests {
+
+    // MARK: - Test Setup
+
+    /// Deterministic bytes, so a failing fuzz case can be reproduced
+    private struct SplitMix64: RandomNumberGenerator {
+        var state: UInt64
+
+        mutating func next() -> UInt64 {
+            state &+= 0x9E37_79B9_7F4A_7C15
+            var value = state
+            value = (value ^ (value >> 30)) &* 0xBF58_476D_1CE4_E5B9
+            value = (value ^ (value >> 27)) &* 0x94D0_49BB_1331_11EB
+            return value ^ (value >> 31)
+        }
+    }
+
+    private func randomData(count: Int, using generator: inout SplitMix64) -> Data {
+        Data((0 ..< count).map { _ in UInt8.random(in: 0 ... 255, using: &generator) })
+    }
+
+    // MARK: - Encoding
+
+    @Test("Bytes are encoded as lowercase hex without line breaks")
+    func encode() {
+        let data = Data([0x00, 0x01, 0x7F, 0x80, 0xAB, 0xFF])
+
+        #expect(encodeBase16(data) == "00017f80abff")
+        #expect(encodeBase16(Data()) == "")
+        #expect(encodeBase16(Data(repeating: 0x5A, count: 100)) == String(repeating: "5a", count: 100))
+    }
+
+    @Test("Float arrays encode to the bytes they are stored as")
+    func encodeFloats() {
+        let values: [Float] = [0, 1, 359.5]
+        let data = values.withUnsafeBufferPointer { Data(buffer: $0) }
+
+        #expect(encodeBase16(data) == "000000000000803f00c0b343")
+    }
+
+    // MARK: - Decoding
+
+    @Test("Either case decodes")
+    func decodeCase() {
+        #expect(decodeBase16("00017f80abff") == Data([0x00, 0x01, 0x7F, 0x80, 0xAB, 0xFF]))
+        #expect(decodeBase16("00017F80ABFF") == Data([0x00, 0x01, 0x7F, 0x80, 0xAB, 0xFF]))
+        #expect(decodeBase16("") == Data())
+    }
+
+    @Test("Whitespace is skipped, including inside a byte")
+    func decodeWhitespace() {
+        #expect(decodeBase16("  0a0b\n\t0c\r\n0 d  \n") == Data([0x0A, 0x0B, 0x0C, 0x0D]))
+        #expect(decodeBase16("\n\n") == Data())
+    }
+
+    @Test(
+        "Invalid input is rejected",
+        arguments: ["0", "abc", "0g", "zz", "0a-0b", "0a 0", "éé", "0a\u{0}0b"]
+    )
+    func decodeInvalid(text: String) {
+        #expect(decodeBase16(text) == nil)
+    }
+
+    @Test("Long strings decode completely")
+    func decodeLong() {
+        let data = Data((0 ..< 4096).map { UInt8(truncatingIfNeeded: $0 &* 31) })
+
+        #expect(decodeBase16(encodeBase16(data)) == data)
+    }
+
+    // MARK: - Fuzz
+
+    @Test("Random data round trips with random case and whitespace", arguments: [1, 2, 3, 4])
+    func fuzzRoundTrip(seed: UInt64) throws {
+        var generator = SplitMix64(state: seed)
+        let whitespace: [Character] = [" ", "\t", "\n", "\r"]
+        for _ in 0 ..< 500 {
+            let data = randomData(count: Int.random(in: 0 ... 512, using: &generator), using: &generator)
+            let encoded = try #require(encodeBase16(data))
+            var text = ""
+            for character in encoded {
+                while Int.random(in: 0 ..< 8, using: &generator) == 0 {
+                    text.append(whitespace.randomElement(using: &generator)!)
+                }
+                text.append(Bool.random(using: &generator) ? Character(character.uppercased()) : character)
+            }
+
+            #expect(encoded.count == data.count * 2)
+            #expect(decodeBase16(text) == data)
+        }
+    }
+
+    @Test("Random strings decode only when they are hex", arguments: [5, 6])
+    func fuzzInvalid(seed: UInt64) {
+        var generator = SplitMix64(state: seed)
+        let alphabet = Array("0123456789abcdefABCDEF \n" + "gxyz-+=/")
+        for _ in 0 ..< 1000 {
+            let text = String((0 ..< Int.random(in: 0 ... 64, using: &generator)).map { _ in alphabet.randomElement(using: &generator)! })
+            let digits = text.filter(\.isHexDigit)
+            let isValid = digits.count.isMultiple(of: 2) && text.allSatisfy { $0.isHexDigit || $0 == " " || $0 == "\n" }
+
+            let decoded = decodeBase16(text)
+
+            #expect((decoded != nil) == isValid)
+            if let decoded {
+                #expect(decoded.count == digits.count / 2)
+            }
+        }
+    }
+
+    // MARK: - Benchmark
+
+    @Test(
+        "Benchmark: base16 throughput",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkThroughput() throws {
+        var generator = SplitMix64(state: 42)
+        let data = randomData(count: 16 << 20, using: &generator)
+        let megabytes = Double(data.count) / 1_048_576
+        var encoded = ""
+        let encode = Benchmark.measure("encode 16 MB") {
+            encoded = encodeBase16(data)
+        }
+        // Legacy documents break the hex into lines
+        let lines = stride(from: 0, to: encoded.count, by: 80).map { offset -> Substring in
+            let start = encoded.index(encoded.startIndex, offsetBy: offset)
+            return encoded[start ..< (encoded.index(start, offsetBy: 80, limitedBy: encoded.endIndex) ?? encoded.endIndex)]
+        }
+        let wrapped = lines.joined(separator: "\n")
+        var decoded: Data?
+        let decode = Benchmark.measure("decode 16 MB") {
+            decoded = decodeBase16(wrapped)
+        }
+
+        #expect(decoded == data)
+        print("[benchmark] encode: \(String(format: "%.0f", megabytes / Benchmark.seconds(encode))) MB/s")
+        print("[benchmark] decode: \(String(format: "%.0f", megabytes / Benchmark.seconds(decode))) MB/s")
+    }
+}
@@ -0,0 +1,124 @@
+//
+// LegacyXRoseConverter.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import CodableSQLiteNonThread
+import Foundation
+
+/// Converts a legacy XML XRose archive into an SQLite `.XRose` document.
+///
+/// Each data set becomes a user table with one `value` column plus its `_datasets` record, and is
+/// written to the document file as soon as the reader hands it over, so memory is bounded by the
+/// largest single data set rather than by the archive.
+struct LegacyXRoseConverter {
+
+    static let valueColumnName = "value"
+
+    var writer = DataFrameTableWriter()
+
+    /// Writes the document for the archive at `source` to `destination`
+    /// - returns: The reader's summary; sections it skipped are not converted
+    @discardableResult
+    func convert(legacyArchiveAt source: URL, to destination: URL) throws -> LegacyXRoseReader.Summary {
+        // Written beside the destination and moved into place, so a failed conversion leaves no document
+        let partial = destination.deletingLastPathComponent()
+            .appendingPathComponent(".\(destination.lastPathComponent).\(UUID().uuidString).converting")
+        defer {
+            try? FileManager.default.removeItem(at: partial)
+        }
+        let summary: LegacyXRoseReader.Summary
+        do {
+            // The store closes the file when it is released at the end of this scope
+            let store = try InMemoryStore(interface: SQLiteInterface(), creatingFileAt: partial.path)
+            summary = try convert(LegacyXRoseReader(url: source), into: store)
+        }
+        if FileManager.default.fileExists(atPath: destination.path) {
+            _ = try FileManager.default.replaceItemAt(destination, withItemAt: partial)
+        } else {
+            try FileManager.default.moveItem(at: partial, to: destination)
+        }
+        return summary
+    }
+
+    /// Reads the archive into `store`, adding its geometry and a table and record per data set
+    @discardableResult
+    func convert(_ reader: LegacyXRoseReader, into store: InMemoryStore) throws -> LegacyXRoseReader.Summary {
+        let geometryController = XRGeometryController()
+        var tableNames = try Set(store.tableNames(sqliteStore: store.sqlitePointer()))
+        let summary = try reader.read(into: geometryController) { dataSet in
+            let tableName = Self.tableName(for: dataSet.name() ?? "", avoiding: tableNames)
+            tableNames.insert(tableName)
+            try write(dataSet, toTable: tableName, in: store)
+        }
+        try store.store(geometryController: geometryController)
+        return summary
+    }
+
+    // MARK: - Private
+
+    private func write(_ dataSet: XRDataSet, toTable tableName: String, in store: InMemoryStore) throws {
+        try dataSet.withValues { values in
+            var rows = values.makeIterator()
+            try store.createUserTable(
+                createSQL: writer.createSQL(columns: [(name: Self.valueColumnName, affinity: "NUMERIC")], named: tableName),
+                insertSQL: writer.insertSQL(columnNames: [Self.valueColumnName], named: tableName)
+            ) {
+                guard let value = rows.next() else {
+                    return nil
+                }
+                return [value]
+            }
+        }
+        var record = DataSet(
+            NAME: dataSet.name() ?? "",
+            TABLENAME: tableName,
+            COLUMNNAME: Self.valueColumnName,
+            PREDICATE: nil,
+            COMMENTS: nil
+        )
+        record.set(comments: dataSet.comments())
+        try store.insert(dataSet: record)
+    }
+
+    /// The data set's name as a bare SQL identifier, numbered when it would clash with an existing table.
+    /// Data set queries name the table unquoted, so anything but letters, digits and `_` becomes `_`.
+    static func tableName(for name: String, avoiding existing: Set<String>) -> String {
+        var base = String(name.unicodeScalars.map { scalar -> Character in
+            scalar.isASCII && (CharacterSet.alphanumerics.contains(scalar) || scalar == "_") ? Character(scalar) : "_"
+        })
+        if base.first.map({ $0 == "_" || $0.isNumber }) ?? true {
+            base = "DataSet_" + base
+        }
+        // SQLite compares table names case-insensitively
+        let taken = Set(existing.map { $0.lowercased() })
+        var candidate = base
+        var number = 2
+        while taken.contains(candidate.lowercased()) {
+            candidate = "\(base)_\(number)"
+            number += 1
+        }
+        return candidate
+    }
+}
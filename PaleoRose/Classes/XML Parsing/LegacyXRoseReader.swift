@@ -0,0 +1,391 @@
+//
+// LegacyXRoseReader.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import Foundation
+
+enum LegacyXRoseReaderError: Error, Equatable {
+    case unreadableFile(path: String)
+    case invalidValues(dataSet: String)
+    case malformedXML(line: Int, message: String)
+}
+
+/// Reads a legacy XML XRose archive as a stream of parser events.
+///
+/// The archive is a `<XRose version="…">` root holding a `<geometry>` section, `<dataset>` sections
+/// (optionally grouped under `<datasets>`), and sections such as `<layers>` that are skipped and
+/// reported. A data set has `<name>`, `<comments>` and `<values>` children; `<values>` is the
+/// base16 encoding of the data set's Float32 buffer.
+///
+/// The layout is that of the legacy writer's pieces still in this tree: the keys of
+/// `-[XRDataSet dataSetDictionary]`, `encodeBase16` in LITMXMLBinaryEncoding.m, and the 1.0 geometry tree
+/// in XRGeometryController.swift. The writer of the `<dataset>` elements itself is not, and no archive it
+/// wrote is available, so the tests build archives from those pieces. `encodeBase16` wrote the buffer in
+/// the writing Mac's byte order, so archives from PowerPC Macs hold big-endian floats; each data set is
+/// read in whichever order makes more of its values plausible angles.
+///
+/// Geometry settings are applied to the geometry controller with its configure method, using the
+/// `EQUAL`/`ISPERCENT` names of the 1.0 tree and the keys of `-geometrySettings`. Values are decoded
+/// into the data set's buffer as the characters arrive, so neither the element tree nor the hex text
+/// is held; each data set is handed over as soon as it closes.
+struct LegacyXRoseReader {
+
+    struct Summary: Equatable {
+        var version = "1.0"
+        var dataSetCount = 0
+        var valueCount = 0
+        var skippedSections: [String] = []
+    }
+
+    /// Decodes base16 text that arrives in arbitrary pieces, skipping ASCII whitespace
+    struct Base16Stream {
+        private(set) var bytes = Data()
+        private var pending: CChar?
+        private var digits: [CChar] = []
+
+        /// True when no digit is waiting for its pair
+        var isComplete: Bool {
+            pending == nil
+        }
+
+        /// - returns: False if the text holds anything other than hex digits and whitespace
+        mutating func append(_ text: String) -> Bool {
+            digits.removeAll(keepingCapacity: true)
+            if let pending {
+                digits.append(pending)
+            }
+            for byte in text.utf8 where !Self.isWhitespace(byte) {
+                digits.append(CChar(bitPattern: byte))
+            }
+            pending = digits.count % 2 == 1 ? digits.removeLast() : nil
+            guard !digits.isEmpty else {
+                return true
+            }
+            let start = bytes.count
+            let length = digits.count / 2
+            bytes.append(contentsOf: repeatElement(0, count: length))
+            let written = bytes.withUnsafeMutableBytes { output in
+                digits.withUnsafeBufferPointer { text in
+                    LITMBase16DecodeBytes(
+                        text.baseAddress,
+                        text.count,
+                        output.baseAddress?.advanced(by: start).assumingMemoryBound(to: UInt8.self)
+                    )
+                }
+            }
+            return written == length
+        }
+
+        /// Takes the decoded bytes, leaving the stream empty
+        mutating func take() -> Data {
+            defer {
+                bytes = Data()
+                pending = nil
+            }
+            return bytes
+        }
+
+        private static func isWhitespace(_ byte: UInt8) -> Bool {
+            byte == 0x20 || (0x09 ... 0x0D).contains(byte)
+        }
+    }
+
+    private let stream: InputStream
+
+    init(url: URL) throws {
+        guard let stream = InputStream(url: url) else {
+            throw LegacyXRoseReaderError.unreadableFile(path: url.path)
+        }
+        self.stream = stream
+    }
+
+    init(data: Data) {
+        stream = InputStream(data: data)
+    }
+
+    /// Parses the archive, configuring `geometryController` and passing each data set to `dataSet`.
+    ///
+    /// The reader keeps no reference to a data set once `dataSet` returns.
+    /// - throws: `LegacyXRoseReaderError`, or the first error thrown by `dataSet`, which stops the parse
+    @discardableResult
+    func read(
+        into geometryController: XRGeometryController,
+        dataSet: @escaping (XRDataSet) throws -> Void
+    ) throws -> Summary {
+        let parser = XMLParser(stream: stream)
+        parser.shouldResolveExternalEntities = false
+        let delegate = ParserDelegate(geometryController: geometryController, dataSetHandler: dataSet)
+        parser.delegate = delegate
+        if !parser.parse() {
+            if let error = delegate.error {
+                throw error
+            }
+            throw LegacyXRoseReaderError.malformedXML(
+                line: parser.lineNumber,
+                message: parser.parserError?.localizedDescription ?? ""
+            )
+        }
+        return delegate.summary
+    }
+
+    // MARK: - Geometry
+
+    /// Applies legacy geometry settings over the controller's current values
+    static func configure(_ geometryController: XRGeometryController, with settings: [String: String]) {
+        func flag(_ keys: String...) -> Bool? {
+            keys.lazy.compactMap { settings[$0] }.first.map { $0 == "YES" }
+        }
+        func number(_ key: String) -> Float? {
+            settings[key].flatMap(Float.init)
+        }
+        func integer(_ key: String) -> Int32? {
+            settings[key].flatMap(Int32.init)
+        }
+        geometryController.configureIsEqualArea(
+            flag("EQUAL", "_isEqualArea") ?? geometryController.isEqualArea(),
+            isPercent: flag("ISPERCENT", "_isPercent") ?? geometryController.isPercent(),
+            maxCount: integer("_geometryMaxCount") ?? geometryController.geometryMaxCount(),
+            maxPercent: number("_geometryMaxPercent") ?? geometryController.geometryMaxPercent(),
+            hollowCore: number("_hollowCoreSize") ?? geometryController.hollowCoreSize(),
+            sectorSize: number("_sectorSize") ?? geometryController.sectorSize(),
+            startingAngle: number("_startingAngle") ?? geometryController.startingAngle(),
+            sectorCount: integer("_sectorCount") ?? geometryController.sectorCount(),
+            relativeSize: geometryController.relativeSizeOfCircleRect()
+        )
+    }
+
+    // MARK: - Byte Order
+
+    /// Float32 bytes in host order: swapped when more of the values are plausible angles that way
+    static func hostOrdered(_ bytes: Data) -> Data {
+        // Zero, or between a millionth of a degree and two turns; a float read in the wrong order is
+        // almost always subnormal, huge or not finite
+        func isPlausible(_ bits: UInt32) -> Bool {
+            let value = abs(Float(bitPattern: bits))
+            return value == 0 || (1e-6 ... 720).contains(value)
+        }
+        let count = bytes.count / MemoryLayout<UInt32>.size
+        let (native, swapped) = bytes.withUnsafeBytes { raw in
+            (0 ..< count).reduce(into: (0, 0)) { plausible, index in
+                let bits = raw.loadUnaligned(fromByteOffset: index * MemoryLayout<UInt32>.size, as: UInt32.self)
+                plausible.0 += isPlausible(bits) ? 1 : 0
+                plausible.1 += isPlausible(bits.byteSwapped) ? 1 : 0
+            }
+        }
+        guard swapped > native else {
+            return bytes
+        }
+        var ordered = bytes
+        ordered.withUnsafeMutableBytes { raw in
+            for offset in stride(from: 0, to: count * MemoryLayout<UInt32>.size, by: MemoryLayout<UInt32>.size) {
+                let bits = raw.loadUnaligned(fromByteOffset: offset, as: UInt32.self)
+                raw.storeBytes(of: bits.byteSwapped, toByteOffset: offset, as: UInt32.self)
+            }
+        }
+        return ordered
+    }
+
+    // MARK: - Parser Delegate
+
+    private final class ParserDelegate: NSObject, XMLParserDelegate {
+        private enum Section {
+            case none
+            case geometry
+            case dataSet
+            case skipped
+        }
+
+        private let geometryController: XRGeometryController
+        private let dataSetHandler: (XRDataSet) throws -> Void
+        private(set) var summary = Summary()
+        private(set) var error: Error?
+
+        private var depth = 0
+        private var section = Section.none
+        private var sectionDepth = 0
+        private var text = ""
+        private var inValues = false
+        private var geometrySettings: [String: String] = [:]
+        private var dataSetName = ""
+        private var dataSetComments = ""
+        private var values = Base16Stream()
+
+        init(geometryController: XRGeometryController, dataSetHandler: @escaping (XRDataSet) throws -> Void) {
+            self.geometryController = geometryController
+            self.dataSetHandler = dataSetHandler
+        }
+
+        func parser(
+            _: XMLParser,
+            didStartElement elementName: String,
+            namespaceURI _: String?,
+            qualifiedName _: String?,
+            attributes attributeDict: [String: String] = [:]
+        ) {
+            depth += 1
+            text = ""
+            let name = elementName.lowercased()
+            if depth == 1 {
+                summary.version = attributeDict["version"] ?? summary.version
+                return
+            }
+            switch section {
+            case .none:
+                startSection(name, elementName: elementName)
+
+            case .dataSet:
+                inValues = name == "values" && depth == sectionDepth + 1
+
+            case .geometry, .skipped:
+                break
+            }
+        }
+
+        func parser(_ parser: XMLParser, foundCharacters string: String) {
+            switch section {
+            case .dataSet where inValues:
+                if !values.append(string) {
+                    fail(parser, LegacyXRoseReaderError.invalidValues(dataSet: dataSetName))
+                }
+
+            case .geometry, .dataSet:
+                text += string
+
+            case .none, .skipped:
+                break
+            }
+        }
+
+        func parser(
+            _ parser: XMLParser,
+            didEndElement elementName: String,
+            namespaceURI _: String?,
+            qualifiedName _: String?
+        ) {
+            defer {
+                depth -= 1
+            }
+            if depth == sectionDepth {
+                endSection(parser)
+                return
+            }
+            let content = text.trimmingCharacters(in: .whitespacesAndNewlines)
+            switch section {
+            case .geometry where depth == sectionDepth + 1:
+                geometrySettings[elementName] = content
+
+            case .dataSet where depth == sectionDepth + 1:
+                switch elementName.lowercased() {
+                case "name":
+                    dataSetName = content
+
+                case "comments":
+                    dataSetComments = content
+
+                case "values":
+                    inValues = false
+
+                default:
+                    break
+                }
+
+            default:
+                break
+            }
+        }
+
+        // MARK: - Private
+
+        private func startSection(_ name: String, elementName: String) {
+            switch name {
+            case "datasets":
+                // A grouping element; its children start their own sections
+                return
+
+            case "geometry":
+                section = .geometry
+                geometrySettings = [:]
+
+            case "dataset":
+                section = .dataSet
+                dataSetName = ""
+                dataSetComments = ""
+                values = Base16Stream()
+
+            default:
+                section = .skipped
+                summary.skippedSections.append(elementName)
+            }
+            sectionDepth = depth
+        }
+
+        private func endSection(_ parser: XMLParser) {
+            defer {
+                section = .none
+                sectionDepth = 0
+            }
+            switch section {
+            case .geometry:
+                LegacyXRoseReader.configure(geometryController, with: geometrySettings)
+
+            case .dataSet:
+                let isComplete = values.isComplete
+                let bytes = LegacyXRoseReader.hostOrdered(values.take())
+                guard isComplete, bytes.count % MemoryLayout<Float>.size == 0 else {
+                    fail(parser, LegacyXRoseReaderError.invalidValues(dataSet: dataSetName))
+                    return
+                }
+                let dataSet = XRDataSet(
+                    id: 0,
+                    name: dataSetName,
+                    tableName: "",
+                    column: "",
+                    predicate: "",
+                    comments: NSAttributedString(string: dataSetComments),
+                    valuesNoCopy: bytes
+                )
+                do {
+                    try dataSetHandler(dataSet)
+                } catch {
+                    fail(parser, error)
+                    return
+                }
+                summary.dataSetCount += 1
+                summary.valueCount += bytes.count / MemoryLayout<Float>.size
+
+            case .none, .skipped:
+                break
+            }
+        }
+
+        private func fail(_ parser: XMLParser, _ error: Error) {
+            guard self.error == nil else {
+                return
+            }
+            self.error = error
+            parser.abortParsing()
+        }
+    }
+}
@@ -0,0 +1,260 @@
+//
+// LegacyXRoseReaderTests.swift
+// PaleoRose
+//
+// MIT License
+//
+// Copyright (c) 2026 to present Thomas L. Moore.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+import Foundation
+@testable import PaleoRose
+import Testing
+
+struct LegacyXRoseReaderTests {
+
+    // MARK: - Test Setup
+
+    private func hex(_ values: [Float]) -> String {
+        encodeBase16(values.withUnsafeBufferPointer { Data(buffer: $0) })
+    }
+
+    private func archive(dataSets: [(name: String, values: [Float])], extra: String = "") -> Data {
+        let sets = dataSets.map { set in
+            """
+            <dataset><name>\(set.name)</name><comments>From \(set.name)</comments>
+            <values>\(hex(set.values))</values></dataset>
+            """
+        }
+        return Data("""
+        <?xml version="1.0" encoding="UTF-8"?>
+        <XRose version="1.0">
+        <geometry><EQUAL>YES</EQUAL><ISPERCENT>YES</ISPERCENT><_sectorCount>24</_sectorCount>\
+        <_sectorSize>15.000000</_sectorSize></geometry>
+        <datasets>\(sets.joined(separator: "\n"))</datasets>
+        \(extra)
+        </XRose>
+        """.utf8)
+    }
+
+    private func read(_ data: Data) throws -> (summary: LegacyXRoseReader.Summary, dataSets: [XRDataSet]) {
+        var dataSets: [XRDataSet] = []
+        let summary = try LegacyXRoseReader(data: data).read(into: XRGeometryController()) { dataSets.append($0) }
+        return (summary, dataSets)
+    }
+
+    // MARK: - Base16 Stream
+
+    @Test("Hex split at any point decodes to the same bytes")
+    func base16StreamSplits() {
+        let text = "00 0a\nff7F\t80"
+        for split in 0 ... text.count {
+            var stream = LegacyXRoseReader.Base16Stream()
+            #expect(stream.append(String(text.prefix(split))))
+            #expect(stream.append(String(text.dropFirst(split))))
+            #expect(stream.isComplete)
+            #expect(stream.take() == Data([0x00, 0x0A, 0xFF, 0x7F, 0x80]))
+        }
+    }
+
+    @Test("A lone trailing digit leaves the stream incomplete")
+    func base16StreamOddDigit() {
+        var stream = LegacyXRoseReader.Base16Stream()
+
+        #expect(stream.append("abc"))
+        #expect(!stream.isComplete)
+        #expect(stream.bytes == Data([0xAB]))
+    }
+
+    @Test("Characters other than hex digits and whitespace are rejected")
+    func base16StreamInvalid() {
+        var stream = LegacyXRoseReader.Base16Stream()
+
+        #expect(!stream.append("0g"))
+    }
+
+    // MARK: - Reading
+
+    @Test("Data sets are decoded with their names and comments")
+    func readsDataSets() throws {
+        let result = try read(archive(dataSets: [("North", [0, 45.5, 359]), ("South", [180])]))
+
+        #expect(result.dataSets.count == 2)
+        let north = try #require(result.dataSets.first)
+        #expect(north.name() == "North")
+        #expect(north.comments()?.string == "From North")
+        #expect(north.withValues { Array($0) } == [0, 45.5, 359])
+        #expect(result.dataSets.last?.withValues { Array($0) } == [180])
+        #expect(result.summary.version == "1.0")
+        #expect(result.summary.dataSetCount == 2)
+        #expect(result.summary.valueCount == 4)
+    }
+
+    @Test("Values written from the legacy data set dictionary read back, in either byte order")
+    func legacyDictionaryValues() throws {
+        let values: [Float] = [0, 12.5, 90, 181.25, 359.99]
+        let source = try XRDataSet.stub(values: values, name: "Legacy")
+        let littleEndian = try #require(source.dataSetDictionary()?["values"] as? Data)
+        let bigEndian = Data(values.flatMap { withUnsafeBytes(of: $0.bitPattern.bigEndian, Array.init) })
+
+        for written in [littleEndian, bigEndian] {
+            let xml = """
+            <XRose version="1.0"><dataset><name>Legacy</name>\
+            <values>\(encodeBase16(written))</values></dataset></XRose>
+            """
+            let dataSets = try read(Data(xml.utf8)).dataSets
+            #expect(dataSets.map { $0.withValues { Array($0) } } == [values])
+        }
+    }
+
+    @Test("Geometry settings are applied with the controller's configure method")
+    func configuresGeometry() throws {
+        let controller = XRGeometryController()
+        controller.setEqualArea(false)
+        controller.setPercent(false)
+
+        try LegacyXRoseReader(data: archive(dataSets: [])).read(into: controller) { _ in }
+
+        #expect(controller.isEqualArea())
+        #expect(controller.isPercent())
+        #expect(controller.sectorCount() == 24)
+        #expect(controller.sectorSize() == 15)
+    }
+
+    @Test("Sections without a converter are skipped and reported")
+    func skipsLayers() throws {
+        let extra = "<layers><layer><dataset><values>zz</values></dataset></layer></layers>"
+
+        let result = try read(archive(dataSets: [("Only", [1])], extra: extra))
+
+        #expect(result.dataSets.count == 1)
+        #expect(result.summary.skippedSections == ["layers"])
+    }
+
+    @Test("Values that are not whole floats fail the read")
+    func rejectsPartialFloat() {
+        let data = Data("<XRose><dataset><name>Bad</name><values>0000803f00</values></dataset></XRose>".utf8)
+
+        #expect(throws: LegacyXRoseReaderError.invalidValues(dataSet: "Bad")) {
+            try read(data)
+        }
+    }
+
+    @Test("An error from the data set handler stops the read")
+    func handlerErrorStops() {
+        struct Stop: Error {}
+        var seen = 0
+
+        #expect(throws: Stop.self) {
+            try LegacyXRoseReader(data: archive(dataSets: [("A", [1]), ("B", [2])]))
+                .read(into: XRGeometryController()) { _ in
+                    seen += 1
+                    throw Stop()
+                }
+        }
+        #expect(seen == 1)
+    }
+
+    @Test("Malformed XML reports the line")
+    func malformed() {
+        #expect(throws: LegacyXRoseReaderError.self) {
+            try read(Data("<XRose>\n<dataset>".utf8))
+        }
+    }
+
+    // MARK: - Converting
+
+    @Test("Converted documents read back through the store")
+    func convertsToStore() throws {
+        let store = try InMemoryStore(interface: SQLiteInterface())
+        let reader = LegacyXRoseReader(data: archive(dataSets: [("North", [10, 20]), ("North", [30]), ("_x", [40])]))
+
+        let summary = try LegacyXRoseConverter().convert(reader, into: store)
+        let snapshot = try store.readSnapshot()
+
+        #expect(summary.dataSetCount == 3)
+        #expect(snapshot.dataSets.map { $0.name() } == ["North", "North", "_x"])
+        #expect(snapshot.dataSets.map { $0.tableName() } == ["North", "North_2", "DataSet__x"])
+        #expect(snapshot.dataSets.map { $0.withValues { Array($0) } } == [[10, 20], [30], [40]])
+        #expect(snapshot.dataSets.first?.comments()?.string == "From North")
+        #expect(snapshot.geometry?.isEqualArea == true)
+        #expect(snapshot.geometry?.SECTORCOUNT == 24)
+    }
+
+    @Test("Archives are converted straight into the document file, replacing one already there")
+    func convertsToFile() throws {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        defer {
+            try? FileManager.default.removeItem(at: directory)
+        }
+        let source = directory.appendingPathComponent("legacy.xml")
+        let destination = directory.appendingPathComponent("converted.XRose")
+        try Data("stale".utf8).write(to: destination)
+        try archive(dataSets: [("North", [10, 20]), ("South", [30])]).write(to: source)
+
+        let summary = try LegacyXRoseConverter().convert(legacyArchiveAt: source, to: destination)
+        let store = try InMemoryStore(interface: SQLiteInterface())
+        store.defersDataSetValues = false
+        try store.load(from: destination.path)
+        let snapshot = try store.readSnapshot()
+
+        #expect(summary.dataSetCount == 2)
+        #expect(snapshot.dataSets.map { $0.withValues { Array($0) } } == [[10, 20], [30]])
+        #expect(snapshot.geometry?.SECTORCOUNT == 24)
+        let remaining = try FileManager.default.contentsOfDirectory(atPath: directory.path)
+        #expect(remaining.sorted() == ["converted.XRose", "legacy.xml"])
+    }
+
+    @Test("Table names are bare identifiers that do not clash")
+    func tableNames() {
+        #expect(LegacyXRoseConverter.tableName(for: "Set 1", avoiding: []) == "Set_1")
+        #expect(LegacyXRoseConverter.tableName(for: "2004", avoiding: []) == "DataSet_2004")
+        #expect(LegacyXRoseConverter.tableName(for: "", avoiding: []) == "DataSet_")
+        #expect(LegacyXRoseConverter.tableName(for: "Set", avoiding: ["Set", "Set_2"]) == "Set_3")
+        #expect(LegacyXRoseConverter.tableName(for: "north", avoiding: ["North"]) == "north_2")
+    }
+
+    @Test(
+        "Benchmark: converting a large legacy archive",
+        .tags(.benchmark),
+        .enabled(if: Benchmark.isEnabled)
+    )
+    func benchmarkConvert() throws {
+        let values = (0 ..< 1 << 20).map { Float($0 % 36_000) / 100 }
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        defer {
+            try? FileManager.default.removeItem(at: directory)
+        }
+        let source = directory.appendingPathComponent("legacy.xml")
+        let destination = directory.appendingPathComponent("converted.XRose")
+        try archive(dataSets: (0 ..< 8).map { ("Set \($0)", values) }).write(to: source)
+
+        var summary = LegacyXRoseReader.Summary()
+        let duration = try Benchmark.measure("convert 8 x 1M values", iterations: 1) {
+            try? FileManager.default.removeItem(at: destination)
+            summary = try LegacyXRoseConverter().convert(legacyArchiveAt: source, to: destination)
+        }
+
+        #expect(summary.valueCount == 8 << 20)
+        print("[benchmark] convert: \(String(format: "%.0f", Double(summary.valueCount) / Benchmark.seconds(duration))) values/s")
+    }
+}
@@ -3,6 +3,11 @@
 //
 
 #import "XRDataSet.h"
+#import "XRSectorHistogram.h"
+#import "XRFineAngleHistogram.h"
+#import "XRAngleHundredths.h"
+#import "XRCircularResultant.h"
+#import "XRCircularSummary.h"
 #import "XRGeometryController.h"
 #import "XRLayer.h"
 #import "XRLayerText.h"
@@ -15,3 +20,4 @@
 #import "XRVStatCreatePanelController.h"
 #import "XRTableImporterDelimiterController.h"
 #import "XRTableImporterXRose.h"
+#import "LITMXMLBinaryEncoding.h"
@@ -28,4 +28,5 @@ import Testing
 
 extension Tag {
     @Tag static var integration: Self
+    @Tag static var benchmark: Self
 }